@@ -1,88 +1,489 @@
 #include "Band.h"
 #include "RuntimeVars.h"
+#include <CRC.h>
+
+// SSB patch: a tömörített változatot (patch_lz.h, a sketch mellett) a sim/PatchCompress.cpp állítja elő, lásd README
+// Nélküle a nyers patch kerül a flash-be, ezt a fordításkor jelezzük
+#if __has_include("patch_lz.h")
+#include "LzssDecoder.h"
+#include "patch_lz.h"
+#define SSB_PATCH_COMPRESSED
+#define SSB_PATCH_SIZE SSB_PATCH_LZ_RAW_SIZE
+#define SSB_PATCH_CRC16 SSB_PATCH_LZ_RAW_CRC16
+static LzssDecoder ssbPatchDecoder; // Statikus, mert a core1 stack-je kicsi
+#else
+#warning "patch_lz.h nincs a sketch mellett, a tomoritetlen SSB patch kerul a flash-be (cmake --build <build> --target sketch_patch_lz)"
 #include <patch_full.h> // SSB patch for whole SSBRX full download
+#define SSB_PATCH_SIZE sizeof(ssb_patch_content)
+#define SSB_PATCH_CRC16 calcCRC16(ssb_patch_content, SSB_PATCH_SIZE)
+#endif
+
+// Band leírók (constexpr: a flash-ben maradnak, nem másolódnak a RAM-ba)
+static constexpr BandDesc_t BAND_TABLE[] = {
+    {"FM", FM_BAND_TYPE, FM, 6400, 10800, 9390, 10},          //  FM          0   //93.9MHz Petőfi
+    {"LW", LW_BAND_TYPE, AM, 100, 514, 198, 9},               //  LW          1
+    {"MW", MW_BAND_TYPE, AM, 514, 1800, 540, 9},              //  MW          2   // 540kHz Kossuth
+    {"800M", LW_BAND_TYPE, AM, 280, 470, 284, 1},             // Ham  800M    3
+    {"630M", SW_BAND_TYPE, LSB, 470, 480, 475, 1},            // Ham  630M    4
+    {"160M", SW_BAND_TYPE, LSB, 1800, 2000, 1850, 1},         // Ham  160M    5
+    {"120M", SW_BAND_TYPE, AM, 2000, 3200, 2400, 5},          //      120M    6
+    {"90M", SW_BAND_TYPE, AM, 3200, 3500, 3300, 5},           //       90M    7
+    {"80M", SW_BAND_TYPE, LSB, 3500, 3900, 3630, 1},          // Ham   80M    8
+    {"75M", SW_BAND_TYPE, AM, 3900, 5300, 3950, 5},           //       75M    9
+    {"60M", SW_BAND_TYPE, USB, 5300, 5900, 5375, 1},          // Ham   60M   10
+    {"49M", SW_BAND_TYPE, AM, 5900, 7000, 6000, 5},           //       49M   11
+    {"40M", SW_BAND_TYPE, LSB, 7000, 7500, 7074, 1},          // Ham   40M   12
+    {"41M", SW_BAND_TYPE, AM, 7200, 9000, 7210, 5},           //       41M   13
+    {"31M", SW_BAND_TYPE, AM, 9000, 10000, 9600, 5},          //       31M   14
+    {"30M", SW_BAND_TYPE, USB, 10000, 10200, 10099, 1},       // Ham   30M   15
+    {"25M", SW_BAND_TYPE, AM, 10200, 13500, 11700, 5},        //       25M   16
+    {"22M", SW_BAND_TYPE, AM, 13500, 14000, 13700, 5},        //       22M   17
+    {"20M", SW_BAND_TYPE, USB, 14000, 14500, 14074, 1},       // Ham   20M   18
+    {"19M", SW_BAND_TYPE, AM, 14500, 17500, 15700, 5},        //       19M   19
+    {"17M", SW_BAND_TYPE, AM, 17500, 18000, 17600, 5},        //       17M   20
+    {"16M", SW_BAND_TYPE, USB, 18000, 18500, 18100, 1},       // Ham   16M   21
+    {"15M", SW_BAND_TYPE, AM, 18500, 21000, 18950, 5},        //       15M   22
+    {"14M", SW_BAND_TYPE, USB, 21000, 21500, 21074, 1},       // Ham   14M   23
+    {"13M", SW_BAND_TYPE, AM, 21500, 24000, 21500, 5},        //       13M   24
+    {"12M", SW_BAND_TYPE, USB, 24000, 25500, 24940, 1},       // Ham   12M   25
+    {"11M", SW_BAND_TYPE, AM, 25500, 26100, 25800, 5},        //       11M   26
+    {"CB", SW_BAND_TYPE, AM, 26100, 28000, 27200, 1},         // CB band     27
+    {"10M", SW_BAND_TYPE, USB, 28000, 30000, 28500, 1},       // Ham   10M   28
+    {"SW", SW_BAND_TYPE, AM, 100, 30000, 15500, 5}            // Whole SW    29
+};
+static_assert(sizeof(BAND_TABLE) / sizeof(BandDesc_t) == BAND_TABLE_SIZE, "Band tábla: a BAND_TABLE_SIZE nem egyezik az elemek számával");
 
-// Band tábla
-BandTable_t bandTable[] = {
-    {"FM", FM_BAND_TYPE, FM, 6400, 10800, 9390, 10, 0, 0},    //  FM          0   //93.9MHz Petőfi
-    {"LW", LW_BAND_TYPE, AM, 100, 514, 198, 9, 0, 0},         //  LW          1
-    {"MW", MW_BAND_TYPE, AM, 514, 1800, 540, 9, 0, 0},        //  MW          2   // 540kHz Kossuth
-    {"800M", LW_BAND_TYPE, AM, 280, 470, 284, 1, 0, 0},       // Ham  800M    3
-    {"630M", SW_BAND_TYPE, LSB, 470, 480, 475, 1, 0, 0},      // Ham  630M    4
-    {"160M", SW_BAND_TYPE, LSB, 1800, 2000, 1850, 1, 0, 0},   // Ham  160M    5
-    {"120M", SW_BAND_TYPE, AM, 2000, 3200, 2400, 5, 0, 0},    //      120M    6
-    {"90M", SW_BAND_TYPE, AM, 3200, 3500, 3300, 5, 0, 0},     //       90M    7
-    {"80M", SW_BAND_TYPE, LSB, 3500, 3900, 3630, 1, 0, 0},    // Ham   80M    8
-    {"75M", SW_BAND_TYPE, AM, 3900, 5300, 3950, 5, 0, 0},     //       75M    9
-    {"60M", SW_BAND_TYPE, USB, 5300, 5900, 5375, 1, 0, 0},    // Ham   60M   10
-    {"49M", SW_BAND_TYPE, AM, 5900, 7000, 6000, 5, 0, 0},     //       49M   11
-    {"40M", SW_BAND_TYPE, LSB, 7000, 7500, 7074, 1, 0, 0},    // Ham   40M   12
-    {"41M", SW_BAND_TYPE, AM, 7200, 9000, 7210, 5, 0, 0},     //       41M   13
-    {"31M", SW_BAND_TYPE, AM, 9000, 10000, 9600, 5, 0, 0},    //       31M   14
-    {"30M", SW_BAND_TYPE, USB, 10000, 10200, 10099, 1, 0, 0}, // Ham   30M   15
-    {"25M", SW_BAND_TYPE, AM, 10200, 13500, 11700, 5, 0, 0},  //       25M   16
-    {"22M", SW_BAND_TYPE, AM, 13500, 14000, 13700, 5, 0, 0},  //       22M   17
-    {"20M", SW_BAND_TYPE, USB, 14000, 14500, 14074, 1, 0, 0}, // Ham   20M   18
-    {"19M", SW_BAND_TYPE, AM, 14500, 17500, 15700, 5, 0, 0},  //       19M   19
-    {"17M", SW_BAND_TYPE, AM, 17500, 18000, 17600, 5, 0, 0},  //       17M   20
-    {"16M", SW_BAND_TYPE, USB, 18000, 18500, 18100, 1, 0, 0}, // Ham   16M   21
-    {"15M", SW_BAND_TYPE, AM, 18500, 21000, 18950, 5, 0, 0},  //       15M   22
-    {"14M", SW_BAND_TYPE, USB, 21000, 21500, 21074, 1, 0, 0}, // Ham   14M   23
-    {"13M", SW_BAND_TYPE, AM, 21500, 24000, 21500, 5, 0, 0},  //       13M   24
-    {"12M", SW_BAND_TYPE, USB, 24000, 25500, 24940, 1, 0, 0}, // Ham   12M   25
-    {"11M", SW_BAND_TYPE, AM, 25500, 26100, 25800, 5, 0, 0},  //       11M   26
-    {"CB", SW_BAND_TYPE, AM, 26100, 28000, 27200, 1, 0, 0},   // CB band     27
-    {"10M", SW_BAND_TYPE, USB, 28000, 30000, 28500, 1, 0, 0}, // Ham   10M   28
-    {"SW", SW_BAND_TYPE, AM, 100, 30000, 15500, 5, 0, 0}      // Whole SW    29
+/**
+ * Egy band leíró ellenőrzése fordításkor
+ */
+static constexpr bool isBandDescValid(const BandDesc_t &desc) {
+    return desc.minimumFreq < desc.maximumFreq and desc.defaultFreq >= desc.minimumFreq and desc.defaultFreq <= desc.maximumFreq and
+           desc.defaultStep > 0 and (desc.bandType == FM_BAND_TYPE) == (desc.prefmod == FM);
+}
+
+static constexpr bool isBandTableValid() {
+    for (uint8_t i = 0; i < BAND_TABLE_SIZE; i++) {
+        if (!isBandDescValid(BAND_TABLE[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static_assert(isBandTableValid(), "Band tábla: hibás határ, alapértelmezett frekvencia, lépésköz vagy moduláció");
+static_assert(BAND_TABLE[0].bandType == FM_BAND_TYPE, "Band tábla: a 0. elem az FM band (az FM seek határai innen jönnek)");
+static_assert(sizeof(BandState_t) == 8, "BandState_t: 8 bájtos rekord");
+
+/**
+ * A band határai kHz-ben (az FM band a táblában 10kHz egységben van)
+ */
+static constexpr uint32_t bandMinKHz(const BandDesc_t &desc) {
+    return desc.bandType == FM_BAND_TYPE ? desc.minimumFreq * 10UL : desc.minimumFreq;
+}
+
+static constexpr uint32_t bandMaxKHz(const BandDesc_t &desc) {
+    return desc.bandType == FM_BAND_TYPE ? desc.maximumFreq * 10UL : desc.maximumFreq;
+}
+
+// Frekvencia -> band index: a band határok a kHz tengelyt szakaszokra bontják, mindegyik szakaszhoz a legszűkebb lefedő band tartozik
+#define BAND_INDEX_MAX_SEGMENTS (BAND_TABLE_SIZE * 2) // Band-enként legfeljebb két új határ
+#define BAND_INDEX_NONE 0xFF                          // A szakaszt egyetlen band sem fedi le
+
+struct BandSegment_t {
+    uint32_t startKHz; // A szakasz eleje (a következő szakasz elejéig tart)
+    uint8_t bandIdx;
+};
+
+struct BandIndex_t {
+    BandSegment_t segments[BAND_INDEX_MAX_SEGMENTS];
+    uint8_t count;
 };
 
 /**
- * A Band egy rekordjának elkérése az index alapján
+ * A szakasz tábla felépítése fordításkor
+ */
+static constexpr BandIndex_t buildBandIndex() {
+
+    // Határok: minden band eleje és a vége utáni első kHz, rendezve, ismétlődés nélkül
+    uint32_t bounds[BAND_INDEX_MAX_SEGMENTS] = {};
+    uint8_t boundCount = 0;
+    for (uint8_t i = 0; i < BAND_TABLE_SIZE; i++) {
+        uint32_t candidates[2] = {bandMinKHz(BAND_TABLE[i]), bandMaxKHz(BAND_TABLE[i]) + 1};
+        for (uint32_t bound : candidates) {
+            uint8_t pos = 0;
+            while (pos < boundCount and bounds[pos] < bound) {
+                pos++;
+            }
+            if (pos < boundCount and bounds[pos] == bound) {
+                continue;
+            }
+            for (uint8_t j = boundCount; j > pos; j--) {
+                bounds[j] = bounds[j - 1];
+            }
+            bounds[pos] = bound;
+            boundCount++;
+        }
+    }
+
+    // Szakaszonként a legszűkebb lefedő band (egyenlőnél a kisebb index), az azonos band-ű szomszédokat összevonjuk
+    BandIndex_t index = {};
+    for (uint8_t i = 0; i < boundCount; i++) {
+        uint8_t best = BAND_INDEX_NONE;
+        uint32_t bestSpan = UINT32_MAX;
+        for (uint8_t b = 0; b < BAND_TABLE_SIZE; b++) {
+            uint32_t span = bandMaxKHz(BAND_TABLE[b]) - bandMinKHz(BAND_TABLE[b]);
+            if (bandMinKHz(BAND_TABLE[b]) <= bounds[i] and bounds[i] <= bandMaxKHz(BAND_TABLE[b]) and span < bestSpan) {
+                best = b;
+                bestSpan = span;
+            }
+        }
+        if (index.count > 0 and index.segments[index.count - 1].bandIdx == best) {
+            continue;
+        }
+        index.segments[index.count++] = {bounds[i], best};
+    }
+    return index;
+}
+
+static constexpr BandIndex_t BAND_INDEX = buildBandIndex();
+
+/**
+ * A kHz értéket tartalmazó szakasz band-je, bináris kereséssel
  */
+static constexpr int8_t lookupBandIndex(uint32_t kHz) {
+    uint8_t lo = 0, hi = BAND_INDEX.count;
+    while (lo < hi) {
+        uint8_t mid = (lo + hi) / 2;
+        if (BAND_INDEX.segments[mid].startKHz <= kHz) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo == 0 or BAND_INDEX.segments[lo - 1].bandIdx == BAND_INDEX_NONE ? -1 : BAND_INDEX.segments[lo - 1].bandIdx;
+}
+
+static_assert(lookupBandIndex(bandMinKHz(BAND_TABLE[0])) == 0 and lookupBandIndex(bandMaxKHz(BAND_TABLE[0]) + 1) == -1,
+              "Band index: az FM band határai");
 
-BandTable_t &Band::getBandByIdx(uint8_t bandIdx) {
-    return bandTable[bandIdx];
+/**
+ * A band állapotok alapértelmezése a leírók alapján
+ */
+void Band::resetBandStates() {
+    for (uint8_t i = 0; i < BAND_TABLE_SIZE; i++) {
+        bandState[i] = {BAND_TABLE[i].defaultFreq, 0, 0, BAND_TABLE[i].defaultStep};
+    }
 }
 
 /**
- * SSB patch betöltése
+ * A band leírója az index alapján
  */
-void Band::loadSSB() {
+const BandDesc_t &Band::getBandDesc(uint8_t bandIdx) const {
+    return BAND_TABLE[bandIdx];
+}
 
-    // Ha már be van töltve, akkor nem megyünkn tovább
-    if (ssbLoaded) {
-        return;
+/**
+ * A band állapota az index alapján
+ */
+BandState_t &Band::getBandState(uint8_t bandIdx) {
+    return bandState[bandIdx];
+}
+
+/**
+ * A Band tábla mérete
+ */
+uint8_t Band::getBandCount() const {
+    return BAND_TABLE_SIZE;
+}
+
+/**
+ * A frekvenciát (kHz) tartalmazó legszűkebb band indexe
+ */
+int8_t Band::findBandByKHz(uint32_t kHz) const {
+    return lookupBandIndex(kHz);
+}
+
+/**
+ * Band egységű frekvencia (FM: 10kHz, egyébként kHz) átváltása kHz-re
+ */
+uint32_t Band::toKHz(uint8_t bandIdx, uint16_t frequency) const {
+    return BAND_TABLE[bandIdx].bandType == FM_BAND_TYPE ? frequency * 10UL : frequency;
+}
+
+/**
+ * kHz átváltása a band egységére
+ */
+uint16_t Band::fromKHz(uint8_t bandIdx, uint32_t kHz) const {
+    return BAND_TABLE[bandIdx].bandType == FM_BAND_TYPE ? kHz / 10 : kHz;
+}
+
+/**
+ * A cél frekvencia a megadott számú lépés után
+ */
+uint16_t Band::getStepFrequency(uint16_t frequency, int32_t steps) const {
+
+    const BandDesc_t &desc = BAND_TABLE[config.data.bandIdx];
+    int32_t target = frequency + steps * tuningStep;
+    if (target > desc.maximumFreq) {
+        return desc.minimumFreq;
     }
+    if (target < desc.minimumFreq) {
+        return desc.maximumFreq;
+    }
+    return target;
+}
+
+/**
+ * SSB patch betöltés indítása: reset és POWER_UP patch módban
+ */
+void Band::beginSSBLoad() {
+
+    ssbLoaded = false;
+    patchStartUsec = micros();
 
+    // A reset a property-ket is alapértékre állítja
+    shadow.invalidate();
+    chipFunction = CHIP_SSB;
     si4735.reset();
     si4735.queryLibraryId(); // Is it really necessary here? I will check it.
     si4735.patchPowerUp();
-    delay(50);
-
-    si4735.setI2CFastMode(); // Recommended
-    // si4735.setI2CFastModeCustom(500000); // It is a test and may crash.
-    si4735.downloadPatch(ssb_patch_content, sizeof(ssb_patch_content));
-    si4735.setI2CStandardMode(); // goes back to default (100KHz)
-    delay(50);
-
-    // Parameters
-    // AUDIOBW - SSB Audio bandwidth; 0 = 1.2KHz (default); 1=2.2KHz; 2=3KHz; 3=4KHz; 4=500Hz; 5=1KHz;
-    // SBCUTFLT SSB - side band cutoff filter for band passand low pass filter ( 0 or 1)
-    // AVC_DIVIDER  - set 0 for SSB mode; set 3 for SYNC mode.
-    // AVCEN - SSB Automatic Volume Control (AVC) enable; 0=disable; 1=enable (default).
-    // SMUTESEL - SSB Soft-mute Based on RSSI or SNR (0 or 1).
-    // DSP_AFCDIS - DSP AFC Disable or enable; 0=SYNC MODE, AFC enable; 1=SSB MODE, AFC disable.
-    si4735.setSSBConfig(config.data.bwIdxSSB, 1, 0, 1, 0, 1);
-    delay(25);
-    ssbLoaded = true;
+    setSSBLoadState(SSB_LOAD_POWERUP);
+}
+
+/**
+ * Állapotváltás az SSB patch betöltésben
+ */
+void Band::setSSBLoadState(SsbLoadState state) {
+    ssbLoadState = state;
+    ssbLoadStateMsec = millis();
+}
+
+/**
+ * A patch következő darabjainak letöltése
+ * @param chunks legfeljebb ennyi SSB_PATCH_CHUNK_SIZE méretű darab
+ * @return true, ha a teljes patch letöltődött
+ */
+bool Band::downloadSSBChunks(uint8_t chunks) {
+
+#ifdef SSB_PATCH_COMPRESSED
+    // Darabonként kitömörítjük és letöltjük, a RAM igény csak az ablak és egy darab
+    uint8_t chunk[SSB_PATCH_CHUNK_SIZE];
+    for (uint8_t i = 0; i < chunks and !ssbPatchDecoder.isDone(); i++) {
+        uint16_t len = ssbPatchDecoder.read(chunk, sizeof(chunk));
+        ssbPatchOk &= si4735.downloadPatch(chunk, len);
+        ssbPatchCrc = calcCRC16(chunk, len, SSB_PATCH_CRC16_POLYNOME, ssbPatchCrc);
+        ssbLoadBytes += len;
+    }
+    return ssbPatchDecoder.isDone();
+#else
+    for (uint8_t i = 0; i < chunks and ssbLoadBytes < SSB_PATCH_SIZE; i++) {
+        uint16_t len = SSB_PATCH_SIZE - ssbLoadBytes < SSB_PATCH_CHUNK_SIZE ? SSB_PATCH_SIZE - ssbLoadBytes : SSB_PATCH_CHUNK_SIZE;
+        ssbPatchOk &= si4735.downloadPatch(ssb_patch_content + ssbLoadBytes, len);
+        ssbPatchCrc = calcCRC16(ssb_patch_content + ssbLoadBytes, len, SSB_PATCH_CRC16_POLYNOME, ssbPatchCrc);
+        ssbLoadBytes += len;
+    }
+    return ssbLoadBytes >= SSB_PATCH_SIZE;
+#endif
+}
+
+/**
+ * A patch letöltésének kezdete (a POWER_UP utáni várakozás után)
+ */
+void Band::startSSBDownload() {
+    ssbLoadBytes = 0;
+    ssbPatchOk = true;
+    ssbPatchCrc = 0;
+#ifdef SSB_PATCH_COMPRESSED
+    ssbPatchDecoder.begin(ssb_patch_lz, sizeof(ssb_patch_lz));
+#endif
+    setSSBLoadState(SSB_LOAD_DOWNLOAD);
+}
+
+/**
+ * A letöltött patch ellenőrzése: a chip minden patch parancsot hibajelzés nélkül fogadott, és a kitömörítés hibátlan
+ * (a kiküldött bájtok CRC-je egyezik az eredetivel; ez a mi oldalunkat ellenőrzi, a chipbe került adatot nem)
+ */
+bool Band::isSSBPatchValid() {
+    return ssbPatchOk and ssbLoadBytes == SSB_PATCH_SIZE and ssbPatchCrc == SSB_PATCH_CRC16;
+}
+
+/**
+ * Az SSB patch betöltés következő lépése
+ */
+bool Band::serviceSSBLoad() {
+
+    switch (ssbLoadState) {
+
+    case SSB_LOAD_POWERUP:
+        // A POWER_UP után várni kell a letöltéssel
+        if (millis() - ssbLoadStateMsec < SSB_PATCH_POWERUP_DELAY_MSEC) {
+            return false;
+        }
+        // Az I2C órajelet nem állítjuk: minden forgalom a kalibrált (I2cClockTuner) órajelen megy
+        startSSBDownload();
+        return false;
+
+    case SSB_LOAD_DOWNLOAD:
+        if (downloadSSBChunks(SSB_PATCH_CHUNKS_PER_STEP)) {
+            if (!ssbPatchOk) {
+                switchStats.patchStatusErrors++;
+            }
+            if (!isSSBPatchValid()) {
+                DEBUG("Band: hibás SSB patch letöltés (%lu bájt, CRC %04X)\n", ssbLoadBytes, ssbPatchCrc);
+            }
+            setSSBLoadState(SSB_LOAD_SETTLE);
+        }
+        return false;
+
+    case SSB_LOAD_SETTLE:
+        if (millis() - ssbLoadStateMsec < SSB_PATCH_SETTLE_DELAY_MSEC) {
+            return false;
+        }
+        // A paramétereket a useBand() állítja be (SSB vagy szinkron AM)
+        ssbLoaded = true;
+        ssbLoadState = SSB_LOAD_IDLE;
+        switchStats.lastPatchLoadUsec = micros() - patchStartUsec;
+        switchStats.lastLoadedPatch = true;
+        switchStats.patchLoads++;
+        finishBandSet();
+        return true;
+
+    default:
+        return true;
+    }
+}
+
+/**
+ * Az SSB patch betöltés állapota százalékban
+ */
+uint8_t Band::getSSBLoadProgress() const {
+    switch (ssbLoadState) {
+    case SSB_LOAD_POWERUP:
+        return 0;
+    case SSB_LOAD_DOWNLOAD:
+        return ssbLoadBytes * 100 / SSB_PATCH_SIZE;
+    default:
+        return 100;
+    }
+}
+
+/**
+ * Az SSB patch blokkoló letöltése és ellenőrzése az aktuális I2C órajelen (az I2C órajel kalibrálásához)
+ */
+bool Band::verifySSBPatch() {
+
+    beginSSBLoad();
+    delay(SSB_PATCH_POWERUP_DELAY_MSEC);
+    startSSBDownload();
+    while (!downloadSSBChunks(SSB_PATCH_CHUNKS_PER_STEP)) {
+    }
+    delay(SSB_PATCH_SETTLE_DELAY_MSEC);
+
+    // Hibás letöltés után a chip állapota ismeretlen: a következő band váltás újraindítja
+    ssbLoaded = isSSBPatchValid();
+    ssbLoadState = SSB_LOAD_IDLE;
+    if (!ssbLoaded) {
+        chipFunction = CHIP_NONE;
+    }
+    return ssbLoaded;
+}
+
+/**
+ * A band property profiljának összeállítása a Band táblából és a beállításokból
+ * Csak property-k (SET_PROPERTY) kerülnek bele, a mód váltás (POWER_UP) és a hangolás nem
+ */
+void Band::buildProfile(BandProfile_t &profile) {
+
+    profile.count = 0;
+    const BandDesc_t &currentBand = BAND_TABLE[config.data.bandIdx];
+
+    if (currentBand.bandType == FM_BAND_TYPE) {
+        profile.add(SI473X_PROP_FM_DEEMPHASIS, 1);                // 50us (Európa)
+        profile.add(SI473X_PROP_FM_RDS_CONFIG, 0xAA01);           // RDSEN = 1, BLETHA..BLETHD = 2 (setRdsConfig(1, 2, 2, 2, 2))
+        profile.add(SI473X_PROP_FM_SEEK_BAND_BOTTOM, BAND_TABLE[0].minimumFreq); // FM band limits, a Band táblában a 0. indexü elem
+        profile.add(SI473X_PROP_FM_SEEK_BAND_TOP, BAND_TABLE[0].maximumFreq);
+        profile.add(SI473X_PROP_FM_SEEK_FREQ_SPACING, 10);
+        profile.add(SI473X_PROP_FM_SEEK_SNR_THRESHOLD, 5);
+        profile.add(SI473X_PROP_FM_SEEK_RSSI_THRESHOLD, 5);
+
+        /**
+         * FM sávszélesség (FM_CHANNEL_FILTER)
+         * 0 = automatikus (default), 1 = 110 kHz, 2 = 84 kHz, 3 = 60 kHz, 4 = 40 kHz
+         */
+        profile.add(SI473X_PROP_FM_CHANNEL_FILTER, config.data.bwIdxFM);
+        return;
+    }
+
+    // AM komponens (AM, SSB és szinkron AM), a seek (állomás keresés) az aktuális band határain belül
+    profile.add(SI473X_PROP_AM_SEEK_BAND_BOTTOM, currentBand.minimumFreq);
+    profile.add(SI473X_PROP_AM_SEEK_BAND_TOP, currentBand.maximumFreq);
+    profile.add(SI473X_PROP_AM_SEEK_FREQ_SPACING, currentBand.bandType == SW_BAND_TYPE ? config.data.ssIdxAM : config.data.ssIdxMW); // A useBand() lépésköze
+    profile.add(SI473X_PROP_AM_SEEK_SNR_THRESHOLD, 20);
+    profile.add(SI473X_PROP_AM_SEEK_RSSI_THRESHOLD, 50);
+
+    if (currentMode == AM) {
+        /**
+         * AM sávszélesség (AM_CHANNEL_FILTER): AMCHFLT, AMPLFLT << 8
+         * AMCHFLT: 0 = 6 kHz, 1 = 4 kHz, 2 = 3 kHz, 3 = 2 kHz, 4 = 1 kHz, 5 = 1.8 kHz, 6 = 2.5 kHz (gradual roll off)
+         * AMPLFLT: AM Power Line Noise Rejection Filter
+         */
+        profile.add(SI473X_PROP_AM_CHANNEL_FILTER, config.data.bwIdxAM);
+    }
+
+    if (!ssbLoaded) {
+        return;
+    }
+
+    /**
+     * SSB_MODE: AUDIOBW | SBCUTFLT << 4 | AVC_DIVIDER << 8 | AVCEN << 12 | SMUTESEL << 13 | DSP_AFCDIS << 15
+     * AUDIOBW - SSB Audio bandwidth; 0 = 1.2KHz (default); 1=2.2KHz; 2=3KHz; 3=4KHz; 4=500Hz; 5=1KHz;
+     * SBCUTFLT - 0 = band pass filter, 1 = low pass filter
+     * AVC_DIVIDER - 0 for SSB mode, 3 for SYNC mode
+     * AVCEN - SSB Automatic Volume Control (AVC) enable; 0=disable; 1=enable (default).
+     * SMUTESEL - SSB Soft-mute Based on RSSI or SNR (0 or 1).
+     * DSP_AFCDIS - DSP AFC Disable or enable; 0=SYNC MODE, AFC enable; 1=SSB MODE, AFC disable.
+     */
+    if (currentMode == LSB or currentMode == USB) {
+        // If audio bandwidth selected is about 2 kHz or below, it is recommended to set Sideband Cutoff Filter to 0.
+        uint8_t bw = config.data.bwIdxSSB;
+        uint8_t cutoff = (bw == 0 or bw == 4 or bw == 5) ? 0 : 1;
+        profile.add(SI473X_PROP_SSB_MODE, bw | (cutoff << 4) | (0 << 8) | (1 << 12) | (0 << 13) | (1 << 15));
+        profile.add(SI473X_PROP_SSB_BFO, (uint16_t)(config.data.currentBFO + config.data.currentBFOmanu));
+    } else {
+        // Szinkron AM a betöltött patch-csel
+        profile.add(SI473X_PROP_SSB_MODE, BAND_SYNC_AM_AUDIOBW | (1 << 4) | (3 << 8) | (1 << 12) | (0 << 13) | (0 << 15));
+        profile.add(SI473X_PROP_SSB_BFO, 0);
+    }
+}
+
+/**
+ * A profil kiírása a chipbe: csak azokat a property-ket írjuk, amelyek az árnyék szerint eltérnek
+ */
+void Band::applyProfile(const BandProfile_t &profile) {
+
+    switchStats.lastPropertyWrites = 0;
+    switchStats.lastPropertySkips = 0;
+
+    for (uint8_t i = 0; i < profile.count; i++) {
+        const PropertyValue_t &prop = profile.props[i];
+        if (shadow.setProperty(prop.id, prop.value)) {
+            switchStats.lastPropertyWrites++;
+        } else {
+            switchStats.lastPropertySkips++;
+        }
+    }
 }
 
 /**
  * Band beállítása
+ * A mód váltást (ha kell, POWER_UP) és a hangolást végzi, a property-ket a profil alapján csak a különbségként írjuk
  */
 void Band::useBand() {
 
-    BandTable_t currentBand = bandTable[config.data.bandIdx];
+    // A leíró a flash-ben, az állapot a RAM-ban: nincs másolás, a lépésközt a beállításokból vesszük
+    const BandDesc_t &currentBand = BAND_TABLE[config.data.bandIdx];
+    BandState_t &state = bandState[config.data.bandIdx];
+    uint8_t step;
 
     switch (currentBand.bandType) {
 
@@ -92,104 +493,65 @@ void Band::useBand() {
 
         switch (currentBand.bandType) {
         case SW_BAND_TYPE:
-            currentBand.currentStep = config.data.ssIdxAM;
+            step = config.data.ssIdxAM;
             si4735.setTuneFrequencyAntennaCapacitor(1);
             break;
         default:
-            currentBand.currentStep = config.data.ssIdxMW;
+            step = config.data.ssIdxMW;
             si4735.setTuneFrequencyAntennaCapacitor(0);
             break;
         }
 
-        if (ssbLoaded) {
-            si4735.setSSB(currentBand.minimumFreq, currentBand.maximumFreq, currentBand.currentFreq, currentBand.currentStep, currentMode);
-            si4735.setSSBBfo(config.data.currentBFO + config.data.currentBFOmanu);
+        if (currentMode == LSB or currentMode == USB) {
+            si4735.setSSB(currentBand.minimumFreq, currentBand.maximumFreq, state.currentFreq, step, currentMode);
             // SSB ONLY 1KHz stepsize
-            bandTable[config.data.bandIdx].currentStep = 1;
+            {
+                StateLock lock(*this);
+                state.currentStep = 1;
+            }
             si4735.setFrequencyStep(1);
+            step = 1;
 
+#ifdef BAND_AM_SYNC_ON_SSB_PATCH
+        } else if (ssbLoaded) {
+            // AM a betöltött patch-csel: szinkron AM, így nem kell újraindítani a chipet (és újra letölteni a patch-et)
+            si4735.setSSB(currentBand.minimumFreq, currentBand.maximumFreq, state.currentFreq, step, BAND_SYNC_AM_SIDEBAND);
+            bfoOn = false;
+#endif
         } else {
-            si4735.setAM(currentBand.minimumFreq, currentBand.maximumFreq, currentBand.currentFreq, currentBand.currentStep);
+            // A setAM() csak FM és SSB módból indítja újra a chipet (ekkor a patch és a property-k elvesznek)
+            if (chipFunction != CHIP_AM) {
+                shadow.invalidate();
+                chipFunction = CHIP_AM;
+            }
+            si4735.setAM(currentBand.minimumFreq, currentBand.maximumFreq, state.currentFreq, step);
+            ssbLoaded = false;
             bfoOn = false;
         }
         break;
 
     case FM_BAND_TYPE:
+        // A setFM() mindig POWER_UP-ot ad ki: a patch és a property-k elvesznek
         ssbLoaded = false;
+        shadow.invalidate();
+        chipFunction = CHIP_FM;
         bfoOn = false;
-        currentBand.currentStep = config.data.ssIdxFM;
+        step = config.data.ssIdxFM;
         si4735.setTuneFrequencyAntennaCapacitor(0);
-        si4735.setFM(currentBand.minimumFreq, currentBand.maximumFreq, currentBand.currentFreq, currentBand.currentStep);
-        si4735.setFMDeEmphasis(1);
+        si4735.setFM(currentBand.minimumFreq, currentBand.maximumFreq, state.currentFreq, step);
         si4735.RdsInit();
-        si4735.setRdsConfig(1, 2, 2, 2, 2);
-        si4735.setSeekFmSpacing(10);
-        si4735.setSeekFmLimits(bandTable[0].minimumFreq, bandTable[0].maximumFreq); // FM band limits, a Band táblában a 0. indexü elem
-        si4735.setSeekAmRssiThreshold(50);
-        si4735.setSeekAmSrnThreshold(20);
-        si4735.setSeekFmRssiThreshold(5);
-        si4735.setSeekFmSrnThreshold(5);
         break;
 
     default:
         DEBUG("Hiba: Le nem kezelt bandType: %d\n", currentBand.bandType);
         return;
     }
-}
 
-/**
- * Sávszélesség beállítása
- */
-void Band::setBandWidth() {
-
-    if (currentMode == LSB || currentMode == USB) {
-        si4735.setSSBAudioBandwidth(config.data.bwIdxSSB);
-
-        // If audio bandwidth selected is about 2 kHz or below, it is recommended to set Sideband Cutoff Filter to 0.
-        if (config.data.bwIdxSSB == 0 or config.data.bwIdxSSB == 4 or config.data.bwIdxSSB == 5) {
-            // Band pass filter to cutoff both the unwanted side band and high frequency components > 2.0 kHz of the wanted side band. (default)
-            si4735.setSSBSidebandCutoffFilter(0);
+    tuningStep = step;
 
-        } else {
-            // Low pass filter to cutoff the unwanted side band.
-            si4735.setSSBSidebandCutoffFilter(1);
-        }
-    }
-
-    if (currentMode == AM) {
-        /**
-         * @ingroup group08 Set bandwidth
-         * @brief Selects the bandwidth of the channel filter for AM reception.
-         * @details The choices are 6, 4, 3, 2, 2.5, 1.8, or 1 (kHz). The default bandwidth is 2 kHz. It works only in AM / SSB (LW/MW/SW)
-         * @see Si47XX PROGRAMMING GUIDE; AN332 (REV 1.0); pages 125, 151, 277, 181.
-         * @param AMCHFLT the choices are:   0 = 6 kHz Bandwidth
-         *                                   1 = 4 kHz Bandwidth
-         *                                   2 = 3 kHz Bandwidth
-         *                                   3 = 2 kHz Bandwidth
-         *                                   4 = 1 kHz Bandwidth
-         *                                   5 = 1.8 kHz Bandwidth
-         *                                   6 = 2.5 kHz Bandwidth, gradual roll off
-         *                                   7–15 = Reserved (Do not use).
-         * @param AMPLFLT Enables the AM Power Line Noise Rejection Filter.
-         */
-        si4735.setBandwidth(config.data.bwIdxAM, 0);
-
-    } else if (currentMode == FM) {
-        /**
-         * @brief Sets the Bandwith on FM mode
-         * @details Selects bandwidth of channel filter applied at the demodulation stage. Default is automatic which means the device automatically selects proper channel filter. <BR>
-         * @details | Filter  | Description |
-         * @details | ------- | -------------|
-         * @details |    0    | Automatically select proper channel filter (Default) |
-         * @details |    1    | Force wide (110 kHz) channel filter |
-         * @details |    2    | Force narrow (84 kHz) channel filter |
-         * @details |    3    | Force narrower (60 kHz) channel filter |
-         * @details |    4    | Force narrowest (40 kHz) channel filter |
-         *
-         * @param filter_value
-         */
-        si4735.setFmBandwidth(config.data.bwIdxFM);
-    }
+    BandProfile_t profile;
+    buildProfile(profile);
+    applyProfile(profile);
 }
 
 /**
@@ -197,21 +559,39 @@ void Band::setBandWidth() {
  */
 void Band::checkAGC() {
 
-    si4735.getAutomaticGainControl();
-
-    if (si4735.isAgcEnabled()) {
-
-        if (config.data.AGCgain == 2) {
-            si4735.setAutomaticGainControl(1, currentAGCgain);
-
-        } else if (config.data.AGCgain == 0) {
-            si4735.setAutomaticGainControl(1, 0); // disabled
-        }
+    // Az árnyék ismeri a chip AGC állapotát, így nem kell visszaolvasni (AGC_STATUS): csak a változást írjuk ki
+    switch (config.data.AGCgain) {
+    case 0:
+        shadow.setAutomaticGainControl(1, 0); // disabled
+        break;
+    case 2:
+        shadow.setAutomaticGainControl(1, currentAGCgain); // manual
+        break;
+    default:
+        shadow.setAutomaticGainControl(0, 0); // enabled
+        break;
+    }
+}
 
-    } else if (config.data.AGCgain == 1) {
+/**
+ * Hány msec múlva folytatható az SSB patch betöltése
+ */
+uint32_t Band::getSSBLoadWaitMsec() const {
 
-        si4735.setAutomaticGainControl(0, 0); // enabled
+    uint32_t delayMsec;
+    switch (ssbLoadState) {
+    case SSB_LOAD_POWERUP:
+        delayMsec = SSB_PATCH_POWERUP_DELAY_MSEC;
+        break;
+    case SSB_LOAD_SETTLE:
+        delayMsec = SSB_PATCH_SETTLE_DELAY_MSEC;
+        break;
+    default:
+        return 0;
     }
+
+    uint32_t elapsed = millis() - ssbLoadStateMsec;
+    return elapsed >= delayMsec ? 0 : delayMsec - elapsed;
 }
 
 /**
@@ -219,13 +599,23 @@ void Band::checkAGC() {
  */
 void Band::BandInit() {
 
-    if (bandTable[config.data.bandIdx].bandType == FM_BAND_TYPE) {
+    // Ha be van kötve a GPO2/INT, akkor a POWER_UP-ban engedélyezni kell a GPO2 kimenetet (a későbbi POWER_UP-ok is megtartják)
+#ifdef PIN_SI4735_INT
+    const uint8_t gpo2Enable = 1;
+#else
+    const uint8_t gpo2Enable = 0;
+#endif
+
+    shadow.invalidate();
+    if (BAND_TABLE[config.data.bandIdx].bandType == FM_BAND_TYPE) {
+        chipFunction = CHIP_FM;
         DEBUG("Start in FM\n");
-        si4735.setup(PIN_SI4735_RESET, FM_BAND_TYPE);
+        si4735.setup(PIN_SI4735_RESET, 0, FM_BAND_TYPE, SI473X_ANALOG_AUDIO, XOSCEN_CRYSTAL, gpo2Enable);
         si4735.setFM();
     } else {
+        chipFunction = CHIP_AM;
         DEBUG("Start in AM\n");
-        si4735.setup(PIN_SI4735_RESET, MW_BAND_TYPE);
+        si4735.setup(PIN_SI4735_RESET, 0, MW_BAND_TYPE, SI473X_ANALOG_AUDIO, XOSCEN_CRYSTAL, gpo2Enable);
         si4735.setAM();
     }
 }
@@ -233,24 +623,72 @@ void Band::BandInit() {
 /**
  * Band beállítása
  */
-void Band::BandSet() {
-    if (bandTable[config.data.bandIdx].bandType == FM_BAND_TYPE) {
-        currentMode = FM; // only mod FM in FM band
-    }
+bool Band::BandSet(bool async) {
+
+    switchStartUsec = micros();
 
-    if ((currentMode == AM) or (currentMode == FM)) {
-        ssbLoaded = false; // FIXME: Ez kell? Band váltás után megint be kell tölteni az SSB-t?
+    // Az FM sávban csak FM lehet, egyébként a sáv alapértelmezett, vagy a memória csatornából visszahívott modulációja
+    if (modeOverrideBandIdx != config.data.bandIdx) {
+        modeOverrideBandIdx = BAND_NO_MODE_OVERRIDE;
     }
+    currentMode = BAND_TABLE[config.data.bandIdx].bandType == FM_BAND_TYPE ? FM
+                  : modeOverrideBandIdx != BAND_NO_MODE_OVERRIDE      ? modeOverride
+                                                                      : BAND_TABLE[config.data.bandIdx].prefmod;
+
+    // A patch-et csak akkor töltjük le, ha még nincs a chipben
+    switchStats.lastLoadedPatch = false;
+    if (((currentMode == LSB) or (currentMode == USB)) and !ssbLoaded) {
+        beginSSBLoad();
+        if (async) {
+            return false; // A folytatás a serviceSSBLoad() dolga
+        }
 
-    if ((currentMode == LSB) or (currentMode == USB)) {
-        if (ssbLoaded == false) {
-            loadSSB();
+        // Blokkoló betöltés (pl.: a setup()-ban), a letöltést nem szakítjuk meg, csak a várakozásokat
+        while (!serviceSSBLoad()) {
+            if (ssbLoadState != SSB_LOAD_DOWNLOAD) {
+                delay(1);
+            }
         }
+        return true;
     }
 
+    finishBandSet();
+    return true;
+}
+
+/**
+ * A band modulációjának felülírása (memória csatorna)
+ */
+void Band::setModeOverride(uint8_t bandIdx, uint8_t mode) {
+    bool valid = bandIdx < BAND_TABLE_SIZE and BAND_TABLE[bandIdx].bandType != FM_BAND_TYPE and (mode == AM or mode == LSB or mode == USB);
+    modeOverrideBandIdx = valid ? bandIdx : BAND_NO_MODE_OVERRIDE;
+    modeOverride = mode;
+}
+
+/**
+ * A band váltás befejezése (a patch már a chipben van, ha kell)
+ */
+void Band::finishBandSet() {
+
     useBand();
-    setBandWidth();
     checkAGC();
 
-    currentMode = bandTable[config.data.bandIdx].prefmod;
+    switchStats.lastUsec = micros() - switchStartUsec;
+    if (switchStats.lastUsec > switchStats.maxUsec) {
+        switchStats.maxUsec = switchStats.lastUsec;
+    }
+    switchStats.switches++;
+}
+
+/**
+ * Band váltási statisztika kiírása a soros portra
+ */
+void Band::debugSwitchStats() {
+    Serial.printf("===== Band switch =====\n");
+    Serial.printf("Band: %s, mode: %d, SSB patch: %s\n", BAND_TABLE[config.data.bandIdx].bandName, currentMode, ssbLoaded ? "loaded" : "-");
+    Serial.printf("Switches: %lu, last: %lu usec%s, max: %lu usec\n",
+                  switchStats.switches, switchStats.lastUsec, switchStats.lastLoadedPatch ? " (patch)" : "", switchStats.maxUsec);
+    Serial.printf("Patch loads: %lu, last: %lu usec, chip status errors: %lu\n", switchStats.patchLoads, switchStats.lastPatchLoadUsec, switchStats.patchStatusErrors);
+    Serial.printf("Properties (last switch): written %u, skipped %u\n", switchStats.lastPropertyWrites, switchStats.lastPropertySkips);
+    Serial.printf("---\n");
 }
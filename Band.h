@@ -2,6 +2,8 @@
 #define __BAND_H
 
 #include "Config.h"
+#include "PropertyShadow.h"
+#include <CoreMutex.h>
 #include <SI4735.h>
 
 // Band index
@@ -17,18 +19,84 @@
 #define AM 3
 #define CW 4
 
-// Band data
+// SSB patch
+#define BAND_AM_SYNC_ON_SSB_PATCH // Betöltött SSB patch mellett az AM-et a patch szinkron AM (SYNC) módjában vesszük, így a patch a chipben marad
+#define BAND_SYNC_AM_SIDEBAND USB // SYNC módban a vett oldalsáv
+#define BAND_SYNC_AM_AUDIOBW 3    // SYNC módban a hang sávszélessége (3 = 4kHz)
+#define SSB_PATCH_CHUNK_SIZE (8 * 8)     // A patch letöltése ennyi bájtos darabokban (8 bájtos patch parancsok)
+#define SSB_PATCH_CHUNKS_PER_STEP 4      // Egy lépésben ennyi darabot töltünk le (a core1 két lépés között mást is csinálhat)
+#define SSB_PATCH_POWERUP_DELAY_MSEC 50  // Várakozás a patch módú POWER_UP után
+#define SSB_PATCH_SETTLE_DELAY_MSEC 50   // Várakozás a letöltés után
+#define SSB_PATCH_CRC16_POLYNOME 0x8001  // A letöltött patch ellenőrzése (a CRC könyvtár alapértelmezett CRC-16-ja)
+
+#define BAND_TABLE_SIZE 30 // A Band tábla elemeinek száma (a Band.cpp fordításkor ellenőrzi)
+#define BAND_NO_MODE_OVERRIDE 0xFF // Nincs felülírt moduláció: a band a táblában megadottal indul
+
+// Si473x property-k (AN332)
+#define SI473X_PROP_SSB_BFO 0x0100                 // SSB BFO eltolás (Hz)
+#define SI473X_PROP_SSB_MODE 0x0101                // SSB mód (sávszélesség, AVC, AFC)
+#define SI473X_PROP_FM_DEEMPHASIS 0x1100           // FM de-emphasis
+#define SI473X_PROP_FM_CHANNEL_FILTER 0x1102       // FM sávszélesség
+#define SI473X_PROP_FM_SEEK_BAND_BOTTOM 0x1400     // FM seek alsó határ
+#define SI473X_PROP_FM_SEEK_BAND_TOP 0x1401        // FM seek felső határ
+#define SI473X_PROP_FM_SEEK_FREQ_SPACING 0x1402    // FM seek lépésköz
+#define SI473X_PROP_FM_SEEK_SNR_THRESHOLD 0x1403   // FM seek SNR küszöb
+#define SI473X_PROP_FM_SEEK_RSSI_THRESHOLD 0x1404  // FM seek RSSI küszöb
+#define SI473X_PROP_FM_RDS_CONFIG 0x1502           // RDS engedélyezés és blokk hiba küszöbök
+#define SI473X_PROP_AM_CHANNEL_FILTER 0x3102       // AM sávszélesség
+#define SI473X_PROP_AM_SEEK_BAND_BOTTOM 0x3400     // AM seek alsó határ
+#define SI473X_PROP_AM_SEEK_BAND_TOP 0x3401        // AM seek felső határ
+#define SI473X_PROP_AM_SEEK_FREQ_SPACING 0x3402    // AM seek lépésköz
+#define SI473X_PROP_AM_SEEK_SNR_THRESHOLD 0x3403   // AM seek SNR küszöb
+#define SI473X_PROP_AM_SEEK_RSSI_THRESHOLD 0x3404  // AM seek RSSI küszöb
+
+#define SI4735_TUNE_DELAY_MSEC 30 // A PU2CLR könyvtár alapértelmezett várakozása hangolás után (MAX_DELAY_AFTER_SET_FREQUENCY)
+
+#define BAND_PROFILE_MAX_PROPERTIES 12 // Egy band profil property-jeinek max. száma
+
+// Egy band-hez tartozó property értékek (ezeket a band váltás után a chipben be kell állítani)
+struct BandProfile_t {
+    uint8_t count;
+    PropertyValue_t props[BAND_PROFILE_MAX_PROPERTIES];
+
+    void add(uint16_t id, uint16_t value) {
+        if (count < BAND_PROFILE_MAX_PROPERTIES) {
+            props[count++] = {id, value};
+        }
+    }
+};
+
+// Band leíró: a sáv nem változó adatai (constexpr tábla a flash-ben, fordításkor ellenőrizve)
 typedef struct {
     const char *bandName; // Bandname
     uint8_t bandType;     // Band type (FM, MW or SW)
-    uint16_t prefmod;     // Pref. modulation
+    uint8_t prefmod;      // Pref. modulation
     uint16_t minimumFreq; // Minimum frequency of the band
     uint16_t maximumFreq; // maximum frequency of the band
-    uint16_t currentFreq; // Default frequency or current frequency
-    uint8_t currentStep;  // Default step (increment and decrement)
-    int lastBFO;          // Last BFO per band
-    int lastmanuBFO;      // Last Manual BFO per band using X-Tal
-} BandTable_t;
+    uint16_t defaultFreq; // Default frequency
+    uint8_t defaultStep;  // Default step (increment and decrement)
+} BandDesc_t;
+
+// Band állapot: a sáv változó adatai a RAM-ban (packed: 8 bájt, a 16 bites mezők igazítva, így az írásuk atomi)
+struct __attribute__((packed, aligned(2))) BandState_t {
+    uint16_t currentFreq; // Current frequency
+    int16_t lastBFO;      // Last BFO per band
+    int16_t lastmanuBFO;  // Last Manual BFO per band using X-Tal
+    uint8_t currentStep;  // Current step (increment and decrement)
+};
+
+// Band váltási statisztika
+typedef struct {
+    uint32_t switches;         // Band váltások száma
+    uint32_t lastUsec;         // Az utolsó váltás ideje
+    uint32_t maxUsec;          // A leghosszabb váltás ideje
+    uint32_t patchLoads;       // SSB patch letöltések száma
+    uint32_t lastPatchLoadUsec; // Az utolsó patch letöltés ideje
+    uint32_t patchStatusErrors; // Patch letöltések, ahol a chip valamelyik patch parancsra hibát jelzett (a patch-et nem lehet visszaolvasni)
+    bool lastLoadedPatch;      // Az utolsó váltás töltött patch-et?
+    uint8_t lastPropertyWrites; // Az utolsó váltáskor kiírt property-k
+    uint8_t lastPropertySkips;  // Az utolsó váltáskor kihagyott (már beállított) property-k
+} BandSwitchStats_t;
 
 /**
  * Band class
@@ -39,27 +107,194 @@ private:
     SI4735 &si4735;
     Config &config;
 
-    // SSB betöltve?
+    // SSB patch a chipben? (csak FM POWER_UP vagy reset törli, illetve ha az AM-hez újra kell indítani a chipet)
     bool ssbLoaded = false;
 
+    // A chipnek a useBand()-ben átadott lépésköz (SSB-ben 1kHz)
+    uint8_t tuningStep = 1;
+
+    // SSB patch betöltés állapotgépe
+    enum SsbLoadState : uint8_t {
+        SSB_LOAD_IDLE = 0,  // Nincs betöltés folyamatban
+        SSB_LOAD_POWERUP,   // POWER_UP után várunk
+        SSB_LOAD_DOWNLOAD,  // Letöltés darabokban
+        SSB_LOAD_SETTLE     // Letöltés után várunk
+    };
+    SsbLoadState ssbLoadState = SSB_LOAD_IDLE;
+    uint32_t ssbLoadStateMsec = 0; // Az aktuális állapot kezdete
+    uint32_t ssbLoadBytes = 0;     // Eddig letöltött (kitömörített) bájtok
+    bool ssbPatchOk = true;        // A chip eddig minden patch parancsot hiba nélkül fogadott?
+    uint16_t ssbPatchCrc = 0;      // Az eddig kiküldött bájtok CRC-je
+
+    // A chip aktuális funkciója (az utolsó POWER_UP szerint)
+    enum ChipFunction : uint8_t {
+        CHIP_NONE = 0,
+        CHIP_FM,
+        CHIP_AM,
+        CHIP_SSB // AM a betöltött SSB patch-csel
+    };
+    ChipFunction chipFunction = CHIP_NONE;
+
+    // A band-ek változó adatai (a leírók a Band.cpp constexpr táblájában)
+    BandState_t bandState[BAND_TABLE_SIZE];
+    mutex_t stateMutex; // A bandState írása (core1) és a mentéshez készült másolat (core0) közös zárja
+
+    // A chipbe írt property-k árnyéka (csak az eltéréseket írjuk, a POWER_UP-ot a Band ismeri, ezért itt él)
+    PropertyShadow shadow;
+
+    // A memória csatornából visszahívott moduláció, a következő band váltásig érvényes (csak a core1 írja)
+    uint8_t modeOverrideBandIdx = BAND_NO_MODE_OVERRIDE;
+    uint8_t modeOverride = AM;
+
+    BandSwitchStats_t switchStats = {};
+    uint32_t switchStartUsec = 0;
+    uint32_t patchStartUsec = 0;
+
     void checkAGC();
-    void setBandWidth();
-    void loadSSB();
+    void beginSSBLoad();
+    void startSSBDownload();
+    bool isSSBPatchValid();
+    void setSSBLoadState(SsbLoadState state);
+    bool downloadSSBChunks(uint8_t chunks);
+    void buildProfile(BandProfile_t &profile);
+    void applyProfile(const BandProfile_t &profile);
     void useBand();
+    void finishBandSet();
+    void resetBandStates();
 
 public:
     uint8_t currentMode; // aktuális mód/modulációs típus (FM, AM, LSB, USB, CW)
 
-    Band(SI4735 &si4735, Config &config) : si4735(si4735), config(config) {}
+    Band(SI4735 &si4735, Config &config) : si4735(si4735), config(config), shadow(si4735) {
+        mutex_init(&stateMutex);
+        resetBandStates();
+    }
     virtual ~Band() = default;
 
+    /**
+     * A band állapotok zárolása: a core1 a getBandState() írásai, a core0 a mentéshez készített másolat körül tartja
+     * (a BandState_t több mezős, a másolat különben félkész állapotot láthat)
+     */
+    class StateLock {
+    private:
+        CoreMutex mtx;
+
+    public:
+        StateLock(Band &band) : mtx(&band.stateMutex) {}
+    };
+
     void BandInit();
-    void BandSet();
 
     /**
-     * A Band egy rekordjának elkérése az index alapján
+     * Band beállítása az aktuális (config.data.bandIdx) sávra
+     * @param async ha SSB patch betöltés kell, akkor csak elindítjuk, a folytatás a serviceSSBLoad() hívásokkal történik
+     * @return true, ha a band váltás befejeződött
+     */
+    bool BandSet(bool async = false);
+
+    /**
+     * A band modulációjának felülírása (memória csatorna), a BandSet() ezzel indítja a band-et, amíg másik band-re nem váltunk
+     * Az FM band-en csak FM, a többin AM, LSB vagy USB lehet, egyébként a tábla szerinti moduláció marad
+     * @param bandIdx a band, amelyre a moduláció vonatkozik
+     * @param mode a moduláció (FM, LSB, USB, AM)
+     */
+    void setModeOverride(uint8_t bandIdx, uint8_t mode);
+
+    /**
+     * Az SSB patch betöltés következő lépése (néhány darab letöltése vagy várakozás)
+     * @return true, ha a betöltés és vele a band váltás befejeződött
+     */
+    bool serviceSSBLoad();
+
+    /**
+     * Folyamatban van az SSB patch betöltése?
+     */
+    bool isSSBLoading() const { return ssbLoadState != SSB_LOAD_IDLE; }
+
+    /**
+     * Az SSB patch betöltés állapota (0-100%)
+     */
+    uint8_t getSSBLoadProgress() const;
+
+    /**
+     * Hány msec múlva folytatható az SSB patch betöltése (0: most, pl.: letöltés közben)
+     */
+    uint32_t getSSBLoadWaitMsec() const;
+
+    /**
+     * Az SSB patch blokkoló letöltése az aktuális I2C órajelen (az I2C órajel kalibrálásához)
+     * A chip csak a parancsonkénti státuszban jelez, a beírt patch-et nem lehet visszaolvasni: a CRC csak a kitömörítést
+     * ellenőrzi (a kiküldött bájtok egyeznek-e az eredeti patch-csel), az I2C átvitelt nem.
+     * Sikeres letöltés után a patch a chipben marad, különben a következő band váltás újraindítja a chipet
+     * @return true, ha a chip minden patch parancsot hibajelzés nélkül fogadott (és a teljes patch kiment)
+     */
+    bool verifySSBPatch();
+
+    /**
+     * A band leírója (nem változó adatok) az index alapján
+     */
+    const BandDesc_t &getBandDesc(uint8_t bandIdx) const;
+
+    /**
+     * A band állapota (aktuális frekvencia, lépésköz, BFO) az index alapján
+     */
+    BandState_t &getBandState(uint8_t bandIdx);
+
+    /**
+     * A Band tábla mérete
+     */
+    uint8_t getBandCount() const;
+
+    /**
+     * A frekvenciát tartalmazó legszűkebb band (átfedő band-eknél pl.: a 40M és nem a 41M vagy az SW)
+     * A szakasz tábla fordításkor készül, a keresés bináris (O(log n))
+     * @param kHz a frekvencia kHz-ben (FM is)
+     * @return a band indexe, -1, ha egyik band-be sem esik
+     */
+    int8_t findBandByKHz(uint32_t kHz) const;
+
+    /**
+     * Band egységű frekvencia (FM: 10kHz, egyébként kHz) átváltása kHz-re, és vissza
+     */
+    uint32_t toKHz(uint8_t bandIdx, uint16_t frequency) const;
+    uint16_t fromKHz(uint8_t bandIdx, uint32_t kHz) const;
+
+    /**
+     * A cél frekvencia az aktuális band-en a megadott számú lépés után (egy tekerés sorozat egyetlen hangolással)
+     * A band határán túl a könyvtár frequencyUp()/frequencyDown()-jához hasonlóan a band másik végére ugrunk
+     * @param frequency a kiinduló frekvencia
+     * @param steps előjeles lépésszám (pozitív: fel)
+     */
+    uint16_t getStepFrequency(uint16_t frequency, int32_t steps) const;
+
+    /**
+     * Be van töltve az SSB patch?
+     */
+    bool isSSBLoaded() const { return ssbLoaded; }
+
+    /**
+     * A chip állapota ismeretlen (pl.: hibás patch letöltés után), a következő BandSet() újraindítja
+     */
+    void invalidateChip() {
+        ssbLoaded = false;
+        chipFunction = CHIP_NONE;
+        shadow.invalidate();
+    }
+
+    /**
+     * A chip property árnyéka (minden property/hangerő/AGC írás ezen keresztül menjen)
+     */
+    PropertyShadow &getPropertyShadow() { return shadow; }
+
+    /**
+     * Band váltási statisztika
+     */
+    const BandSwitchStats_t &getSwitchStats() const { return switchStats; }
+
+    /**
+     * Band váltási statisztika kiírása a soros portra
      */
-    BandTable_t &getBandByIdx(uint8_t bandIdx);
+    void debugSwitchStats();
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,149 @@
+#include "BandScope.h"
+#include "utils.h"
+
+/**
+ * Sweep indítása
+ */
+void BandScope::start() {
+
+    if (state != IDLE) {
+        return;
+    }
+
+    const BandDesc_t &currentBand = band.getBandDesc(config.data.bandIdx);
+    uint16_t span = currentBand.maximumFreq - currentBand.minimumFreq;
+    uint16_t currentStep = band.getBandState(config.data.bandIdx).currentStep;
+    uint16_t step = currentStep ? currentStep : 1;
+
+    // Ha a band több lépés, mint ahány oszlop van, akkor a lépés többszörösével mintavételezünk
+    stride = step;
+    if (span / stride + 1 > BAND_SCOPE_MAX_POINTS) {
+        uint16_t minStride = (span + BAND_SCOPE_MAX_POINTS - 2) / (BAND_SCOPE_MAX_POINTS - 1);
+        stride = ((minStride + step - 1) / step) * step;
+    }
+    startFrequency = currentBand.minimumFreq;
+    savedFrequency = si4735.getCurrentFrequency();
+
+    memset(rssi, 0, sizeof(rssi));
+    memset(snr, 0, sizeof(snr));
+    stats = {};
+    pointIdx = 0;
+    sweepPosition.store(0, std::memory_order_relaxed);
+    sweepCount.store(0, std::memory_order_relaxed);
+    points = span / stride + 1;
+    pointCount.store(points, std::memory_order_release);
+
+    // Sweep közben nem szólunk, és nem várunk fixen a hangolás után (az STC bitet figyeljük)
+    band.getPropertyShadow().setVolume(0);
+    si4735.setMaxDelaySetFrequency(0);
+
+    sweepStartUsec = micros();
+    state = TUNE;
+    running.store(true, std::memory_order_release);
+
+    DEBUG("BandScope: %u pont, %u lépéssel\n", points, stride);
+}
+
+/**
+ * Sweep leállítása
+ */
+void BandScope::stop() {
+
+    if (state == IDLE) {
+        return;
+    }
+
+    // Egy még futó hangolás STC-jét is nyugtázzuk, majd a könyvtár szokásos várakozásával hangolunk vissza
+    si4735.getStatus(1, 0);
+    si4735.setMaxDelaySetFrequency(SI4735_TUNE_DELAY_MSEC);
+    si4735.setFrequency(savedFrequency);
+    band.getPropertyShadow().setVolume(config.data.currentVOL);
+
+    state = IDLE;
+    running.store(false, std::memory_order_release);
+    pointCount.store(0, std::memory_order_release);
+}
+
+/**
+ * Minta eltárolása, és lépés a következő pontra
+ */
+void BandScope::storeSample(uint8_t sampleRssi, uint8_t sampleSnr) {
+
+    uint32_t pointUsec = micros() - pointStartUsec;
+    if (stats.points == 0 or pointUsec < stats.minPointUsec) {
+        stats.minPointUsec = pointUsec;
+    }
+    if (pointUsec > stats.maxPointUsec) {
+        stats.maxPointUsec = pointUsec;
+    }
+    stats.points++;
+
+    // Előbb a minta, utána a pozíció (a core0 a pozícióig olvas)
+    rssi[pointIdx] = sampleRssi;
+    snr[pointIdx] = sampleSnr;
+    pointIdx++;
+    sweepPosition.store(pointIdx, std::memory_order_release);
+
+    if (pointIdx >= points) {
+        uint32_t now = micros();
+        stats.lastSweepUsec = now - sweepStartUsec;
+        stats.pointsPerSec = (uint64_t)points * 1000000 / max(stats.lastSweepUsec, (uint32_t)1);
+        stats.sweeps++;
+        sweepStartUsec = now;
+        pointIdx = 0;
+        sweepCount.fetch_add(1, std::memory_order_release);
+        sweepPosition.store(0, std::memory_order_release);
+    }
+    state = TUNE;
+}
+
+/**
+ * A sweep következő lépése
+ */
+void BandScope::service() {
+
+    switch (state) {
+
+    case TUNE:
+        pointStartUsec = micros();
+        pointStartMsec = millis();
+        si4735.setFrequency(getFrequency(pointIdx));
+        state = WAIT_STC;
+        break;
+
+    case WAIT_STC: {
+        // Az STC csak a megszakítás státuszban látszik, a TUNE_STATUS-t csak utána olvassuk (nyugtázással)
+        if (!si4735.getInterruptStatus().resp.STCINT) {
+            if (millis() - pointStartMsec >= BAND_SCOPE_STC_TIMEOUT_MSEC) {
+                stats.stcTimeouts++;
+                si4735.getStatus(1, 0);
+                storeSample(0, 0);
+            }
+            break;
+        }
+        si4735.getStatus(1, 0);
+        storeSample(si4735.getReceivedSignalStrengthIndicator(), si4735.getStatusSNR());
+        break;
+    }
+
+    default:
+        break;
+    }
+}
+
+/**
+ * Statisztika kiírása a soros portra
+ */
+void BandScope::debugStats() const {
+
+    Serial.printf("===== Band scope =====\n");
+    Serial.printf("Running: %s, points: %u, stride: %u\n", isRunning() ? "yes" : "no", points, stride);
+    Serial.printf("Sweeps: %lu, samples: %lu, STC timeouts: %lu\n", stats.sweeps, stats.points, stats.stcTimeouts);
+    if (stats.sweeps) {
+        Serial.printf("Last sweep: %lu msec, %u points/sec\n", stats.lastSweepUsec / 1000, stats.pointsPerSec);
+    }
+    if (stats.points) {
+        Serial.printf("Point: min %lu usec, max %lu usec\n", stats.minPointUsec, stats.maxPointUsec);
+    }
+    Serial.printf("---\n");
+}
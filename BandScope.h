@@ -0,0 +1,141 @@
+#ifndef __BANDSCOPE_H
+#define __BANDSCOPE_H
+
+#include "Band.h"
+#include "Config.h"
+#include <SI4735.h>
+#include <atomic>
+
+#define BAND_SCOPE_MAX_POINTS 240        // A minták max. száma egy sweep-ben (a panoráma oszlopai)
+#define BAND_SCOPE_STC_TIMEOUT_MSEC 100  // Ennyi idő után a hangolást befejezettnek tekintjük (üres minta)
+
+// Sweep statisztika (a core1 írja, a core0 csak kiírja)
+struct BandScopeStats_t {
+    uint32_t sweeps;         // Befejezett sweep-ek
+    uint32_t points;         // Összes minta
+    uint32_t stcTimeouts;    // Időtúllépéses hangolások
+    uint32_t lastSweepUsec;  // A legutóbbi teljes sweep ideje
+    uint16_t pointsPerSec;   // A legutóbbi teljes sweep sebessége (minta/sec)
+    uint32_t minPointUsec;   // A leggyorsabb minta (hangolás + STC + státusz)
+    uint32_t maxPointUsec;   // A leglassabb minta
+};
+
+/**
+ * Band scope: RSSI/SNR sweep a band teljes tartományán
+ *
+ * A core1-en fut (a RadioService hívja a service()-t), amíg fut, a rádió nem szól (hangerő 0).
+ * Nem a könyvtár fix 30msec-es várakozásával hangol: kiadja a TUNE_FREQ-et, és a következő hívásokban
+ * az STC bitet figyeli, majd egyetlen TUNE_STATUS-szal olvassa ki az RSSI-t és az SNR-t (nincs külön RSQ_STATUS).
+ * Egy hívás soha nem vár, így a sweep közben is fogadjuk a parancsokat.
+ *
+ * A mintákat egy közös pufferbe írja, a core0 az atomi pozíció alapján blokkolás nélkül olvassa
+ * (a minta előbb íródik, utána a pozíció). A sweep-ek körbe járnak, leállításkor visszahangolunk az eredeti frekvenciára.
+ */
+class BandScope {
+
+private:
+    enum State : uint8_t {
+        IDLE = 0,
+        TUNE,     // A következő pont hangolása
+        WAIT_STC  // A hangolás végére várunk
+    };
+
+    SI4735 &si4735;
+    Band &band;
+    Config &config;
+
+    State state = IDLE;
+    uint16_t savedFrequency = 0;
+    uint16_t startFrequency = 0;
+    uint16_t points = 0; // A minták száma egy sweep-ben
+    uint16_t stride = 0; // Két minta közötti frekvencia lépés
+    uint16_t pointIdx = 0;
+    uint32_t pointStartUsec = 0;
+    uint32_t pointStartMsec = 0;
+    uint32_t sweepStartUsec = 0;
+
+    // Közös adatok (core1 -> core0)
+    uint8_t rssi[BAND_SCOPE_MAX_POINTS];
+    uint8_t snr[BAND_SCOPE_MAX_POINTS];
+    std::atomic<uint16_t> pointCount{0};
+    std::atomic<uint16_t> sweepPosition{0}; // Az aktuális sweep-ben már kész minták száma
+    std::atomic<uint32_t> sweepCount{0};
+    std::atomic<bool> running{false};
+    BandScopeStats_t stats = {};
+
+    void storeSample(uint8_t sampleRssi, uint8_t sampleSnr);
+
+public:
+    /**
+     * Konstruktor
+     */
+    BandScope(SI4735 &si4735, Band &band, Config &config) : si4735(si4735), band(band), config(config) {}
+
+    /**
+     * Sweep indítása az aktuális band tartományán (core1)
+     */
+    void start();
+
+    /**
+     * Sweep leállítása és visszahangolás az eredeti frekvenciára (core1)
+     */
+    void stop();
+
+    /**
+     * A sweep következő lépése, soha nem vár (core1)
+     */
+    void service();
+
+    /**
+     * Fut a sweep? (core0-ról is hívható)
+     */
+    bool isRunning() const { return running.load(std::memory_order_acquire); }
+
+    /**
+     * A minták (oszlopok) száma egy sweep-ben (core0-ról is hívható)
+     */
+    uint16_t getPointCount() const { return pointCount.load(std::memory_order_acquire); }
+
+    /**
+     * Az aktuális sweep-ben már kész minták száma (core0-ról is hívható)
+     */
+    uint16_t getSweepPosition() const { return sweepPosition.load(std::memory_order_acquire); }
+
+    /**
+     * Befejezett sweep-ek száma (core0-ról is hívható)
+     */
+    uint32_t getSweepCount() const { return sweepCount.load(std::memory_order_acquire); }
+
+    /**
+     * Egy minta (csak a getSweepPosition() alatti, vagy egy korábbi sweep-ben már kész indexre)
+     */
+    uint8_t getRssi(uint16_t idx) const { return rssi[idx]; }
+    uint8_t getSnr(uint16_t idx) const { return snr[idx]; }
+
+    /**
+     * Az adott minta frekvenciája
+     */
+    uint16_t getFrequency(uint16_t idx) const { return startFrequency + idx * stride; }
+
+    /**
+     * Az eredeti (a sweep előtti) frekvencia
+     */
+    uint16_t getSavedFrequency() const { return savedFrequency; }
+
+    /**
+     * Sweep sebesség (minta/sec) a legutóbbi teljes sweep alapján
+     */
+    uint16_t getPointsPerSec() const { return stats.pointsPerSec; }
+
+    /**
+     * Statisztika
+     */
+    const BandScopeStats_t &getStats() const { return stats; }
+
+    /**
+     * Statisztika kiírása a soros portra
+     */
+    void debugStats() const;
+};
+
+#endif // __BANDSCOPE_H
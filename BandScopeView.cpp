@@ -0,0 +1,122 @@
+#include "BandScopeView.h"
+
+/**
+ * Frekvencia felirat (FM: 10kHz egységben tárolt érték MHz-ben)
+ */
+void BandScopeView::formatFrequency(char *buffer, uint16_t frequency) {
+    if (fmFormat) {
+        sprintf(buffer, "%u.%u", frequency / 100, (frequency % 100) / 10);
+    } else {
+        sprintf(buffer, "%u", frequency);
+    }
+}
+
+/**
+ * Keret, felirat és az eredeti frekvencia jelölése
+ */
+void BandScopeView::drawFrame() {
+
+    points = scope.getPointCount();
+    columnW = max(1, w / max((uint16_t)1, points));
+    memset(drawn, 0, sizeof(drawn));
+    nextColumn = 0;
+    lastSweep = scope.getSweepCount();
+
+    tft.fillRect(x, y, w, h, TFT_BLACK);
+    tft.drawFastHLine(x, y + h - 1, points * columnW, TFT_DARKGREY);
+
+    // Band határok
+    char buffer[12];
+    tft.setFreeFont();
+    tft.setTextSize(1);
+    tft.setTextPadding(0);
+    tft.setTextColor(TFT_WHITE, TFT_BLACK);
+    tft.setTextDatum(TL_DATUM);
+    formatFrequency(buffer, scope.getFrequency(0));
+    tft.drawString(buffer, x, y);
+    tft.setTextDatum(TC_DATUM);
+    formatFrequency(buffer, scope.getFrequency(points - 1));
+    tft.drawString(buffer, x + points * columnW / 2, y); // A jobb sarokban a sebesség van, a felső határ középre kerül
+    drawRate();
+}
+
+/**
+ * A sweep sebesség kiírása a jobb felső sarokba
+ */
+void BandScopeView::drawRate() {
+
+    char buffer[16];
+    tft.setFreeFont();
+    tft.setTextSize(1);
+    tft.setTextColor(TFT_YELLOW, TFT_BLACK);
+    tft.setTextDatum(TR_DATUM);
+    tft.setTextPadding(tft.textWidth("0000 pt/s"));
+    sprintf(buffer, "%u pt/s", scope.getPointsPerSec());
+    tft.drawString(buffer, x + w - 1, y);
+    tft.setTextPadding(0);
+}
+
+/**
+ * Oszlopok kirajzolása [from, to) között, csak a változás
+ */
+void BandScopeView::drawColumns(uint16_t from, uint16_t to) {
+
+    uint16_t barMaxH = h - BAND_SCOPE_LABEL_H - 1;
+    uint16_t bottom = y + h - 1; // Az alapvonal
+    int32_t markerIdx = -1;
+    if (scope.getSavedFrequency() >= scope.getFrequency(0) and points > 1) {
+        markerIdx = (scope.getSavedFrequency() - scope.getFrequency(0)) * (points - 1) / (scope.getFrequency(points - 1) - scope.getFrequency(0));
+    }
+
+    for (uint16_t i = from; i < to and i < points; i++) {
+
+        uint8_t rssi = min(scope.getRssi(i), (uint8_t)BAND_SCOPE_RSSI_FULL_SCALE);
+        uint8_t barH = rssi * barMaxH / BAND_SCOPE_RSSI_FULL_SCALE;
+        if (barH == drawn[i]) {
+            columnsSkipped++;
+            continue;
+        }
+
+        uint16_t colX = x + i * columnW;
+        uint32_t color = i == markerIdx ? BAND_SCOPE_MARKER_COLOR : BAND_SCOPE_BAR_COLOR;
+        if (barH > drawn[i]) {
+            tft.fillRect(colX, bottom - barH, columnW, barH - drawn[i], color);
+        } else {
+            tft.fillRect(colX, bottom - drawn[i], columnW, drawn[i] - barH, TFT_BLACK);
+        }
+        drawn[i] = barH;
+        columnsDrawn++;
+    }
+}
+
+/**
+ * Az új minták kirajzolása
+ */
+void BandScopeView::update() {
+
+    if (scope.getPointCount() == 0) {
+        return;
+    }
+
+    // Első rajzolás, vagy újraindult a sweep más band-en
+    if (points != scope.getPointCount()) {
+        drawFrame();
+    }
+
+    // Előbb a pozíciót olvassuk: az alatta lévő minták már kész vannak
+    uint16_t position = scope.getSweepPosition();
+    uint32_t sweep = scope.getSweepCount();
+
+    // Véget ért egy sweep: az előző maradékát még kirajzoljuk
+    if (sweep != lastSweep) {
+        drawColumns(nextColumn, points);
+        nextColumn = 0;
+        lastSweep = sweep;
+        drawRate();
+    }
+
+    if (position > nextColumn) {
+        drawColumns(nextColumn, position);
+        nextColumn = position;
+    }
+}
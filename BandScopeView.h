@@ -0,0 +1,68 @@
+#ifndef __BANDSCOPEVIEW_H
+#define __BANDSCOPEVIEW_H
+
+#include "BandScope.h"
+#include <TFT_eSPI.h>
+
+#define BAND_SCOPE_RSSI_FULL_SCALE 64  // Ekkora RSSI (dBuV) tölti ki a teljes magasságot
+#define BAND_SCOPE_LABEL_H 10          // A felirat sor magassága a panoráma felett
+#define BAND_SCOPE_BAR_COLOR TFT_GREEN
+#define BAND_SCOPE_MARKER_COLOR TFT_RED // Az eredeti frekvencia jelölése
+
+/**
+ * Band scope panoráma (core0)
+ *
+ * Oszloponként rajzolja a BandScope mintáit, ahogy a core1 elkészül velük.
+ * Az utoljára kirajzolt oszlopmagasságokat megjegyzi: az új sweep-ben csak a megváltozott oszlopokat,
+ * és azokból is csak a különbséget rajzolja újra (nő: a csúcsot rajzoljuk rá, csökken: a felesleget töröljük).
+ */
+class BandScopeView {
+
+private:
+    TFT_eSPI &tft;
+    const BandScope &scope;
+    uint16_t x, y, w, h;
+    bool fmFormat; // A feliratok MHz-ben (FM), vagy kHz-ben
+
+    uint16_t points = 0;    // A kirajzolt panoráma oszlopainak száma (0: még nincs keret)
+    uint8_t columnW = 1;    // Egy oszlop szélessége (pixel)
+    uint16_t nextColumn = 0; // Az aktuális sweep következő kirajzolandó oszlopa
+    uint32_t lastSweep = 0;
+    uint8_t drawn[BAND_SCOPE_MAX_POINTS]; // Az oszlopok kirajzolt magassága
+
+    // Statisztika
+    uint32_t columnsDrawn = 0;
+    uint32_t columnsSkipped = 0;
+
+    void drawFrame();
+    void drawColumns(uint16_t from, uint16_t to);
+    void drawRate();
+    void formatFrequency(char *buffer, uint16_t frequency);
+
+public:
+    /**
+     * Konstruktor
+     * @param x, y, w, h a panoráma helye (a felirat sorral együtt)
+     * @param fmFormat a feliratok MHz-ben (FM band)
+     */
+    BandScopeView(TFT_eSPI &tft, const BandScope &scope, uint16_t x, uint16_t y, uint16_t w, uint16_t h, bool fmFormat)
+        : tft(tft), scope(scope), x(x), y(y), w(w), h(h), fmFormat(fmFormat) {}
+
+    /**
+     * Teljes újrarajzolás (pl.: dialógus után), a következő update() minden oszlopot kirajzol
+     */
+    void invalidate() { points = 0; }
+
+    /**
+     * Az új minták kirajzolása (az ütemező display taskja hívja)
+     */
+    void update();
+
+    /**
+     * Kirajzolt/kihagyott oszlopok
+     */
+    uint32_t getColumnsDrawn() const { return columnsDrawn; }
+    uint32_t getColumnsSkipped() const { return columnsSkipped; }
+};
+
+#endif // __BANDSCOPEVIEW_H
@@ -0,0 +1,104 @@
+#include "BandStore.h"
+#include "Config.h"
+
+static_assert(sizeof(EepromManager<Config_t>) <= BAND_STORE_EEPROM_ADDRESS, "BandStore: a Config_t belelóg a band területbe");
+static_assert(BAND_STORE_EEPROM_ADDRESS + sizeof(BandStoreHeader_t) + BAND_TABLE_SIZE * sizeof(BandStoreRecord_t) <= EEPROM_SIZE,
+              "BandStore: a band terület nem fér el az EEPROM-ban");
+static_assert(sizeof(BandStoreRecord_t) == 10, "BandStoreRecord_t: 10 bájtos rekord");
+
+/**
+ * Az idx. band rekordjának címe
+ */
+static uint16_t recordAddress(uint8_t idx) {
+    return BAND_STORE_EEPROM_ADDRESS + sizeof(BandStoreHeader_t) + idx * sizeof(BandStoreRecord_t);
+}
+
+/**
+ * Egy band állapotának CRC-je
+ */
+static uint16_t stateCrc(const BandState_t &state) {
+    return calcCRC16((uint8_t *)&state, sizeof(BandState_t));
+}
+
+/**
+ * Minden band mentése a következő checkSave()-kor
+ */
+void BandStore::invalidate() {
+    headerValid = false;
+    for (uint8_t i = 0; i < BAND_TABLE_SIZE; i++) {
+        savedCrc[i] = ~stateCrc(band.getBandState(i)); // Biztosan eltér
+    }
+}
+
+/**
+ * Az érvényes rekordok betöltése
+ */
+void BandStore::load() {
+
+    EEPROM.begin(EEPROM_SIZE);
+
+    BandStoreHeader_t header;
+    EEPROM.get(BAND_STORE_EEPROM_ADDRESS, header);
+    if (header.magic != BAND_STORE_MAGIC or header.bandCount != BAND_TABLE_SIZE) {
+        DEBUG("BandStore: nincs érvényes band terület, alapértékek\n");
+        invalidate();
+        return;
+    }
+    headerValid = true;
+
+    uint8_t loaded = 0;
+    for (uint8_t i = 0; i < BAND_TABLE_SIZE; i++) {
+        BandStoreRecord_t record;
+        EEPROM.get(recordAddress(i), record);
+
+        // A CRC mellett a frekvenciának is a band-en belül kell lennie
+        const BandDesc_t &desc = band.getBandDesc(i);
+        if (record.crc != stateCrc(record.state) or record.state.currentFreq < desc.minimumFreq or record.state.currentFreq > desc.maximumFreq) {
+            savedCrc[i] = ~stateCrc(band.getBandState(i));
+            continue;
+        }
+        {
+            Band::StateLock lock(band);
+            band.getBandState(i) = record.state;
+        }
+        savedCrc[i] = record.crc;
+        loaded++;
+    }
+    DEBUG("BandStore: %u/%u band betöltve\n", loaded, BAND_TABLE_SIZE);
+}
+
+/**
+ * A megváltozott band-ek mentése
+ */
+uint8_t BandStore::checkSave() {
+
+    uint8_t written = 0;
+    for (uint8_t i = 0; i < BAND_TABLE_SIZE; i++) {
+
+        // A core1 közben hangolhat: a másolat a zár alatt készül, így nem lehet félkész
+        BandStoreRecord_t record;
+        {
+            Band::StateLock lock(band);
+            record.state = band.getBandState(i);
+        }
+        record.crc = stateCrc(record.state);
+        if (record.crc == savedCrc[i]) {
+            continue;
+        }
+        EEPROM.put(recordAddress(i), record);
+        savedCrc[i] = record.crc;
+        written++;
+    }
+
+    if (!headerValid) {
+        BandStoreHeader_t header = {BAND_STORE_MAGIC, BAND_TABLE_SIZE};
+        EEPROM.put(BAND_STORE_EEPROM_ADDRESS, header);
+        headerValid = true;
+    } else if (written == 0) {
+        return 0;
+    }
+
+    EEPROM.commit();
+    DEBUG("BandStore: %u band mentve\n", written);
+    return written;
+}
@@ -0,0 +1,59 @@
+#ifndef __BANDSTORE_H
+#define __BANDSTORE_H
+
+#include "Band.h"
+#include "EepromManager.h"
+
+#define BAND_STORE_EEPROM_ADDRESS 512 // A band állapotok helye az EEPROM-ban (előtte a Config_t)
+#define BAND_STORE_MAGIC 0xB5         // A terület azonosítója (a rekord formátum változásakor növelni kell)
+
+// A terület fejléce
+struct BandStoreHeader_t {
+    uint8_t magic;
+    uint8_t bandCount; // Ha a Band tábla mérete változott, a tárolt állapotok érvénytelenek
+};
+
+// Egy band tárolt állapota (packed: 10 bájt)
+struct __attribute__((packed, aligned(2))) BandStoreRecord_t {
+    BandState_t state;
+    uint16_t crc; // A state CRC-je
+};
+
+/**
+ * A band-enkénti hangolási állapot (frekvencia, lépésköz, BFO) mentése az EEPROM-ba
+ *
+ * A Config_t-től független, saját területen tárolódik: band-enként egy rekord, saját CRC-vel.
+ * A mentés csak a legutóbbi mentés óta megváltozott band-ek rekordját írja (a CRC-k alapján),
+ * a Config_t-t és a többi band-et nem, és ha nincs változás, commit sincs.
+ */
+class BandStore {
+
+private:
+    Band &band;
+    bool headerValid = false;
+    uint16_t savedCrc[BAND_TABLE_SIZE]; // Az EEPROM-ban lévő rekordok CRC-je
+
+public:
+    /**
+     * Konstruktor
+     */
+    BandStore(Band &band) : band(band) {}
+
+    /**
+     * Az érvényes rekordok betöltése a Band állapotokba (a hibás rekordú band-ek az alapértékkel indulnak)
+     */
+    void load();
+
+    /**
+     * A megváltozott band-ek mentése
+     * @return a kiírt rekordok száma
+     */
+    uint8_t checkSave();
+
+    /**
+     * Minden band mentése a következő checkSave()-kor (pl.: alapértékek visszaállítása után)
+     */
+    void invalidate();
+};
+
+#endif // __BANDSTORE_H
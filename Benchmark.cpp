@@ -0,0 +1,195 @@
+#include "Benchmark.h"
+#include "utils.h"
+
+// A modulációk nevei (a Band.h FM, LSB, USB, AM, CW sorrendjében)
+static const char *MODE_NAMES[] = {"FM", "LSB", "USB", "AM", "CW"};
+
+/**
+ * Mérés indítása
+ */
+bool Benchmark::start() {
+
+    if (state != IDLE or radioService.isSSBLoading()) {
+        return false;
+    }
+
+    originalBandIdx = config.data.bandIdx;
+    stopRequested = false;
+    rowCount = 0;
+    bandIdx = 0;
+    postBandSwitch(bandIdx);
+
+    DEBUG("Benchmark: %d band mérése indul\n", band.getBandCount());
+    return true;
+}
+
+/**
+ * Mérés megszakítása
+ */
+void Benchmark::stop() {
+    // A folyamatban lévő parancs még lefut, utána állunk vissza
+    stopRequested = state == SWITCHING or state == TUNING;
+}
+
+/**
+ * Fázis kezdete
+ */
+void Benchmark::beginPhase() {
+    phaseStartUsec = micros();
+    phaseStartMsec = millis();
+    if (probe) {
+        probe(phaseStartI2cUsec, phaseStartSettleUsec);
+    }
+}
+
+/**
+ * Fázis vége
+ */
+void Benchmark::endPhase(BenchPhase_t &phase) {
+    phase.usec = micros() - phaseStartUsec;
+    phase.i2cUsec = phase.settleUsec = 0;
+    if (probe) {
+        uint32_t i2cUsec, settleUsec;
+        probe(i2cUsec, settleUsec);
+        phase.i2cUsec = i2cUsec - phaseStartI2cUsec;
+        phase.settleUsec = settleUsec - phaseStartSettleUsec;
+    }
+}
+
+/**
+ * Band váltás kérése
+ */
+void Benchmark::postBandSwitch(uint8_t idx) {
+    waitReadyCount = radioService.getBandReadyCount();
+    beginPhase();
+    radioService.postCommand(RadioService::SET_BAND, idx);
+    state = SWITCHING;
+}
+
+/**
+ * A mérés vége: visszaállás az eredeti band-re
+ */
+void Benchmark::finish() {
+    postBandSwitch(originalBandIdx);
+    state = RESTORING;
+}
+
+/**
+ * A mérés következő lépése
+ */
+void Benchmark::step() {
+
+    if (state == IDLE) {
+        return;
+    }
+
+    // Elakadt a rádió? (pl.: betelt a parancs sor)
+    if (millis() - phaseStartMsec > BENCH_STEP_TIMEOUT_MSEC) {
+        DEBUG("Benchmark: időtúllépés a(z) %d. band-nél, leállítva\n", bandIdx);
+
+        // Az eredeti band-et ilyenkor is visszakérjük, de a váltás végét már nem várjuk meg
+        // (ha épp a visszaállás akadt el, nem próbáljuk újra)
+        if (state != RESTORING) {
+            radioService.postCommand(RadioService::SET_BAND, originalBandIdx);
+        }
+        state = IDLE;
+        return;
+    }
+
+    switch (state) {
+
+    case SWITCHING: {
+        if (radioService.getBandReadyCount() == waitReadyCount) {
+            return;
+        }
+
+        if (stopRequested) {
+            finish();
+            return;
+        }
+
+        BenchRow_t &row = rows[rowCount];
+        endPhase(row.bandSwitch);
+        row.bandIdx = bandIdx;
+        row.mode = band.currentMode;
+        row.patchLoaded = band.getSwitchStats().lastLoadedPatch;
+
+        // Teljes képernyő újrarajzolás
+        uint32_t start = micros();
+        drawScreen();
+        row.redrawUsec = micros() - start;
+
+        // Hangolás egy lépéssel felfelé
+        RadioSnapshot_t snapshot;
+        radioService.getSnapshot(snapshot);
+        waitFrequency = snapshot.frequency;
+        beginPhase();
+        radioService.postCommand(RadioService::FREQUENCY_UP);
+        state = TUNING;
+        break;
+    }
+
+    case TUNING: {
+        RadioSnapshot_t snapshot;
+        radioService.getSnapshot(snapshot);
+        if (snapshot.frequency == waitFrequency) {
+            return;
+        }
+
+        BenchRow_t &row = rows[rowCount];
+        endPhase(row.tune);
+
+        uint32_t start = micros();
+        drawFrequency();
+        row.freqDrawUsec = micros() - start;
+
+        rowCount++;
+        bandIdx++;
+        if (!stopRequested and bandIdx < band.getBandCount() and rowCount < BENCH_MAX_ROWS) {
+            postBandSwitch(bandIdx);
+        } else {
+            finish();
+        }
+        break;
+    }
+
+    case RESTORING:
+        if (radioService.getBandReadyCount() == waitReadyCount) {
+            return;
+        }
+        drawScreen();
+        state = IDLE;
+        dumpCsv();
+        break;
+
+    default:
+        break;
+    }
+}
+
+/**
+ * Az eredmények kiírása a soros portra CSV formátumban
+ * Mérő szonda nélkül az I2C és a várakozás oszlopok üresek
+ */
+void Benchmark::dumpCsv() {
+
+    Serial.printf("band,name,mode,patch,switch_usec,switch_i2c_usec,switch_settle_usec,redraw_usec,tune_usec,tune_i2c_usec,tune_settle_usec,freqdraw_usec\n");
+
+    for (uint8_t i = 0; i < rowCount; i++) {
+        const BenchRow_t &row = rows[i];
+        Serial.printf("%u,%s,%s,%u,%lu,", row.bandIdx, band.getBandDesc(row.bandIdx).bandName,
+                      row.mode < ARRAY_ITEM_COUNT(MODE_NAMES) ? MODE_NAMES[row.mode] : "-", row.patchLoaded, row.bandSwitch.usec);
+        if (probe) {
+            Serial.printf("%lu,%lu,", row.bandSwitch.i2cUsec, row.bandSwitch.settleUsec);
+        } else {
+            Serial.printf(",,");
+        }
+        Serial.printf("%lu,%lu,", row.redrawUsec, row.tune.usec);
+        if (probe) {
+            Serial.printf("%lu,%lu,", row.tune.i2cUsec, row.tune.settleUsec);
+        } else {
+            Serial.printf(",,");
+        }
+        Serial.printf("%lu\n", row.freqDrawUsec);
+    }
+}
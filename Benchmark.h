@@ -0,0 +1,133 @@
+#ifndef __BENCHMARK_H
+#define __BENCHMARK_H
+
+#include "Band.h"
+#include "RadioService.h"
+#include <functional>
+
+#define BENCH_MAX_ROWS 32               // A mérési sorok max. száma (a Band tábla mérete)
+#define BENCH_STEP_TIMEOUT_MSEC 15000   // Egy lépés (band váltás SSB patch betöltéssel, hangolás) max. ideje
+
+// Egy mért fázis
+struct BenchPhase_t {
+    uint32_t usec;       // Teljes idő (a parancs elküldésétől a befejezéséig)
+    uint32_t i2cUsec;    // Ebből I2C buszidő (csak mérő szondával)
+    uint32_t settleUsec; // Ebből a chip várakozása (csak mérő szondával)
+};
+
+// Egy band mérési eredménye
+struct BenchRow_t {
+    uint8_t bandIdx;
+    uint8_t mode;
+    bool patchLoaded;      // A váltás töltött SSB patch-et?
+    BenchPhase_t bandSwitch; // SET_BAND -> a band kész (core1)
+    uint32_t redrawUsec;   // Teljes képernyő újrarajzolás (core0)
+    BenchPhase_t tune;     // FREQUENCY_UP -> az új frekvencia publikálva (core1)
+    uint32_t freqDrawUsec; // A frekvencia kijelzés frissítése (core0)
+};
+
+/**
+ * Band váltás és hangolás késleltetés mérő
+ *
+ * Sorban végigváltja a Band tábla összes elemét (a sáv alapértelmezett módjában), majd mindegyikben egyet hangol felfelé.
+ * Fázisonként méri a band váltást, a képernyő újrarajzolást, a hangolást és a frekvencia kijelzés frissítését.
+ * A végén visszaáll az eredeti band-re, és az eredményt CSV-ként kiírja a soros portra.
+ *
+ * A core0-n fut (az ütemező egy taskja hívja a step()-et), a rádió parancsokat a RadioService-en keresztül küldi,
+ * így a mérés a valós (core0 -> core1 -> core0) késleltetést adja.
+ * Az I2C és a chip várakozás szétválasztásához mérő szonda kell (a host szimulációban az időhű mock adja),
+ * szonda nélkül ezek az oszlopok üresek.
+ */
+class Benchmark {
+
+public:
+    // Rajzoló callback (a képernyő a sketch-ben él)
+    typedef std::function<void()> DrawCallback_t;
+
+    // Mérő szonda: az eddig összesen eltelt I2C buszidő és chip várakozás (usec)
+    typedef void (*PhaseProbe_t)(uint32_t &i2cUsec, uint32_t &settleUsec);
+
+private:
+    enum State : uint8_t {
+        IDLE = 0,  // Nem fut
+        SWITCHING, // Band váltásra várunk
+        TUNING,    // Hangolásra várunk
+        RESTORING  // Az eredeti band visszaállítására várunk
+    };
+
+    RadioService &radioService;
+    Band &band;
+    Config &config;
+    DrawCallback_t drawScreen;
+    DrawCallback_t drawFrequency;
+    PhaseProbe_t probe = nullptr;
+
+    State state = IDLE;
+    bool stopRequested = false;
+    uint8_t bandIdx = 0;
+    uint8_t originalBandIdx = 0;
+
+    // Az aktuális fázis kezdete
+    uint32_t phaseStartUsec = 0;
+    uint32_t phaseStartMsec = 0;
+    uint32_t phaseStartI2cUsec = 0;
+    uint32_t phaseStartSettleUsec = 0;
+    uint32_t waitReadyCount = 0;  // Band váltásnál: a RadioService befejezett váltásainak száma a kezdéskor
+    uint16_t waitFrequency = 0;   // Hangolásnál: a frekvencia a kezdéskor
+
+    BenchRow_t rows[BENCH_MAX_ROWS];
+    uint8_t rowCount = 0;
+
+    void beginPhase();
+    void endPhase(BenchPhase_t &phase);
+    void postBandSwitch(uint8_t idx);
+    void finish();
+
+public:
+    /**
+     * Konstruktor
+     * @param drawScreen a teljes képernyő kirajzolása
+     * @param drawFrequency a frekvencia kijelzés frissítése
+     */
+    Benchmark(RadioService &radioService, Band &band, Config &config, DrawCallback_t drawScreen, DrawCallback_t drawFrequency)
+        : radioService(radioService), band(band), config(config), drawScreen(drawScreen), drawFrequency(drawFrequency) {}
+
+    /**
+     * Mérő szonda beállítása (nullptr: nincs)
+     */
+    void setProbe(PhaseProbe_t probe) { this->probe = probe; }
+
+    /**
+     * Mérés indítása
+     * @return false, ha már fut, vagy SSB patch betöltés van folyamatban
+     */
+    bool start();
+
+    /**
+     * Mérés megszakítása (az eredeti band-et visszaállítjuk)
+     */
+    void stop();
+
+    /**
+     * Fut a mérés?
+     */
+    bool isRunning() const { return state != IDLE; }
+
+    /**
+     * A mérés következő lépése (core0, az ütemező hívja)
+     */
+    void step();
+
+    /**
+     * Eredmények
+     */
+    uint8_t getRowCount() const { return rowCount; }
+    const BenchRow_t &getRow(uint8_t idx) const { return rows[idx]; }
+
+    /**
+     * Az eredmények kiírása a soros portra CSV formátumban
+     */
+    void dumpCsv();
+};
+
+#endif // __BENCHMARK_H
@@ -2,6 +2,8 @@
 #define __DISPLAYBASE_H
 
 #include "Band.h"
+#include "LoopProfiler.h"
+#include "RadioService.h"
 #include "RotaryEncoder.h"
 #include <Arduino.h>
 #include <TFT_eSPI.h> // TFT_eSPI könyvtár
@@ -22,11 +24,16 @@
 
 #define SCREEN_COMPS_REFRESH_TIME_MSEC 500 // Változó adatok frissítési ciklusideje
 
+// SSB patch betöltés folyamatjelző (a képernyő közepén)
+#define SSB_PROGRESS_W 300
+#define SSB_PROGRESS_H 60
+#define SSB_PROGRESS_BAR_H 16
+
 class DisplayBase {
 
 protected:
     TFT_eSPI &tft;
-    SI4735 &si4735;
+    RadioService &radioService; // A chipet a core1 kezeli, mi csak a pillanatképét olvassuk és parancsokat küldünk
     Band &band;
     Config &config;
 
@@ -41,6 +48,8 @@ protected:
     };
     ButtonInfo_t lastButton; // Az utolsó megnyomott gomb adatai
 
+    uint8_t lastSsbLoadProgress = RADIO_SSB_LOAD_IDLE; // A legutóbb kirajzolt SSB patch betöltés állapot
+
     /**
      * Lenyomott gomb info törlése
      */
@@ -82,8 +91,8 @@ public:
     /**
      *
      */
-    DisplayBase(TFT_eSPI &tft, SI4735 &si4735, Band &band, Config &config)
-        : tft(tft), si4735(si4735), band(band), config(config), screenWidth(tft.width()), screenHeight(tft.height()), dialog(nullptr) {
+    DisplayBase(TFT_eSPI &tft, RadioService &radioService, Band &band, Config &config)
+        : tft(tft), radioService(radioService), band(band), config(config), dialog(nullptr), screenWidth(tft.width()), screenHeight(tft.height()) {
         clearLastButton();
     }
 
@@ -102,27 +111,56 @@ public:
     virtual void drawScreen() = 0;
 
     /**
-     * Loop esemény kezelése
+     * Rotary encoder esemény feldolgozása (az ütemező encoder taskja hívja)
      * @param encoderState rotary encoder eredmény
      */
-    void handleLoop(RotaryEncoder::EncoderState encoderState) {
-
-        // Rotary Encoder olvasása
-        if (encoderState.direction != RotaryEncoder::Direction::NONE) {
-            try {
-                handleRotaryEncoder(encoderState);
-            } catch (const std::exception &e) {
-                DEBUG("Hiba a handleRotaryEncoder() függvényben: %s\n", e.what());
-            }
+    void processRotaryEncoder(RotaryEncoder::EncoderState encoderState) {
+        // SSB patch betöltés közben a hangolás tiltva (a chip nem fogadja, a parancsok csak a sort töltenék)
+        if (encoderState.direction == RotaryEncoder::Direction::NONE or radioService.isSSBLoading()) {
+            return;
         }
+        try {
+            handleRotaryEncoder(encoderState);
+        } catch (const std::exception &e) {
+            DEBUG("Hiba a handleRotaryEncoder() függvényben: %s\n", e.what());
+        }
+    }
 
+    /**
+     * Touch olvasása és feldolgozása (az ütemező touch taskja hívja)
+     */
+    void processTouch() {
         uint16_t tx, ty;
-        bool touched = tft.getTouch(&tx, &ty, 40); // A treshold értékét megnöveljük a default 20msec-ről 40-re
+        bool touched;
+        {
+            PROFILE_STAGE(STAGE_TOUCH_READ);
+            touched = tft.getTouch(&tx, &ty, 40); // A treshold értékét megnöveljük a default 20msec-ről 40-re
+        }
         try {
             handleTouch(touched, tx, ty);
         } catch (const std::exception &e) {
             DEBUG("Hiba a handleTouch() függvényben: %s\n", e.what());
         }
+    }
+
+    /**
+     * Loop esemény feldolgozása (az ütemező display taskja hívja)
+     */
+    void processLoop() {
+
+        // SSB patch betöltés folyamatjelző, a végén a teljes képernyőt újrarajzoljuk
+        uint8_t ssbLoadProgress = radioService.getSSBLoadProgress();
+        if (ssbLoadProgress != lastSsbLoadProgress) {
+            if (ssbLoadProgress == RADIO_SSB_LOAD_IDLE) {
+                drawScreen();
+                if (dialog) {
+                    dialog->drawDialog();
+                }
+            } else {
+                drawSSBLoadProgress(ssbLoadProgress);
+            }
+            lastSsbLoadProgress = ssbLoadProgress;
+        }
 
         try {
             handleLoop();
@@ -131,7 +169,50 @@ public:
         }
     }
 
+    /**
+     * Jelminőség adatok (S-Meter, mono/sztereo, stb.) frissítése (az ütemező S-Meter taskja hívja)
+     * Nem minden képernyőnek van ilyen, ezért nem kötelező implementálni
+     */
+    virtual void refreshSignalValues() {}
+
+    /**
+     * RDS adatok frissítése (az ütemező RDS taskja hívja)
+     * Nem minden képernyőnek van ilyen, ezért nem kötelező implementálni
+     */
+    virtual void refreshRdsValues() {}
+
+    /**
+     * A frekvencia kijelzés azonnali újrarajzolása (pl.: a benchmark méri)
+     * Nem minden képernyőnek van ilyen, ezért nem kötelező implementálni
+     */
+    virtual void drawFrequency() {}
+
 protected:
+    /**
+     * SSB patch betöltés folyamatjelző kirajzolása (a keretet csak az első híváskor)
+     * @param percent betöltöttség (0-100%)
+     */
+    void drawSSBLoadProgress(uint8_t percent) {
+        uint16_t x = (screenWidth - SSB_PROGRESS_W) / 2;
+        uint16_t y = (screenHeight - SSB_PROGRESS_H) / 2;
+
+        if (lastSsbLoadProgress == RADIO_SSB_LOAD_IDLE) {
+            tft.fillRect(x, y, SSB_PROGRESS_W, SSB_PROGRESS_H, TFT_BLACK);
+            tft.drawRect(x, y, SSB_PROGRESS_W, SSB_PROGRESS_H, TFT_WHITE);
+            tft.setFreeFont();
+            tft.setTextFont(2);
+            tft.setTextSize(1);
+            tft.setTextColor(TFT_WHITE, TFT_BLACK);
+            tft.setTextDatum(TC_DATUM);
+            tft.drawString("Loading SSB patch...", x + SSB_PROGRESS_W / 2, y + 8);
+        }
+
+        uint16_t barW = SSB_PROGRESS_W - 20;
+        uint16_t filled = barW * percent / 100;
+        tft.fillRect(x + 10, y + 34, filled, SSB_PROGRESS_BAR_H, TFT_GREEN);
+        tft.fillRect(x + 10 + filled, y + 34, barW - filled, SSB_PROGRESS_BAR_H, TFT_DARKGREY);
+    }
+
     // A Screen gombok automatikus elhelyezéséhez használjuk
     uint16_t screenWidth;
     uint16_t screenHeight;
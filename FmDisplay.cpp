@@ -1,16 +1,14 @@
 #include "FmDisplay.h"
 
-#include "InputDialog.h"
-
 // Gombok száma
 #define FM_SCRN_BTNS_CNT 12
 
 /**
  * Konstruktor
  */
-FmDisplay::FmDisplay(TFT_eSPI &tft, SI4735 &si4735, Band &band, Config &config, uint16_t freqDispX, uint16_t freqDispY)
-    : DisplayBase(tft, si4735, band, config), freqDispX(freqDispX), freqDispY(freqDispY),
-      screenButtons(nullptr), pSMeter(nullptr), pRds(nullptr), pFreqDisplay(nullptr) {
+FmDisplay::FmDisplay(TFT_eSPI &tft, RadioService &radioService, Band &band, Config &config, uint16_t freqDispX, uint16_t freqDispY)
+    : DisplayBase(tft, radioService, band, config), freqDispX(freqDispX), freqDispY(freqDispY),
+      screenButtons(nullptr), pSMeter(nullptr), pRds(nullptr), pFreqDisplay(nullptr), pScopeView(nullptr) {
 
     // Dinamikusan létrehozzuk a gombokat
 
@@ -22,9 +20,9 @@ FmDisplay::FmDisplay(TFT_eSPI &tft, SI4735 &si4735, Band &band, Config &config,
     screenButtons[2] = TftButton(id++, tft, getAutoX(2), getAutoY(2, FM_SCRN_BTNS_CNT), SCRN_BTN_W, SCRN_BTN_H, "Input", ButtonType::PUSHABLE, SCRN_BTN_CB(FmDisplay, buttonCallback, this));
     screenButtons[3] = TftButton(id++, tft, getAutoX(3), getAutoY(3, FM_SCRN_BTNS_CNT), SCRN_BTN_W, SCRN_BTN_H, "Sw-2", ButtonType::TOGGLE, SCRN_BTN_CB(FmDisplay, buttonCallback, this));
     screenButtons[4] = TftButton(id++, tft, getAutoX(4), getAutoY(4, FM_SCRN_BTNS_CNT), SCRN_BTN_W, SCRN_BTN_H, "Dis", ButtonType::TOGGLE, SCRN_BTN_CB(FmDisplay, buttonCallback, this));
-    screenButtons[5] = TftButton(id++, tft, getAutoX(5), getAutoY(5, FM_SCRN_BTNS_CNT), SCRN_BTN_W, SCRN_BTN_H, "Btn-5", ButtonType::TOGGLE, SCRN_BTN_CB(FmDisplay, buttonCallback, this));
+    screenButtons[5] = TftButton(id++, tft, getAutoX(5), getAutoY(5, FM_SCRN_BTNS_CNT), SCRN_BTN_W, SCRN_BTN_H, "Scope", ButtonType::TOGGLE, SCRN_BTN_CB(FmDisplay, buttonCallback, this));
 
-    screenButtons[6] = TftButton(id++, tft, getAutoX(6), getAutoY(6, FM_SCRN_BTNS_CNT), SCRN_BTN_W, SCRN_BTN_H, "Btn-6", ButtonType::TOGGLE, SCRN_BTN_CB(FmDisplay, buttonCallback, this));
+    screenButtons[6] = TftButton(id++, tft, getAutoX(6), getAutoY(6, FM_SCRN_BTNS_CNT), SCRN_BTN_W, SCRN_BTN_H, "Scan", ButtonType::TOGGLE, SCRN_BTN_CB(FmDisplay, buttonCallback, this));
     screenButtons[7] = TftButton(id++, tft, getAutoX(7), getAutoY(7, FM_SCRN_BTNS_CNT), SCRN_BTN_W, SCRN_BTN_H, "Btn-7", ButtonType::TOGGLE, SCRN_BTN_CB(FmDisplay, buttonCallback, this));
     screenButtons[8] = TftButton(id++, tft, getAutoX(8), getAutoY(8, FM_SCRN_BTNS_CNT), SCRN_BTN_W, SCRN_BTN_H, "Btn-8", ButtonType::TOGGLE, SCRN_BTN_CB(FmDisplay, buttonCallback, this));
     screenButtons[9] = TftButton(id++, tft, getAutoX(9), getAutoY(9, FM_SCRN_BTNS_CNT), SCRN_BTN_W, SCRN_BTN_H, "Btn-9", ButtonType::TOGGLE, SCRN_BTN_CB(FmDisplay, buttonCallback, this));
@@ -35,7 +33,7 @@ FmDisplay::FmDisplay(TFT_eSPI &tft, SI4735 &si4735, Band &band, Config &config,
     pSMeter = new SMeter(tft, 0, 80);
 
     // RDS példányosítása
-    pRds = new RDS(tft, si4735,
+    pRds = new RDS(tft, radioService,
                    80, 62, // Station x,y
                    0, 80,  // Message x,y
                    2, 42,  // Time x,y
@@ -69,6 +67,10 @@ FmDisplay::~FmDisplay() {
     if (pFreqDisplay) {
         delete pFreqDisplay;
     }
+
+    // Band scope és állomás keresés leállítása
+    stopScope();
+    stopScan();
 }
 
 /**
@@ -84,20 +86,26 @@ void FmDisplay::drawScreen() {
     // RSI skála kirajzoltatása
     pSMeter->drawSmeterScale();
 
-    // RSSI aktuális érték
-    si4735.getCurrentReceivedSignalQuality();
-    uint8_t rssi = si4735.getCurrentRSSI();
-    uint8_t snr = si4735.getCurrentSNR();
-    pSMeter->showRSSI(rssi, snr, band.currentMode == FM);
-
-    // RDS (erőből a 'valamilyen' adatok megjelenítése)
-    pRds->displayRds(true);
+    // RSSI aktuális érték (ami éppen van, ha régi, akkor a következő frissítés pótolja)
+    SignalQuality_t signal;
+    radioService.getSignalQuality(signal, FM_SIGNAL_MAX_AGE_MSEC);
+    lastSnr = signal.snr;
+    pSMeter->showRSSI(signal.rssi, lastSnr, band.currentMode == FM);
+
+    // RDS (erőből a 'valamilyen' adatok megjelenítése), band scope alatt a panoráma van a helyén
+    if (pScopeView) {
+        pScopeView->invalidate();
+    } else if (scanMode) {
+        drawStationInfo();
+    } else {
+        pRds->displayRds(true);
+    }
 
     // Mono/Stereo aktuális érték
-    this->showMonoStereo(si4735.getCurrentPilot());
+    this->showMonoStereo(signal.pilot);
 
     // Frekvencia
-    float currFreq = band.getBandByIdx(config.data.bandIdx).currentFreq; // A Rotary változtatásakor már eltettük a Band táblába
+    float currFreq = band.getBandState(config.data.bandIdx).currentFreq; // A Rotary változtatásakor már eltettük a Band táblába
     pFreqDisplay->FreqDraw(currFreq, 0);
 
     // Megjelenítjük a képernyő gombokat
@@ -141,9 +149,28 @@ void FmDisplay::handleScreenButtonPress() {
         dialog = new MultiButtonDialog(tft, 400, 260, F("Valasszon opciot!"), buttonLabels, buttonsCount, SCRN_BTN_CB(FmDisplay, buttonCallback, this));
         dialog->drawDialog();
 
+    } else if (isButton("Scope")) {
+
+        if (lastButton.state == ButtonState_t::ON) {
+            startScope();
+        } else {
+            stopScope();
+            drawScreen();
+        }
+
+    } else if (isButton("Scan")) {
+
+        if (lastButton.state == ButtonState_t::ON) {
+            startScan();
+        } else {
+            stopScan();
+            drawScreen();
+        }
+
     } else if (isButton("Input")) {
 
-        dialog = new InputDialog(tft, 400, 260, F("Frequency"));
+        pFreqInput = new InputDialog(tft, 400, 260, F("Frequency (kHz or MHz)"), SCRN_BTN_CB(FmDisplay, buttonCallback, this));
+        dialog = pFreqInput;
         dialog->drawDialog();
 
     } else {
@@ -157,16 +184,35 @@ void FmDisplay::handleScreenButtonPress() {
  */
 void FmDisplay::handleRotaryEncoder(RotaryEncoder::EncoderState encoderState) {
 
-    switch (encoderState.direction) {
-    case RotaryEncoder::Direction::UP:
-        si4735.frequencyUp();
-        break;
-    case RotaryEncoder::Direction::DOWN:
-        si4735.frequencyDown();
-        break;
+    // Állomás lista módban a megtalált állomások között lépünk (jelerősség szerint), keresés közben nem hangolunk
+    if (scanMode) {
+        const StationScanner &scanner = radioService.getStationScanner();
+        uint8_t count = scanner.getCount();
+        if (scanner.isRunning() or count == 0) {
+            return;
+        }
+        if (encoderState.direction == RotaryEncoder::Direction::UP) {
+            stationIdx = (stationIdx + 1) % count;
+        } else {
+            stationIdx = stationIdx == 0 ? count - 1 : stationIdx - 1;
+        }
+        radioService.postCommand(RadioService::SET_FREQUENCY, scanner.getEntry(stationIdx).frequency);
+        pRds->clearRds();
+        drawStationInfo();
+        return;
     }
 
-    band.getBandByIdx(config.data.bandIdx).currentFreq = si4735.getFrequency();
+    // Hangoláskor a sweep leáll (a core1 is leállítaná, de a panorámát nekünk kell eltüntetni)
+    if (pScopeView) {
+        stopScope();
+        screenButtons[5].setState(ButtonState_t::OFF);
+        drawScreen();
+    }
+
+    // A hangolást a core1 végzi, a Band táblába is ő teszi el az új frekvenciát
+    // A lépésszámban benne van a gyorsítás, a még végre nem hajtott lépéseket a core1 egyetlen hangolássá vonja össze
+    radioService.postCommand(RadioService::TUNE_STEPS, encoderState.value);
+
     pRds->clearRds();
 }
 
@@ -202,11 +248,24 @@ void FmDisplay::handleTouch(bool touched, uint16_t tx, uint16_t ty) {
             if (lastButton.id == PopupBase::DIALOG_CLOSE_BUTTON_ID) {
                 delete dialog;
                 dialog = nullptr;
+                pFreqInput = nullptr;
                 clearLastButton();
                 drawScreen();
                 return;
             }
 
+            // Frekvencia bevitel: egyetlen keresés a band indexben, a core1 szükség esetén band-et is vált
+            if (pFreqInput and lastButton.id == PopupBase::DIALOG_OK_BUTTON_ID) {
+                uint32_t kHz = parseFrequencyKHz(pFreqInput->getText().c_str());
+                if (band.findBandByKHz(kHz) < 0) {
+                    Beeper::error();
+                    clearLastButton();
+                    return; // Hibás frekvencia: a dialóg nyitva marad
+                }
+                radioService.postCommand(RadioService::TUNE_KHZ, kHz);
+                pFreqInput = nullptr;
+            }
+
             // Csak teszt -> töröljük a dialógot
             delete dialog;
             dialog = nullptr;
@@ -217,6 +276,100 @@ void FmDisplay::handleTouch(bool touched, uint16_t tx, uint16_t ty) {
     }
 }
 
+/**
+ * Band scope indítása az aktuális band-en
+ */
+void FmDisplay::startScope() {
+    if (pScopeView or !radioService.postCommand(RadioService::SCOPE_START)) {
+        return;
+    }
+    if (scanMode) {
+        stopScan();
+        screenButtons[6].setState(ButtonState_t::OFF);
+    }
+    pRds->clearRds();
+    pScopeView = new BandScopeView(tft, radioService.getBandScope(), 0, FM_SCOPE_Y, tft.width(), FM_SCOPE_H, band.currentMode == FM);
+}
+
+/**
+ * Band scope leállítása (a core1 visszahangol az eredeti frekvenciára)
+ */
+void FmDisplay::stopScope() {
+    if (!pScopeView) {
+        return;
+    }
+    radioService.postCommand(RadioService::SCOPE_STOP);
+    delete pScopeView;
+    pScopeView = nullptr;
+}
+
+/**
+ * Állomás keresés indítása (a végén lista mód)
+ */
+void FmDisplay::startScan() {
+    if (scanMode or !radioService.postCommand(RadioService::SCAN_START)) {
+        return;
+    }
+    if (pScopeView) {
+        stopScope();
+        screenButtons[5].setState(ButtonState_t::OFF);
+    }
+    scanMode = true;
+    stationIdx = 0;
+    lastStationCount = UINT8_MAX;
+    pRds->clearRds();
+}
+
+/**
+ * Lista mód vége (ha még keres, megszakítjuk: a core1 visszahangol az eredeti frekvenciára)
+ */
+void FmDisplay::stopScan() {
+    if (!scanMode) {
+        return;
+    }
+    if (radioService.getStationScanner().isRunning()) {
+        radioService.postCommand(RadioService::SCAN_STOP);
+    }
+    scanMode = false;
+}
+
+/**
+ * Az állomás lista sor (keresés közben a talált állomások száma)
+ */
+void FmDisplay::drawStationInfo() {
+
+    const StationScanner &scanner = radioService.getStationScanner();
+    bool running = scanner.isRunning();
+    uint8_t count = scanner.getCount();
+    lastStationCount = count + running;
+    lastScanRefused = scanner.isRefused();
+
+    char buffer[48];
+    if (running) {
+        sprintf(buffer, "Scanning... %u found", count);
+    } else if (lastScanRefused) {
+        sprintf(buffer, "No scan in SSB mode");
+    } else if (count == 0) {
+        sprintf(buffer, "No stations");
+    } else {
+        const StationEntry_t &entry = scanner.getEntry(stationIdx);
+        if (band.currentMode == FM) {
+            sprintf(buffer, "%u/%u  %u.%02u MHz  %.8s  %udBuV", stationIdx + 1, count, entry.frequency / 100, entry.frequency % 100, entry.ps, entry.rssi);
+        } else {
+            sprintf(buffer, "%u/%u  %u kHz  %udBuV", stationIdx + 1, count, entry.frequency, entry.rssi);
+        }
+    }
+
+    tft.setFreeFont();
+    tft.setTextSize(1);
+    tft.setTextFont(2);
+    tft.setTextColor(TFT_YELLOW, TFT_BLACK);
+    tft.setTextDatum(TL_DATUM);
+    tft.setTextPadding(tft.width());
+    tft.drawString(buffer, 0, FM_SCOPE_Y);
+    tft.setTextPadding(0);
+}
+
 /**
  * Mono/Stereo vétel megjelenítése
  */
@@ -238,53 +391,85 @@ void FmDisplay::showMonoStereo(bool stereo) {
 }
 
 /**
- * Adatok periódikus megjelenítése
+ * Jelminőség adatok (S-Meter, mono/sztereo) megjelenítése
+ * Az ütemező a saját periódusidejével hívja
  */
-void FmDisplay::displayValues() {
-
-    // Néhány adatot csak ritkábban frissítünk
-    static long elapsedTimedValues = 0; // Kezdőérték nulla
-    if ((millis() - elapsedTimedValues) >= SCREEN_COMPS_REFRESH_TIME_MSEC) {
-
-        // RSSI
-        si4735.getCurrentReceivedSignalQuality();
-        uint8_t rssi = si4735.getCurrentRSSI();
-        uint8_t snr = si4735.getCurrentSNR();
-        pSMeter->showRSSI(rssi, snr, band.currentMode == FM);
-
-        // RDS
-        pRds->showRDS(snr);
-
-        // Mono/Stereo
-        static bool prevStereo = false;
-        bool stereo = si4735.getCurrentPilot();
-        // Ha változott, akkor frissítünk
-        if (stereo != prevStereo) {
-            this->showMonoStereo(stereo);
-            prevStereo = stereo; // Frissítsük az előző értéket
-        }
+void FmDisplay::refreshSignalValues() {
 
-        // Frissítjük az időbélyeget
-        elapsedTimedValues = millis();
+    // Ha van dialóg, akkor nem rajzolunk alá
+    if (dialog) {
+        return;
     }
 
-    // A Freqkvenciát azonnal frisítjuk, de csak ha változott
-    static float lastFreq = 0;
-    float currFreq = band.getBandByIdx(config.data.bandIdx).currentFreq; // A Rotary változtatásakor már eltettük a Band táblába
-    if (lastFreq != currFreq) {
-        pFreqDisplay->FreqDraw(currFreq, 0);
-        lastFreq = currFreq;
+    // RSSI (a jelminőség cache-ből, a core1 csak akkor kérdezi a chipet, ha túl régi az adat)
+    SignalQuality_t signal;
+    radioService.getSignalQuality(signal, FM_SIGNAL_MAX_AGE_MSEC);
+    lastSnr = signal.snr;
+    pSMeter->showRSSI(signal.rssi, lastSnr, band.currentMode == FM);
+
+    // Mono/Stereo
+    static bool prevStereo = false;
+    bool stereo = signal.pilot;
+    // Ha változott, akkor frissítünk
+    if (stereo != prevStereo) {
+        this->showMonoStereo(stereo);
+        prevStereo = stereo; // Frissítsük az előző értéket
+    }
+}
+
+/**
+ * RDS adatok megjelenítése
+ * Az ütemező a saját periódusidejével hívja, a legutóbb mért SNR alapján döntünk
+ */
+void FmDisplay::refreshRdsValues() {
+
+    // Ha van dialóg, akkor nem rajzolunk alá
+    if (dialog) {
+        return;
+    }
+
+    // Sweep és keresés közben nincs RDS (a chip végigjárja a band-et), lista módban az állomás sor van a helyén
+    if (pScopeView or scanMode) {
+        return;
     }
+
+    pRds->showRDS(lastSnr);
 }
 
 /**
  * Loop esemény kezelése
- * Változó Adatok (mono/sztereo, RDS, rssi) időzített megjelenítése
+ * A frekvenciát azonnal frissítjük, de csak ha változott
  */
 void FmDisplay::handleLoop() {
 
-    // Ha nincs dialóg, akkor megjeleníthetjük az értékeket
-    if (!dialog) {
-        displayValues();
+    // Ha van dialóg, akkor nem rajzolunk alá
+    if (dialog) {
+        return;
+    }
+
+    if (pScopeView) {
+        pScopeView->update();
     }
+
+    // Keresés közben az állomás szám, a végén az első (legerősebb) állomás
+    const StationScanner &scanner = radioService.getStationScanner();
+    if (scanMode and (lastStationCount != scanner.getCount() + scanner.isRunning() or lastScanRefused != scanner.isRefused())) {
+        drawStationInfo();
+    }
+
+    static float lastFreq = 0;
+    float currFreq = band.getBandState(config.data.bandIdx).currentFreq; // A Rotary változtatásakor már eltettük a Band táblába
+    if (lastFreq != currFreq) {
+        PROFILE_STAGE(STAGE_FREQ_DRAW);
+        pFreqDisplay->FreqDraw(currFreq, 0);
+        lastFreq = currFreq;
+    }
+}
+
+/**
+ * A frekvencia kijelzés azonnali újrarajzolása
+ */
+void FmDisplay::drawFrequency() {
+    PROFILE_STAGE(STAGE_FREQ_DRAW);
+    pFreqDisplay->FreqDraw(band.getBandState(config.data.bandIdx).currentFreq, 0);
 }
@@ -1,11 +1,19 @@
 #ifndef __FMDISPLAY_H
 #define __FMDISPLAY_H
 
+#include "BandScopeView.h"
 #include "DisplayBase.h"
 #include "FrequDisplay.h"
+#include "InputDialog.h"
 #include "Rds.h"
 #include "SMeter.h"
 
+#define FM_SIGNAL_MAX_AGE_MSEC 300 // Az S-Meter/mono-sztereo kijelzéshez elfogadott legrégebbi jelminőség adat
+
+// Band scope panoráma helye (az RDS helyén, a gombok felett)
+#define FM_SCOPE_Y 150
+#define FM_SCOPE_H 95
+
 class FmDisplay : public DisplayBase {
 
 private:
@@ -13,13 +21,24 @@ private:
     void handleScreenButtonPress();
 
     void showMonoStereo(bool stereo);
-    void displayValues();
+    void startScope();
+    void stopScope();
+    void startScan();
+    void stopScan();
+    void drawStationInfo();
 
     uint16_t freqDispX, freqDispY;
     TftButton *screenButtons; // Dinamikusan létrehozott gombok tömbje
     SMeter *pSMeter;
     RDS *pRds;
     FreqDisplay *pFreqDisplay;
+    BandScopeView *pScopeView; // Band scope panoráma (csak amíg a sweep fut)
+    bool scanMode = false;     // Állomás lista mód: az encoder a megtalált állomások között lép
+    uint8_t stationIdx = 0;    // Az aktuális állomás a listában
+    uint8_t lastStationCount = 0; // A kirajzolt állomás szám (keresés közben)
+    bool lastScanRefused = false; // A kirajzolt sor az elutasított keresést mutatja
+    uint8_t lastSnr = 0; // A legutóbb mért SNR, az RDS megjelenítés ez alapján dönt
+    InputDialog *pFreqInput = nullptr; // A nyitott frekvencia beviteli dialóg (a dialog-gal együtt törlődik)
 
 protected:
     /**
@@ -42,9 +61,24 @@ protected:
     void handleLoop() override;
 
 public:
-    FmDisplay(TFT_eSPI &tft, SI4735 &si4735, Band &band, Config &config, uint16_t freqDispX, uint16_t freqDispY);
+    FmDisplay(TFT_eSPI &tft, RadioService &radioService, Band &band, Config &config, uint16_t freqDispX, uint16_t freqDispY);
     virtual ~FmDisplay();
     void drawScreen() override;
+
+    /**
+     * Jelminőség adatok (S-Meter, mono/sztereo) frissítése
+     */
+    void refreshSignalValues() override;
+
+    /**
+     * RDS adatok frissítése
+     */
+    void refreshRdsValues() override;
+
+    /**
+     * A frekvencia kijelzés azonnali újrarajzolása
+     */
+    void drawFrequency() override;
 };
 
 #endif
\ No newline at end of file
@@ -89,7 +89,7 @@ void FreqDisplay::FreqDraw(float freq, int d) {
 
     } else {
         // AM vagy LW?
-        uint8_t bandType = band.getBandByIdx(config.data.bandIdx).bandType;
+        uint8_t bandType = band.getBandDesc(config.data.bandIdx).bandType;
         if (bandType == MW_BAND_TYPE or bandType == LW_BAND_TYPE) {
             displayFreq = freq;
             Segment(String(displayFreq, 0), "1888", d);
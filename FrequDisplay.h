@@ -18,7 +18,7 @@ private:
 
 public:
     FreqDisplay(TFT_eSPI &tft, Band &band, Config &config, uint16_t freqDispX, uint16_t freqDispY)
-        : tft(tft), band(band), config(config), freqDispX(freqDispX), freqDispY(freqDispY), spr(&tft) {
+        : tft(tft), spr(&tft), band(band), config(config), freqDispX(freqDispX), freqDispY(freqDispY) {
     }
 
     void FreqDraw(float freq, int d);
@@ -0,0 +1,39 @@
+#include "I2cClockStore.h"
+#include "BandStore.h"
+
+static_assert(BAND_STORE_EEPROM_ADDRESS + sizeof(BandStoreHeader_t) + BAND_TABLE_SIZE * sizeof(BandStoreRecord_t) <= I2C_CLOCK_STORE_EEPROM_ADDRESS,
+              "I2cClockStore: a band terület belelóg az I2C órajel rekordjába");
+static_assert(I2C_CLOCK_STORE_EEPROM_ADDRESS + sizeof(EepromManager<uint32_t>) <= EEPROM_SIZE, "I2cClockStore: a rekord nem fér el az EEPROM-ban");
+
+/**
+ * A tárolt órajel betöltése
+ */
+void I2cClockStore::load() {
+
+    EEPROM.begin(EEPROM_SIZE);
+
+    uint32_t hz = I2C_CLOCK_UNCALIBRATED;
+    recordValid = EepromManager<uint32_t>::getIfValid(hz, I2C_CLOCK_STORE_EEPROM_ADDRESS) != 0;
+    if (!recordValid) {
+        DEBUG("I2cClockStore: nincs érvényes rekord, kalibrálni kell\n");
+        hz = I2C_CLOCK_UNCALIBRATED;
+    }
+    savedHz = hz;
+    clockHz.store(hz, std::memory_order_relaxed);
+}
+
+/**
+ * Mentés, ha az órajel változott
+ */
+bool I2cClockStore::checkSave() {
+
+    uint32_t hz = get();
+    if (recordValid and hz == savedHz) {
+        return false;
+    }
+    EepromManager<uint32_t>::save(hz, I2C_CLOCK_STORE_EEPROM_ADDRESS);
+    savedHz = hz;
+    recordValid = true;
+    DEBUG("I2cClockStore: %lu Hz mentve\n", hz);
+    return true;
+}
@@ -0,0 +1,48 @@
+#ifndef __I2CCLOCKSTORE_H
+#define __I2CCLOCKSTORE_H
+
+#include "EepromManager.h"
+#include <atomic>
+
+#define I2C_CLOCK_STORE_EEPROM_ADDRESS 1024 // A kalibrált I2C órajel helye az EEPROM-ban (a band terület után)
+#define I2C_CLOCK_UNCALIBRATED 0            // Az órajel értéke, amíg nincs kalibrálva (I2cClockTuner)
+
+/**
+ * A kalibrált Si4735 I2C órajel mentése az EEPROM-ba
+ *
+ * A Config_t-n kívül, saját CRC-s rekordban tárolódik: a Config_t mérete (és vele a CRC-je) nem változik,
+ * így a korábbi firmware beállításai (pl.: a TFT kalibráció) a frissítés után is megmaradnak.
+ * Az érvénytelenítést a core1 is kérheti (ismétlődő patch hibák), az EEPROM írás a core0 dolga.
+ */
+class I2cClockStore {
+
+private:
+    std::atomic<uint32_t> clockHz{I2C_CLOCK_UNCALIBRATED};
+    uint32_t savedHz = I2C_CLOCK_UNCALIBRATED; // Az EEPROM-ban lévő érték
+    bool recordValid = false;                  // Van érvényes rekord az EEPROM-ban?
+
+public:
+    /**
+     * A tárolt órajel betöltése (ha nincs érvényes rekord: I2C_CLOCK_UNCALIBRATED)
+     */
+    void load();
+
+    /**
+     * A tárolt órajel (bármelyik core-ról hívható)
+     */
+    uint32_t get() const { return clockHz.load(std::memory_order_relaxed); }
+
+    /**
+     * Új órajel, a mentés a következő checkSave()-kor (bármelyik core-ról hívható)
+     * @param hz a kalibrált órajel, vagy I2C_CLOCK_UNCALIBRATED: a következő induláskor újrakalibrálunk
+     */
+    void set(uint32_t hz) { clockHz.store(hz, std::memory_order_relaxed); }
+
+    /**
+     * Mentés, ha az órajel változott (csak a core0-ról)
+     * @return true, ha írtunk az EEPROM-ba
+     */
+    bool checkSave();
+};
+
+#endif // __I2CCLOCKSTORE_H
@@ -0,0 +1,102 @@
+#include "I2cClockTuner.h"
+#include "utils.h"
+
+// A kipróbált órajelek növekvő sorrendben (az Si4735 adatlap szerint 400kHz a max., e felett nem üzemeltetjük)
+const uint32_t I2cClockTuner::CLOCKS[] = {I2C_CLOCK_SAFE_HZ, 200000, 300000, 400000};
+#define I2C_CLOCK_STEPS ARRAY_ITEM_COUNT(CLOCKS)
+
+I2cClockTuner::StepResult I2cClockTuner::results[I2C_CLOCK_STEPS] = {};
+uint32_t I2cClockTuner::lastCalibrationMsec = 0;
+bool I2cClockTuner::calibrated = false;
+
+// A visszaolvasás bitmintái (az alsó bitek mindkét értékkel, szomszédos bitek ellentétes értékkel is, és sok bit egyszerre váltva)
+// A chip a tartományon kívüli értéket elutasítja, ezért a minták a SEEK_BAND_TOP érvényes tartományán belül vannak
+#define I2C_CLOCK_READBACK_PATTERNS 8
+static const uint16_t READBACK_PATTERNS_FM[I2C_CLOCK_READBACK_PATTERNS] = {0x2555, 0x1AAA, 0x20FF, 0x1F00, 0x2A0F, 0x1CF0, 0x2000, 0x1FFF}; // 6400..10800 (10kHz)
+static const uint16_t READBACK_PATTERNS_AM[I2C_CLOCK_READBACK_PATTERNS] = {0x5555, 0x2AAA, 0x00FF, 0x3F00, 0x0F0F, 0x50F0, 0x4000, 0x3FFF}; // 149..23000 (kHz)
+
+/**
+ * Property írás/visszaolvasás az aktuális órajelen
+ */
+bool I2cClockTuner::verifyReadback(SI4735 &si4735, uint16_t property, const uint16_t *patterns) {
+
+    for (uint8_t round = 0; round < I2C_CLOCK_READBACK_ROUNDS; round++) {
+        for (uint8_t i = 0; i < I2C_CLOCK_READBACK_PATTERNS; i++) {
+            si4735.setProperty(property, patterns[i]);
+            if ((uint16_t)si4735.getProperty(property) != patterns[i]) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+/**
+ * Kalibrálás
+ */
+uint32_t I2cClockTuner::calibrate(SI4735 &si4735, Band &band, bool fmMode) {
+
+    uint16_t property = fmMode ? I2C_CLOCK_SCRATCH_PROP_FM : I2C_CLOCK_SCRATCH_PROP_AM;
+    const uint16_t *patterns = fmMode ? READBACK_PATTERNS_FM : READBACK_PATTERNS_AM;
+    memset(results, STEP_NOT_TESTED, sizeof(results));
+    uint32_t start = millis();
+
+    // Az eredeti értéket a biztonságos órajelen olvassuk ki
+    si4735.setI2CFastModeCustom(CLOCKS[0]);
+    uint16_t original = si4735.getProperty(property);
+
+    // Felfelé lépkedünk, amíg a visszaolvasás hibátlan
+    int8_t best = 0;
+    for (uint8_t i = 0; i < I2C_CLOCK_STEPS; i++) {
+        si4735.setI2CFastModeCustom(CLOCKS[i]);
+        bool ok = verifyReadback(si4735, property, patterns);
+        results[i] = ok ? STEP_OK : STEP_READBACK_FAILED;
+        if (!ok) {
+            break;
+        }
+        best = i;
+    }
+
+    // A teszt property visszaállítása egy már bevált órajelen
+    si4735.setI2CFastModeCustom(CLOCKS[best]);
+    si4735.setProperty(property, original);
+
+    // A patch letöltés a legnagyobb terhelés: ha nem sikerül, visszalépünk
+    while (best > 0) {
+        si4735.setI2CFastModeCustom(CLOCKS[best]);
+        if (band.verifySSBPatch()) {
+            break;
+        }
+        results[best] = STEP_PATCH_FAILED;
+        best--;
+    }
+
+    // A patch letöltés után a chip állapotát a band váltás rendezi, az árnyék már nem érvényes
+    si4735.setI2CFastModeCustom(CLOCKS[best]);
+    band.getPropertyShadow().invalidate();
+    lastCalibrationMsec = millis() - start;
+    calibrated = true;
+
+    DEBUG("I2cClockTuner: %lu Hz (%lu msec)\n", CLOCKS[best], lastCalibrationMsec);
+    return CLOCKS[best];
+}
+
+/**
+ * A legutóbbi kalibrálás eredményének kiírása a soros portra
+ */
+void I2cClockTuner::dump(uint32_t currentHz) {
+
+    static const char *RESULT_NAMES[] = {"-", "ok", "readback failed", "patch failed"};
+
+    Serial.printf("===== Si4735 I2C clock =====\n");
+    Serial.printf("Current: %lu Hz\n", currentHz);
+    if (!calibrated) {
+        Serial.printf("Not calibrated in this session\n");
+    } else {
+        Serial.printf("Last calibration: %lu msec\n", lastCalibrationMsec);
+        for (uint8_t i = 0; i < I2C_CLOCK_STEPS; i++) {
+            Serial.printf("%7lu Hz: %s\n", CLOCKS[i], RESULT_NAMES[results[i]]);
+        }
+    }
+    Serial.printf("---\n");
+}
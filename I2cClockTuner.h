@@ -0,0 +1,57 @@
+#ifndef __I2CCLOCKTUNER_H
+#define __I2CCLOCKTUNER_H
+
+#include "Band.h"
+
+#define I2C_CLOCK_SAFE_HZ 100000       // Normál módú I2C, ezen minden Si4735 működik
+#define I2C_CLOCK_READBACK_ROUNDS 8    // Ennyi írás/visszaolvasás kör órajelenként (körönként a teljes mintakészlet)
+#define I2C_CLOCK_SCRATCH_PROP_FM SI473X_PROP_FM_SEEK_BAND_TOP // A kalibrálás alatt ide írunk (a végén visszaállítjuk)
+#define I2C_CLOCK_SCRATCH_PROP_AM SI473X_PROP_AM_SEEK_BAND_TOP
+
+/**
+ * Az Si4735 I2C órajelének kalibrálása
+ *
+ * Az órajelet lépésenként emeli (legfeljebb az adatlap szerinti 400kHz-ig), és minden lépést property
+ * írás/visszaolvasással ellenőriz (a property érvényes tartományán belüli bitmintákkal).
+ * A legnagyobb hibátlan órajelen letölti az SSB patch-et is (ez a legnagyobb egybefüggő forgalom):
+ * ha a chip valamelyik patch parancsra hibát jelez, akkor egy lépést visszalép.
+ * Az eredményt az I2cClockStore menti, így csak az első induláskor (vagy kérésre) kell kalibrálni.
+ * A setup()-ban, a RadioService indítása előtt kell hívni (a chipet közvetlenül kezeli)!
+ */
+class I2cClockTuner {
+
+public:
+    // Egy órajel lépés eredménye
+    enum StepResult : uint8_t {
+        STEP_NOT_TESTED = 0,
+        STEP_OK,
+        STEP_READBACK_FAILED, // Hibás visszaolvasás
+        STEP_PATCH_FAILED     // Hibás patch letöltés
+    };
+
+private:
+    static const uint32_t CLOCKS[];
+    static StepResult results[];
+    static uint32_t lastCalibrationMsec;
+    static bool calibrated; // Volt kalibrálás ebben a munkamenetben?
+
+    static bool verifyReadback(SI4735 &si4735, uint16_t property, const uint16_t *patterns);
+
+public:
+    /**
+     * Kalibrálás
+     * @param si4735 a chip (a hívás után a kalibrált órajelen marad)
+     * @param band a patch letöltéshez és a property árnyék érvénytelenítéséhez
+     * @param fmMode a chip most FM módban van? (a teszt property kiválasztásához)
+     * @return a legnagyobb stabil órajel (Hz)
+     */
+    static uint32_t calibrate(SI4735 &si4735, Band &band, bool fmMode);
+
+    /**
+     * A legutóbbi kalibrálás eredményének kiírása a soros portra
+     * @param currentHz az aktuális órajel
+     */
+    static void dump(uint32_t currentHz);
+};
+
+#endif // __I2CCLOCKTUNER_H
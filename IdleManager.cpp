@@ -0,0 +1,101 @@
+#include "IdleManager.h"
+
+IdleManager::IdleStats_t IdleManager::stats[2] = {};
+volatile bool IdleManager::enabled = true;
+
+/**
+ * Alarm callback: csak felébreszti a core0-t (a megszakítás maga ébreszt), nem ismétlődik
+ */
+static int64_t wakeAlarmCallback(alarm_id_t /*id*/, void * /*userData*/) {
+    return 0;
+}
+
+/**
+ * Egy alvás könyvelése
+ */
+void IdleManager::recordSleep(IdleStats_t &s, uint64_t startUsec, uint64_t endUsec, uint64_t deadlineUsec) {
+    s.idleUsec += endUsec - startUsec;
+    s.sleeps++;
+
+    // Csak a határidőre (vagy utána) ébredést mérjük, a korábbi (pl.: encoder tick) ébredés nem késés
+    if (endUsec >= deadlineUsec) {
+        uint32_t latency = endUsec - deadlineUsec;
+        s.wakeLatencyCount++;
+        s.wakeLatencySumUsec += latency;
+        if (latency > s.wakeLatencyMaxUsec) {
+            s.wakeLatencyMaxUsec = latency;
+        }
+    }
+}
+
+/**
+ * core0: alvás legfeljebb a következő task kiadásáig
+ */
+void IdleManager::sleepCore0(uint32_t waitMsec) {
+    if (!enabled or waitMsec == 0) {
+        return;
+    }
+
+    // A scheduler msec felbontású: a task akkor esedékes, amikor a millis() eléri a kiadás idejét
+    uint64_t start = time_us_64();
+    uint64_t deadline = (start / 1000 + waitMsec) * 1000;
+
+    alarm_id_t alarm = add_alarm_at(from_us_since_boot(deadline), wakeAlarmCallback, nullptr, true);
+    __wfi();
+    if (alarm > 0) {
+        cancel_alarm(alarm);
+    }
+
+    recordSleep(stats[0], start, time_us_64(), deadline);
+}
+
+/**
+ * core1: alvás a következő munkáig
+ */
+void IdleManager::sleepCore1(uint32_t waitMsec) {
+    if (!enabled or waitMsec == 0) {
+        return;
+    }
+
+    if (waitMsec > IDLE_CORE1_MAX_SLEEP_MSEC) {
+        waitMsec = IDLE_CORE1_MAX_SLEEP_MSEC;
+    }
+
+    // __wfe() időkorláttal: a pico-sdk egy hardver alarm-mal küld eseményt a határidőre
+    uint64_t start = time_us_64();
+    uint64_t deadline = start + (uint64_t)waitMsec * 1000;
+    best_effort_wfe_or_timeout(from_us_since_boot(deadline));
+
+    recordSleep(stats[1], start, time_us_64(), deadline);
+}
+
+/**
+ * Alvással töltött idő aránya (%)
+ */
+float IdleManager::getIdlePercent(uint8_t core) {
+    uint64_t window = time_us_64() - stats[core].windowStartUsec;
+    return window ? stats[core].idleUsec * 100.0f / window : 0.0f;
+}
+
+/**
+ * Statisztika nullázása
+ */
+void IdleManager::resetStats() {
+    uint64_t now = time_us_64();
+    for (uint8_t core = 0; core < 2; core++) {
+        memset(&stats[core], 0, sizeof(IdleStats_t));
+        stats[core].windowStartUsec = now;
+    }
+}
+
+/**
+ * Statisztika kiírása a soros portra
+ */
+void IdleManager::dump() {
+    Serial.printf("Idle (%s)\tIdle%%\tSleeps\tWake lat. avg/max (usec)\n", enabled ? "on" : "off");
+    for (uint8_t core = 0; core < 2; core++) {
+        const IdleStats_t &s = stats[core];
+        Serial.printf("core%d\t\t%.1f\t%lu\t%lu / %lu\n", core, getIdlePercent(core), s.sleeps,
+                      s.wakeLatencyCount ? s.wakeLatencySumUsec / s.wakeLatencyCount : 0, s.wakeLatencyMaxUsec);
+    }
+}
@@ -0,0 +1,79 @@
+#ifndef __IDLEMANAGER_H
+#define __IDLEMANAGER_H
+
+#include <Arduino.h>
+
+#define IDLE_CORE1_MAX_SLEEP_MSEC 100 // A core1 legfeljebb ennyit alszik egyhuzamban (biztonsági felső korlát)
+
+/**
+ * Alacsony fogyasztású várakozás a core-ok ütemezett munkái között
+ *
+ * core0: ha nincs esedékes task, a következő kiadásig __wfi()-vel alszik. Felébreszti a határidőre állított
+ *        hardver alarm, a rotary encoder 1 msec-es tickere, vagy bármely más megszakítás (pl.: touch, GPO2/INT).
+ * core1: ha nincs munkája, __wfe()-vel alszik a következő pollingig. A core0 a parancsok és a jelminőség igények
+ *        küldésekor __sev()-vel ébreszti (a WFE esemény regisztere miatt ébresztés nem veszhet el).
+ *
+ * Statisztika core-onként: alvással töltött idő aránya és az ébredési késés (a határidőhöz képest).
+ */
+class IdleManager {
+
+public:
+    // Egy core alvás statisztikája
+    struct IdleStats_t {
+        uint64_t windowStartUsec;    // A mérési ablak kezdete
+        uint64_t idleUsec;           // Alvással töltött idő az ablakban
+        uint32_t sleeps;             // Elalvások száma
+        uint32_t wakeLatencyCount;   // Határidőre ébredések száma
+        uint32_t wakeLatencySumUsec; // Ébredési késések összege
+        uint32_t wakeLatencyMaxUsec; // Legnagyobb ébredési késés
+    };
+
+private:
+    static IdleStats_t stats[2];
+    static volatile bool enabled;
+
+    static void recordSleep(IdleStats_t &s, uint64_t startUsec, uint64_t endUsec, uint64_t deadlineUsec);
+
+public:
+    /**
+     * Alvás engedélyezése/tiltása (tiltva a loop pörög, mint korábban)
+     */
+    static void setEnabled(bool enable) { enabled = enable; }
+    static bool isEnabled() { return enabled; }
+
+    /**
+     * core0: alvás legfeljebb a következő task kiadásáig
+     * Egy megszakítás hamarabb is ébreszthet, ekkor a loop() újra ellenőriz, és szükség esetén újra elalszik
+     * @param waitMsec ennyi msec múlva esedékes a következő task
+     */
+    static void sleepCore0(uint32_t waitMsec);
+
+    /**
+     * core1: alvás a következő munkáig, vagy amíg a core0 fel nem ébreszti
+     * @param waitMsec ennyi msec múlva van munka (UINT32_MAX: csak eseményre)
+     */
+    static void sleepCore1(uint32_t waitMsec);
+
+    /**
+     * A másik core ébresztése (pl.: új parancs a core1-nek)
+     */
+    static inline void wakeOtherCore() { __sev(); }
+
+    /**
+     * Alvással töltött idő aránya a mérési ablakban (%)
+     */
+    static float getIdlePercent(uint8_t core);
+
+    /**
+     * Statisztika lekérése/nullázása (az ablak újraindul)
+     */
+    static const IdleStats_t &getStats(uint8_t core) { return stats[core]; }
+    static void resetStats();
+
+    /**
+     * Statisztika kiírása a soros portra
+     */
+    static void dump();
+};
+
+#endif // __IDLEMANAGER_H
@@ -4,39 +4,46 @@
 #include "InputTextField.h"
 #include "MultiButtonDialog.h"
 
+#define INPUT_DLG_FIELD_H 20   // A szövegmező magassága
+#define INPUT_DLG_MAX_LENGTH 8 // A beírható karakterek max. száma (pl.: "108.000" vagy "30000")
+
+/**
+ * Frekvencia beviteli dialóg: szám billentyűzet és a beírt szöveg
+ * A számjegyeket, a tizedespontot és a törlést maga kezeli, az "OK" és az "X" gombot a hívó callback-je kapja
+ * (az "OK" gomb a DIALOG_OK_BUTTON_ID azonosítóval), a beírt szöveg a getText()-tel kérhető el.
+ */
 class InputDialog : public MultiButtonDialog {
 private:
     InputTextField *inputField;
+    ButtonCallback_t resultCallback; // A hívó callback-je ("OK" és "X")
 
 private:
-    void buttonCallback(const uint8_t id, const char *label, ButtonState_t state) {
-        DEBUG("InputDialog::buttonCallback() - Id: %d, Label: '%s', állapot változás: %s\n", id, label, TftButton::decodeState(state));
+    void keyCallback(const uint8_t id, const char *label, ButtonState_t state) {
+
+        if (id == PopupBase::DIALOG_CLOSE_BUTTON_ID or strcmp(label, "OK") == 0) {
+            if (resultCallback) {
+                resultCallback(id == PopupBase::DIALOG_CLOSE_BUTTON_ID ? id : PopupBase::DIALOG_OK_BUTTON_ID, label, state);
+            }
+        } else if (strcmp(label, "<<") == 0) {
+            inputField->backspace();
+        } else if (inputField->getText().length() < INPUT_DLG_MAX_LENGTH) {
+            inputField->append(label[0]);
+        }
     }
 
 public:
-    InputDialog(TFT_eSPI &tft, uint16_t w, uint16_t h, const __FlashStringHelper *title)
-        : MultiButtonDialog(tft, w, h, title) {
-
-        inputField = new InputTextField(tft, x - 5, contentY + 5, w - 5, 20);
+    InputDialog(TFT_eSPI &tft, uint16_t w, uint16_t h, const __FlashStringHelper *title, ButtonCallback_t callback)
+        : MultiButtonDialog(tft, w, h, title), resultCallback(callback) {
 
-        // // Beállítjuk az ősnek a gombok számát
-        buttonCount = 2;
+        inputField = new InputTextField(tft, x + 10, contentY + 5, w - 20, INPUT_DLG_FIELD_H);
 
-        // // Dinamikusan foglalunk helyet a gomboknak az ősben
-        // buttons = new TftButton *[buttonCount];
-        // uint8_t id = PopupBase::DLG_MULTI_BTN_ID_START;
-        // uint8_t arrIdx = 0;
-
-        // // Létrehozzuk a gombokat
-        // const char *buttonLabels[] = {"1", "2", "3", "4", "5", "6", "7", "8", "9", "0", ".", "<<"};
-        //
-        // for (uint8_t i = 0; i < buttonCount; i++) {
-        //     buttons[arrIdx++] = new TftButton(id++, pTft, MULTI_BTN_W, MULTI_BTN_H, buttonLabels[i], ButtonType::PUSHABLE, SCRN_BTN_CB(InputDialog, buttonCallback, this));
-        // }
-
-        //*buttons[arrIdx++] = new TftButton(PopupBase::DIALOG_OK_BUTTON_ID, pTft, 60, DLG_BTN_H, "OK", ButtonType::PUSHABLE, SCRN_BTN_CB(InputDialog, buttonCallback, this));
-        //*buttons[arrIdx++] = new TftButton(PopupBase::DIALOG_CANCEL_BUTTON_ID, pTft, 60, DLG_BTN_H, "Cancel", ButtonType::PUSHABLE, SCRN_BTN_CB(InputDialog, buttonCallback, this)); // Mégsem gomb
+        // A billentyűzet a szövegmező alá kerül
+        contentY += INPUT_DLG_FIELD_H + 15;
+        const char *buttonLabels[] = {"1", "2", "3", "4", "5", "6", "7", "8", "9", ".", "0", "<<", "OK"};
+        buildButtonArray(buttonLabels, ARRAY_ITEM_COUNT(buttonLabels), SCRN_BTN_CB(InputDialog, keyCallback, this));
+        placeButtons();
     }
+
     /**
      *
      */
@@ -44,19 +51,22 @@ public:
         delete inputField;
     }
 
-    virtual void handleTouch(bool touched, uint16_t tx, uint16_t ty) override {
-        // Először meghívhatjuk az ősosztály handleTouch metódusát
-        MultiButtonDialog::handleTouch(touched, tx, ty);
-
-        // A szövegbevitel mező kezelése
-        if (inputField) {
-            // inputField->handleTouch(touched, tx, ty);
-        }
+    /**
+     * A beírt szöveg
+     */
+    String getText() const {
+        return inputField->getText();
+    }
 
-        // Esetleg a gombok kezelése is itt történhet
-        for (uint8_t i = 0; i < buttonCount; i++) {
-            buttons[i]->handleTouch(touched, tx, ty);
+    /**
+     * A dialóg és a szövegmező kirajzolása
+     */
+    virtual void drawDialog() override {
+        if (visible) {
+            return;
         }
+        MultiButtonDialog::drawDialog();
+        inputField->draw();
     }
 };
-#endif // __INPUTDIALOG_H
\ No newline at end of file
+#endif // __INPUTDIALOG_H
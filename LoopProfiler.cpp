@@ -0,0 +1,82 @@
+#include "LoopProfiler.h"
+
+// A stage-ek nevei (a ProfileStage sorrendjében)
+static const char *STAGE_NAMES[STAGE_COUNT] = {
+    "loop", "encoder", "touchRead", "touch", "display", "freqDraw", "squelch", "smeter", "rds", "eeprom",
+    "memory", "radioCmd", "radioRsq", "radioRds", "radioScope"};
+
+LoopProfiler::StageStats_t LoopProfiler::stats[STAGE_COUNT] = {};
+volatile ProfileStage LoopProfiler::currentStage = STAGE_LOOP;
+volatile ProfileStage LoopProfiler::currentStageCore1 = STAGE_COUNT;
+
+/**
+ * A stage neve
+ */
+const char *LoopProfiler::getStageName(ProfileStage stage) {
+    return stage < STAGE_COUNT ? STAGE_NAMES[stage] : "-";
+}
+
+/**
+ * Becsült percentilis ciklusokban
+ */
+uint32_t LoopProfiler::getPercentileCycles(ProfileStage stage, uint16_t permille) {
+
+    const StageStats_t &s = stats[stage];
+    if (s.count == 0) {
+        return 0;
+    }
+
+    // Hány mérésnek kell a határ alá esnie (felfelé kerekítve)
+    uint32_t target = (uint32_t)(((uint64_t)s.count * permille + 999) / 1000);
+    uint32_t cumulative = 0;
+
+    for (uint8_t b = 0; b < PROFILER_BUCKETS; b++) {
+        cumulative += s.buckets[b];
+        if (cumulative >= target) {
+            // A vödör felső határa, de a maximumnál nem lehet nagyobb
+            uint32_t upper = b >= 31 ? UINT32_MAX : (2UL << b) - 1;
+            return upper < s.maxCycles ? upper : s.maxCycles;
+        }
+    }
+
+    return s.maxCycles;
+}
+
+/**
+ * Statisztikák törlése
+ */
+void LoopProfiler::reset() {
+    memset(stats, 0, sizeof(stats));
+}
+
+/**
+ * Statisztikák kiírása a soros portra
+ */
+void LoopProfiler::dump(bool withHistogram) {
+
+    // ciklus -> usec
+    const float cyclesPerUsec = F_CPU / 1000000.0f;
+
+    Serial.printf("===== Loop profiler (usec) =====\n");
+    Serial.printf("Stage\t\tCount\tAvg\tp99\tMax\n");
+    for (uint8_t i = 0; i < STAGE_COUNT; i++) {
+        const StageStats_t &s = stats[i];
+        if (s.count == 0) {
+            continue;
+        }
+        Serial.printf("%-12s\t%lu\t%.1f\t%.1f\t%.1f\n",
+                      getStageName((ProfileStage)i), s.count,
+                      (s.totalCycles / (float)s.count) / cyclesPerUsec,
+                      getPercentileCycles((ProfileStage)i, 990) / cyclesPerUsec,
+                      s.maxCycles / cyclesPerUsec);
+
+        if (withHistogram) {
+            for (uint8_t b = 0; b < PROFILER_BUCKETS; b++) {
+                if (s.buckets[b]) {
+                    Serial.printf("\t< %.1f: %lu\n", (float)(1ULL << (b + 1)) / cyclesPerUsec, s.buckets[b]);
+                }
+            }
+        }
+    }
+    Serial.printf("---\n");
+}
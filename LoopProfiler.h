@@ -0,0 +1,167 @@
+#ifndef __LOOPPROFILER_H
+#define __LOOPPROFILER_H
+
+#include <Arduino.h>
+
+#define __PROFILER // Futásidő mérés bekapcsolása (kicsi az overhead-je, production buildben is maradhat)
+
+#define PROFILER_BUCKETS 32 // log2 hisztogram vödrök száma (a 32 bites ciklusszámláló teljes tartománya)
+
+/**
+ * A mért szakaszok (stage-ek)
+ * Egy stage-et mindig csak egy core írhat!
+ */
+enum ProfileStage : uint8_t {
+    // core0
+    STAGE_LOOP = 0,   // Egy teljes loop() (egy task futtatása)
+    STAGE_ENCODER,    // Rotary encoder olvasás + feldolgozás
+    STAGE_TOUCH_READ, // tft.getTouch()
+    STAGE_TOUCH,      // Touch események feldolgozása
+    STAGE_DISPLAY,    // Display loop (frekvencia kijelzés)
+    STAGE_FREQ_DRAW,  // FreqDisplay::FreqDraw()
+    STAGE_SQUELCH,    // Zajzár
+    STAGE_SMETER,     // S-Meter, mono/sztereo
+    STAGE_RDS,        // RDS megjelenítés
+    STAGE_EEPROM,     // EEPROM mentés ellenőrzés
+    STAGE_MEMORY,     // Memória csatornák kiírása (LittleFS)
+    // core1
+    STAGE_RADIO_CMD, // Rádió parancsok végrehajtása
+    STAGE_RADIO_RSQ, // RSQ_STATUS I2C lekérdezés
+    STAGE_RADIO_RDS, // RDS státusz I2C lekérdezés
+    STAGE_RADIO_SCOPE, // Band scope sweep / állomás keresés lépés
+    STAGE_COUNT
+};
+
+/**
+ * Szakaszonkénti futásidő hisztogramok
+ *
+ * A futásidőt CPU ciklusokban mérjük, log2 vödrökbe soroljuk (a vödör indexe = a legmagasabb 1-es bit helye),
+ * így egy mérés rögzítése csak néhány utasítás, nincs osztás és nincs lebegőpontos művelet.
+ * A p99 a hisztogramból becsült érték (a vödör felső határa).
+ */
+class LoopProfiler {
+
+public:
+    // Egy stage statisztikája
+    struct StageStats_t {
+        uint32_t buckets[PROFILER_BUCKETS];
+        uint32_t count;
+        uint32_t maxCycles;
+        uint64_t totalCycles;
+    };
+
+private:
+    static StageStats_t stats[STAGE_COUNT];
+    static volatile ProfileStage currentStage;      // Az éppen futó core0 stage (pl.: a watchdog diagnosztikához)
+    static volatile ProfileStage currentStageCore1; // Az éppen futó core1 stage (STAGE_COUNT: nincs mért szakaszban)
+
+public:
+    /**
+     * Aktuális ciklusszámláló érték
+     */
+    static inline uint32_t now() {
+        return rp2040.getCycleCount();
+    }
+
+    /**
+     * Egy mérés rögzítése
+     * @param stage a mért szakasz
+     * @param cycles a futásidő CPU ciklusokban
+     */
+    static inline void record(ProfileStage stage, uint32_t cycles) {
+        StageStats_t &s = stats[stage];
+        s.buckets[cycles ? 31 - __builtin_clz(cycles) : 0]++;
+        s.count++;
+        s.totalCycles += cycles;
+        if (cycles > s.maxCycles) {
+            s.maxCycles = cycles;
+        }
+    }
+
+    /**
+     * Az éppen futó core0 stage beállítása/lekérése
+     */
+    static inline void setCurrentStage(ProfileStage stage) { currentStage = stage; }
+    static inline ProfileStage getCurrentStage() { return currentStage; }
+
+    /**
+     * Az éppen futó core1 stage beállítása/lekérése
+     */
+    static inline void setCurrentStageCore1(ProfileStage stage) { currentStageCore1 = stage; }
+    static inline ProfileStage getCurrentStageCore1() { return currentStageCore1; }
+
+    /**
+     * A stage neve
+     */
+    static const char *getStageName(ProfileStage stage);
+
+    /**
+     * Becsült percentilis ciklusokban (a vödör felső határa)
+     * @param stage a szakasz
+     * @param permille ezrelékben (pl.: 990 -> p99)
+     */
+    static uint32_t getPercentileCycles(ProfileStage stage, uint16_t permille);
+
+    /**
+     * Statisztikák törlése
+     */
+    static void reset();
+
+    /**
+     * Statisztikák kiírása a soros portra
+     * @param withHistogram a hisztogram vödröket is kiírjuk
+     */
+    static void dump(bool withHistogram);
+};
+
+/**
+ * RAII mérő: a konstruktor és a destruktor között eltelt időt rögzíti
+ */
+class ProfileScope {
+
+private:
+    ProfileStage stage;
+    ProfileStage prevStage;
+    uint32_t start;
+
+public:
+    ProfileScope(ProfileStage stage) : stage(stage), prevStage(LoopProfiler::getCurrentStage()), start(LoopProfiler::now()) {
+        LoopProfiler::setCurrentStage(stage);
+    }
+
+    ~ProfileScope() {
+        LoopProfiler::record(stage, LoopProfiler::now() - start);
+        LoopProfiler::setCurrentStage(prevStage);
+    }
+};
+
+/**
+ * Mérő a core1 stage-ekhez (nem írja felül a core0 aktuális stage-ét)
+ */
+class ProfileScopeCore1 {
+
+private:
+    ProfileStage stage;
+    ProfileStage prevStage;
+    uint32_t start;
+
+public:
+    ProfileScopeCore1(ProfileStage stage) : stage(stage), prevStage(LoopProfiler::getCurrentStageCore1()), start(LoopProfiler::now()) {
+        LoopProfiler::setCurrentStageCore1(stage);
+    }
+
+    ~ProfileScopeCore1() {
+        LoopProfiler::record(stage, LoopProfiler::now() - start);
+        LoopProfiler::setCurrentStageCore1(prevStage);
+    }
+};
+
+#ifdef __PROFILER
+#define PROFILE_STAGE(stage) ProfileScope __profileScope(stage)
+#define PROFILE_STAGE_CORE1(stage) ProfileScopeCore1 __profileScope(stage)
+#else
+#define PROFILE_STAGE(stage)       // Üres makró, ha __PROFILER nincs definiálva
+#define PROFILE_STAGE_CORE1(stage) // Üres makró, ha __PROFILER nincs definiálva
+#endif
+
+#endif // __LOOPPROFILER_H
@@ -0,0 +1,137 @@
+#include "LoopWatchdog.h"
+#include <hardware/watchdog.h>
+
+// A scratch regiszterek kiosztása (a 4..7 a bootrom-é)
+#define SCRATCH_MAGIC 0  // WATCHDOG_SCRATCH_MAGIC, ha érvényes a bejegyzés
+#define SCRATCH_STATE 1  // ok | core0 stage << 8 | core1 stage << 16
+#define SCRATCH_LOOP 2   // loop hossza (msec)
+#define SCRATCH_UPTIME 3 // üzemidő (msec)
+
+/**
+ * Indítás
+ */
+void LoopWatchdog::begin(uint32_t budgetMsec) {
+
+    this->budgetMsec = budgetMsec < WATCHDOG_MAX_BUDGET_MSEC ? budgetMsec : WATCHDOG_MAX_BUDGET_MSEC;
+
+    // Az előző újraindulás oka
+    memset(&lastReport, 0, sizeof(lastReport));
+    if (watchdog_enable_caused_reboot()) {
+        if (watchdog_hw->scratch[SCRATCH_MAGIC] == WATCHDOG_SCRATCH_MAGIC) {
+            uint32_t state = watchdog_hw->scratch[SCRATCH_STATE];
+            lastReport.reason = (ResetReason)(state & 0xFF);
+            lastReport.stageCore0 = (ProfileStage)((state >> 8) & 0xFF);
+            lastReport.stageCore1 = (ProfileStage)((state >> 16) & 0xFF);
+            lastReport.loopMsec = watchdog_hw->scratch[SCRATCH_LOOP];
+            lastReport.uptimeMsec = watchdog_hw->scratch[SCRATCH_UPTIME];
+        } else {
+            lastReport.reason = REASON_UNKNOWN;
+        }
+        dump();
+    }
+    watchdog_hw->scratch[SCRATCH_MAGIC] = 0;
+
+    // Élesítés
+    lastFeedMsec = lastCore1AliveMsec = millis();
+    rp2040.wdt_begin(this->budgetMsec);
+    checkTicker.attach_ms(this->budgetMsec / 4, [this]() { check(); });
+}
+
+/**
+ * Etetés (core0)
+ */
+void LoopWatchdog::feed() {
+
+    uint32_t now = millis();
+
+    uint32_t loopMsec = now - lastFeedMsec;
+    if (loopMsec > maxLoopMsec) {
+        maxLoopMsec = loopMsec;
+    }
+
+    // A core1 életjele
+    uint32_t heartbeat = core1Heartbeat.load(std::memory_order_relaxed);
+    bool core1Recovered = false;
+    if (heartbeat != lastCore1Heartbeat) {
+        lastCore1Heartbeat = heartbeat;
+        lastCore1AliveMsec = now;
+        core1Recovered = true;
+    }
+
+    // Ha a core1 is él, akkor etetünk, egyébként hagyjuk lejárni
+    if (now - lastCore1AliveMsec < budgetMsec) {
+        rp2040.wdt_reset();
+        lastFeedMsec = now;
+
+        // A figyelmeztetés nem vezetett resethez: a loop túlfutását az etetés, a core1 elakadását csak az újabb életjel oldja fel
+        // (a core1 még állhat, amikor a core0 már etet)
+        if (recorded and (recordedReason == REASON_LOOP_OVERRUN or core1Recovered)) {
+            watchdog_hw->scratch[SCRATCH_MAGIC] = 0;
+            recorded = false;
+            nearMisses++;
+        }
+    }
+}
+
+/**
+ * Túlfutás figyelés (ticker, a keretidő 3/4-énél rögzít)
+ */
+void LoopWatchdog::check() {
+
+    if (recorded) {
+        return;
+    }
+
+    uint32_t now = millis();
+    uint32_t warnMsec = budgetMsec * 3 / 4;
+    uint32_t loopMsec = now - lastFeedMsec;
+    uint32_t core1Msec = now - lastCore1AliveMsec;
+
+    ResetReason reason;
+    if (loopMsec >= warnMsec) {
+        reason = REASON_LOOP_OVERRUN;
+    } else if (core1Msec >= warnMsec) {
+        reason = REASON_CORE1_STALL;
+        loopMsec = core1Msec;
+    } else {
+        return;
+    }
+
+    watchdog_hw->scratch[SCRATCH_STATE] = reason | (LoopProfiler::getCurrentStage() << 8) | (LoopProfiler::getCurrentStageCore1() << 16);
+    watchdog_hw->scratch[SCRATCH_LOOP] = loopMsec;
+    watchdog_hw->scratch[SCRATCH_UPTIME] = now;
+    watchdog_hw->scratch[SCRATCH_MAGIC] = WATCHDOG_SCRATCH_MAGIC;
+    recordedReason = reason;
+    recorded = true;
+}
+
+/**
+ * Az ok szöveges formában
+ */
+const char *LoopWatchdog::getReasonName(ResetReason reason) {
+    switch (reason) {
+    case REASON_NONE:
+        return "none";
+    case REASON_LOOP_OVERRUN:
+        return "loop overrun";
+    case REASON_CORE1_STALL:
+        return "core1 stall";
+    default:
+        return "unknown (no diagnostics)";
+    }
+}
+
+/**
+ * Kiírás a soros portra
+ */
+void LoopWatchdog::dump() {
+    Serial.printf("===== Watchdog (budget %lu msec) =====\n", budgetMsec);
+    Serial.printf("Last reset: %s\n", getReasonName(lastReport.reason));
+    if (lastReport.reason >= REASON_LOOP_OVERRUN) {
+        Serial.printf("  core0 stage: %s, core1 stage: %s, loop: %lu msec, uptime: %lu msec\n",
+                      LoopProfiler::getStageName(lastReport.stageCore0), LoopProfiler::getStageName(lastReport.stageCore1),
+                      lastReport.loopMsec, lastReport.uptimeMsec);
+    }
+    Serial.printf("Max loop: %lu msec, near misses: %lu\n", maxLoopMsec, nearMisses);
+    Serial.printf("---\n");
+}
@@ -0,0 +1,101 @@
+#ifndef __LOOPWATCHDOG_H
+#define __LOOPWATCHDOG_H
+
+#include "LoopProfiler.h"
+#include <Arduino.h>
+#include <Ticker.h>
+#include <atomic>
+
+#define WATCHDOG_MAX_BUDGET_MSEC 8000  // Az RP2040 watchdog legnagyobb időkorlátja (~8.3 sec)
+#define WATCHDOG_SCRATCH_MAGIC 0x57440001 // Érvényes diagnosztika jelzése a scratch[0]-ban
+
+/**
+ * Hardver watchdog a fő ciklusra, túlfutás diagnosztikával
+ *
+ * A core0 loop() minden körben eteti (feed()), de csak akkor, ha a core1 is életjelet adott (core1Alive()) a keretidőn belül,
+ * így a core1-en beragadt I2C tranzakció is újraindítást okoz.
+ * Egy ticker a keretidő 3/4-énél figyelmeztet: ekkor beírja a watchdog scratch regiszterekbe (ezek túlélik a watchdog resetet)
+ * az okot, a futó stage-eket és a loop addigi futásidejét. Ha a loop mégis időben visszatér, a bejegyzést töröljük.
+ * Újraindulás után a begin() kiolvassa és kiírja a soros portra (a "wdt" paranccsal később is lekérdezhető).
+ */
+class LoopWatchdog {
+
+public:
+    // Újraindítás okai
+    enum ResetReason : uint8_t {
+        REASON_NONE = 0,     // Nem watchdog reset (bekapcsolás, reset gomb, feltöltés)
+        REASON_UNKNOWN,      // Watchdog reset diagnosztika nélkül (pl.: tiltott megszakítások mellett akadt el)
+        REASON_LOOP_OVERRUN, // A core0 loop() túllépte a keretidőt
+        REASON_CORE1_STALL   // A core1 nem adott életjelet (pl.: beragadt I2C)
+    };
+
+    // Az újraindulás előtt rögzített adatok
+    struct Report_t {
+        ResetReason reason;
+        ProfileStage stageCore0; // Az utoljára futó core0 stage
+        ProfileStage stageCore1; // Az utoljára futó core1 stage
+        uint32_t loopMsec;       // A loop (vagy a core1 csend) addigi hossza
+        uint32_t uptimeMsec;     // Üzemidő a rögzítéskor
+    };
+
+private:
+    uint32_t budgetMsec = 0;
+    Ticker checkTicker;
+
+    volatile uint32_t lastFeedMsec = 0;
+    volatile uint32_t lastCore1AliveMsec = 0;
+    uint32_t lastCore1Heartbeat = 0;
+    std::atomic<uint32_t> core1Heartbeat{0};
+    volatile bool recorded = false;
+    volatile ResetReason recordedReason = REASON_NONE; // A rögzített bejegyzés oka (a törlés feltétele ettől függ)
+
+    // Statisztika
+    uint32_t maxLoopMsec = 0;
+    uint32_t nearMisses = 0;
+
+    Report_t lastReport; // Az előző újraindulás oka
+
+public:
+    /**
+     * Indítás: az előző újraindulás diagnosztikájának kiolvasása, majd a watchdog élesítése
+     * @param budgetMsec keretidő (a loop() és a core1 életjele között ennyi telhet el)
+     */
+    void begin(uint32_t budgetMsec);
+
+    /**
+     * Etetés (core0 loop() elején)
+     */
+    void feed();
+
+    /**
+     * Életjel a core1-ről (loop1() minden körében)
+     */
+    inline void core1Alive() { core1Heartbeat.fetch_add(1, std::memory_order_relaxed); }
+
+    /**
+     * Túlfutás figyelés (a ticker hívja, a keretidő negyedenként)
+     */
+    void check();
+
+    /**
+     * A beállított keretidő
+     */
+    uint32_t getBudgetMsec() const { return budgetMsec; }
+
+    /**
+     * Az előző újraindulás oka/adatai
+     */
+    const Report_t &getLastReport() const { return lastReport; }
+
+    /**
+     * Az ok szöveges formában
+     */
+    static const char *getReasonName(ResetReason reason);
+
+    /**
+     * Az előző újraindulás és a statisztika kiírása a soros portra
+     */
+    void dump();
+};
+
+#endif // __LOOPWATCHDOG_H
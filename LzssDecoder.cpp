@@ -0,0 +1,71 @@
+#include "LzssDecoder.h"
+
+/**
+ * Kitömörítés indítása
+ */
+void LzssDecoder::begin(const uint8_t *src, uint32_t srcSize) {
+    this->src = src;
+    this->srcSize = srcSize;
+    srcPos = 0;
+    decodedBytes = 0;
+    windowPos = 0;
+    flags = 0;
+    flagBits = 0;
+    matchOffset = 0;
+    matchRemaining = 0;
+}
+
+/**
+ * A következő darab kitömörítése
+ */
+uint16_t LzssDecoder::read(uint8_t *out, uint16_t maxLen) {
+
+    uint16_t len = 0;
+
+    while (len < maxLen) {
+
+        uint8_t b;
+        if (matchRemaining > 0) {
+            // Ismétlés: az ablakból másolunk (átfedő ismétlés is lehet, ezért bájtonként)
+            b = window[(uint8_t)(windowPos - matchOffset)];
+            matchRemaining--;
+
+        } else {
+            if (srcPos >= srcSize) {
+                break;
+            }
+
+            // Új flag bájt
+            if (flagBits == 0) {
+                flags = src[srcPos++];
+                flagBits = 8;
+                if (srcPos >= srcSize) {
+                    break;
+                }
+            }
+
+            bool literal = flags & 0x01;
+            flags >>= 1;
+            flagBits--;
+
+            if (literal) {
+                b = src[srcPos++];
+            } else {
+                // Csonka adat: befejezzük
+                if (srcPos + 2 > srcSize) {
+                    srcPos = srcSize;
+                    break;
+                }
+                matchOffset = src[srcPos++] + 1;
+                matchRemaining = src[srcPos++] + LZSS_MIN_MATCH;
+                continue;
+            }
+        }
+
+        window[windowPos++] = b;
+        out[len++] = b;
+    }
+
+    decodedBytes += len;
+    return len;
+}
@@ -0,0 +1,63 @@
+#ifndef __LZSSDECODER_H
+#define __LZSSDECODER_H
+
+#include <stdint.h>
+
+// A tömörített formátum (a sim/PatchCompress.cpp állítja elő)
+#define LZSS_WINDOW_SIZE 256                 // Visszahivatkozási ablak (2 hatványa!)
+#define LZSS_MIN_MATCH 3                     // A legrövidebb ismétlés, ami megéri
+#define LZSS_MAX_MATCH (LZSS_MIN_MATCH + 255) // A leghosszabb ismétlés
+
+/**
+ * Folyamatos (streaming) LZSS kitömörítő
+ *
+ * Formátum: egy flag bájt 8 elemet ír le (LSB először), 1 -> literál bájt, 0 -> ismétlés két bájton (távolság - 1, hossz - LZSS_MIN_MATCH).
+ * A kitömörítés tetszőleges méretű darabokban történik, a memóriaigény csak az ablak (LZSS_WINDOW_SIZE bájt),
+ * így a tömörített adat a flash-ben maradhat, és nincs szükség a teljes kitömörített tartalom RAM másolatára.
+ */
+class LzssDecoder {
+
+    static_assert(LZSS_WINDOW_SIZE == 256, "LzssDecoder: the window index is an uint8_t");
+
+private:
+    const uint8_t *src = nullptr;
+    uint32_t srcSize = 0;
+    uint32_t srcPos = 0;
+    uint32_t decodedBytes = 0;
+
+    uint8_t window[LZSS_WINDOW_SIZE];
+    uint8_t windowPos = 0;
+
+    uint8_t flags = 0;
+    uint8_t flagBits = 0;         // Hány elem van még hátra az aktuális flag bájtból
+    uint16_t matchOffset = 0;     // Az aktuális ismétlés távolsága
+    uint16_t matchRemaining = 0;  // Az aktuális ismétlésből még kiírandó bájtok
+
+public:
+    /**
+     * Kitömörítés indítása
+     * @param src a tömörített adat
+     * @param srcSize a tömörített adat mérete
+     */
+    void begin(const uint8_t *src, uint32_t srcSize);
+
+    /**
+     * A következő darab kitömörítése
+     * @param out cél puffer
+     * @param maxLen legfeljebb ennyi bájtot írunk (a végét kivéve mindig pont ennyit)
+     * @return a kiírt bájtok száma, 0 a tömörített adat végén
+     */
+    uint16_t read(uint8_t *out, uint16_t maxLen);
+
+    /**
+     * Elfogyott a tömörített adat?
+     */
+    bool isDone() const { return srcPos >= srcSize and matchRemaining == 0; }
+
+    /**
+     * Eddig kitömörített bájtok száma
+     */
+    uint32_t getDecodedBytes() const { return decodedBytes; }
+};
+
+#endif // __LZSSDECODER_H
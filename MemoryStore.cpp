@@ -0,0 +1,265 @@
+#include "MemoryStore.h"
+#include "utils.h"
+
+static_assert(sizeof(MemoryChannel_t) == 16, "MemoryChannel_t: 16 bájtos rekord");
+static_assert(MEMORY_LOG_MAX_RECORDS + MEMORY_WRITE_BATCH < MEMORY_INDEX_NONE, "MemoryStore: a rekord sorszám nem fér el az indexben");
+
+/**
+ * A fájlrendszer csatolása és az index felépítése a naplóból
+ */
+bool MemoryStore::begin() {
+
+    mounted = LittleFS.begin();
+    if (!mounted) {
+        DEBUG("MemoryStore: a LittleFS nem csatolható\n");
+        return false;
+    }
+
+    memset(index, 0xFF, sizeof(index));
+    channelCount = 0;
+    fileRecords = 0;
+    pendingCount = 0;
+
+    // Félbeszakadt tömörítés maradéka: a csere atomi, így a napló érintetlen, a félkész másolat törölhető
+    // Ha a napló hiányzik (a korábbi törlés + átnevezés cserénél a kettő között szakadt meg), a másolat teljes: az lesz a napló
+    if (LittleFS.exists(MEMORY_TEMP_FILE_NAME)) {
+        if (LittleFS.exists(MEMORY_FILE_NAME)) {
+            LittleFS.remove(MEMORY_TEMP_FILE_NAME);
+        } else {
+            LittleFS.rename(MEMORY_TEMP_FILE_NAME, MEMORY_FILE_NAME);
+        }
+    }
+
+    File file = LittleFS.open(MEMORY_FILE_NAME, "r");
+    if (!file) {
+        return true; // Még nincs mentett csatorna
+    }
+
+    // A naplót köteg méretű darabokban olvassuk végig, a későbbi rekord felülírja a korábbit
+    uint32_t startMsec = millis();
+    size_t fileSize = file.size();
+    MemoryChannel_t records[MEMORY_WRITE_BATCH];
+    size_t n;
+    while ((n = file.read((uint8_t *)records, sizeof(records)) / sizeof(MemoryChannel_t)) > 0) {
+        for (size_t i = 0; i < n; i++) {
+            const MemoryChannel_t &record = records[i];
+            if (record.channel < MEMORY_MAX_CHANNELS) {
+                bool used = index[record.channel] != MEMORY_INDEX_NONE;
+                if (record.frequency == 0) {
+                    index[record.channel] = MEMORY_INDEX_NONE;
+                    channelCount -= used;
+                } else {
+                    index[record.channel] = fileRecords;
+                    channelCount += !used;
+                }
+            }
+            fileRecords++;
+        }
+    }
+    file.close();
+    DEBUG("MemoryStore: %u csatorna, %u rekord, %lu msec\n", channelCount, fileRecords, millis() - startMsec);
+
+    // Csonka utolsó rekord (pl.: írás közbeni tápvesztés): a tömörítés újraírja a fájlt rekord határra
+    if (fileSize % sizeof(MemoryChannel_t) != 0 or fileRecords >= MEMORY_LOG_MAX_RECORDS) {
+        compact();
+    }
+    return true;
+}
+
+/**
+ * Rekord felvétele a pufferbe
+ * @return false, ha a puffer tele van, és nem írható ki
+ */
+bool MemoryStore::append(const MemoryChannel_t &record) {
+
+    // Egy korábbi sikertelen kiírás után a puffer tele maradhat: újra próbáljuk, különben a rekord nem fér el
+    if (pendingCount >= MEMORY_WRITE_BATCH and !flush()) {
+        return false;
+    }
+
+    bool used = index[record.channel] != MEMORY_INDEX_NONE;
+    if (record.frequency == 0) {
+        index[record.channel] = MEMORY_INDEX_NONE;
+        channelCount -= used;
+    } else {
+        index[record.channel] = fileRecords + pendingCount;
+        channelCount += !used;
+    }
+    pending[pendingCount++] = record;
+    lastChangeMsec = millis();
+
+    // Megtelt egy flash lap: azonnal kiírjuk
+    if (pendingCount >= MEMORY_WRITE_BATCH) {
+        flush();
+    }
+    return true;
+}
+
+/**
+ * Csatorna mentése
+ */
+bool MemoryStore::save(const MemoryChannel_t &record) {
+    if (!mounted or record.channel >= MEMORY_MAX_CHANNELS or record.frequency == 0) {
+        return false;
+    }
+    return append(record);
+}
+
+/**
+ * Csatorna törlése
+ */
+bool MemoryStore::erase(uint16_t channel) {
+    if (!isUsed(channel)) {
+        return false;
+    }
+    MemoryChannel_t record = {};
+    record.channel = channel;
+    return append(record);
+}
+
+/**
+ * Egy rekord olvasása a sorszáma alapján (a pufferből vagy a fájlból)
+ */
+bool MemoryStore::readRecord(uint16_t recordIdx, MemoryChannel_t &out) {
+
+    if (recordIdx >= fileRecords) {
+        out = pending[recordIdx - fileRecords];
+        return true;
+    }
+
+    File file = LittleFS.open(MEMORY_FILE_NAME, "r");
+    if (!file) {
+        return false;
+    }
+    bool ok = file.seek(recordIdx * sizeof(MemoryChannel_t)) and file.read((uint8_t *)&out, sizeof(MemoryChannel_t)) == sizeof(MemoryChannel_t);
+    file.close();
+    return ok;
+}
+
+/**
+ * Csatorna visszahívása
+ */
+bool MemoryStore::recall(uint16_t channel, MemoryChannel_t &out) {
+    if (!isUsed(channel)) {
+        return false;
+    }
+    return readRecord(index[channel], out);
+}
+
+/**
+ * A puffer kiírása, ha letelt a várakozás
+ */
+void MemoryStore::service() {
+    if (pendingCount > 0 and millis() - lastChangeMsec >= MEMORY_FLUSH_DELAY_MSEC) {
+        flush();
+    }
+}
+
+/**
+ * A puffer kiírása a napló végére
+ */
+bool MemoryStore::flush() {
+
+    if (pendingCount == 0) {
+        return true;
+    }
+
+    File file = LittleFS.open(MEMORY_FILE_NAME, "a");
+    if (!file) {
+        DEBUG("MemoryStore: a napló nem nyitható meg írásra\n");
+        return false;
+    }
+    size_t size = pendingCount * sizeof(MemoryChannel_t);
+    bool ok = file.write((const uint8_t *)pending, size) == size;
+    file.close();
+    if (!ok) {
+        DEBUG("MemoryStore: hibás írás\n");
+        return false;
+    }
+
+    // A pufferre mutató index elemek a kiírással fájl sorszámok lettek (a sorszám folytonos)
+    fileRecords += pendingCount;
+    pendingCount = 0;
+
+    if (fileRecords >= MEMORY_LOG_MAX_RECORDS) {
+        compact();
+    }
+    return true;
+}
+
+/**
+ * A napló tömörítése: az élő rekordok új fájlba, csatorna sorrendben, majd csere
+ */
+bool MemoryStore::compact() {
+
+    uint32_t startMsec = millis();
+    File src = LittleFS.open(MEMORY_FILE_NAME, "r");
+    File dst = LittleFS.open(MEMORY_TEMP_FILE_NAME, "w");
+    if (!src or !dst) {
+        DEBUG("MemoryStore: a tömörítés nem indítható\n");
+        return false;
+    }
+
+    // Kötegenként írunk (egy köteg egy flash lap), a puffer ilyenkor üres (a flush() után, vagy induláskor)
+    MemoryChannel_t batch[MEMORY_WRITE_BATCH];
+    uint8_t batchCount = 0;
+    uint16_t written = 0;
+    bool ok = true;
+    for (uint16_t channel = 0; channel < MEMORY_MAX_CHANNELS and ok; channel++) {
+        if (index[channel] == MEMORY_INDEX_NONE) {
+            continue;
+        }
+        ok = src.seek(index[channel] * sizeof(MemoryChannel_t)) and src.read((uint8_t *)&batch[batchCount], sizeof(MemoryChannel_t)) == sizeof(MemoryChannel_t);
+        written++;
+        if (++batchCount == MEMORY_WRITE_BATCH) {
+            ok = ok and dst.write((const uint8_t *)batch, sizeof(batch)) == sizeof(batch);
+            batchCount = 0;
+        }
+    }
+    if (batchCount > 0) {
+        ok = ok and dst.write((const uint8_t *)batch, batchCount * sizeof(MemoryChannel_t)) == batchCount * sizeof(MemoryChannel_t);
+    }
+    src.close();
+    dst.close();
+
+    if (!ok) {
+        // A régi napló és az index érintetlen, a következő flush() újra próbálja
+        DEBUG("MemoryStore: hibás tömörítés\n");
+        LittleFS.remove(MEMORY_TEMP_FILE_NAME);
+        return false;
+    }
+
+    // A LittleFS rename() atomi, és felülírja a célt: tápvesztéskor vagy a régi, vagy az új napló marad meg
+    if (!LittleFS.rename(MEMORY_TEMP_FILE_NAME, MEMORY_FILE_NAME)) {
+        DEBUG("MemoryStore: a tömörített napló nem nevezhető át\n");
+        LittleFS.remove(MEMORY_TEMP_FILE_NAME);
+        return false;
+    }
+
+    // Az új fájlban az élő rekordok csatorna sorrendben, folytonosan következnek
+    uint16_t recordIdx = 0;
+    for (uint16_t channel = 0; channel < MEMORY_MAX_CHANNELS; channel++) {
+        if (index[channel] != MEMORY_INDEX_NONE) {
+            index[channel] = recordIdx++;
+        }
+    }
+    DEBUG("MemoryStore: tömörítés %u -> %u rekord, %lu msec\n", fileRecords, written, millis() - startMsec);
+    fileRecords = written;
+    return true;
+}
+
+/**
+ * A foglalt csatornák kiírása a soros portra
+ */
+void MemoryStore::dump() {
+
+    Serial.printf("===== Memory channels =====\n");
+    Serial.printf("Mounted: %s, channels: %u/%u, log records: %u, pending: %u\n", mounted ? "yes" : "no", channelCount, MEMORY_MAX_CHANNELS, fileRecords, pendingCount);
+    for (uint16_t channel = 0; channel < MEMORY_MAX_CHANNELS; channel++) {
+        MemoryChannel_t record;
+        if (recall(channel, record)) {
+            Serial.printf("%3u: %5u band %2u mode %u BFO %d BW %u '%.8s'\n", channel, record.frequency, record.bandIdx, record.mode, record.bfo, record.bandwidth, record.name);
+        }
+    }
+    Serial.printf("---\n");
+}
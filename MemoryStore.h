@@ -0,0 +1,121 @@
+#ifndef __MEMORYSTORE_H
+#define __MEMORYSTORE_H
+
+#include <Arduino.h>
+#include <LittleFS.h>
+
+#define MEMORY_FILE_NAME "/memory.bin"     // A memória csatornák napló fájlja (LittleFS)
+#define MEMORY_TEMP_FILE_NAME "/memory.tmp" // Tömörítéskor ide írjuk az élő rekordokat
+#define MEMORY_MAX_CHANNELS 500            // A memória csatornák száma
+#define MEMORY_NAME_LENGTH 8               // A csatorna neve (nem lezárt, '\0'-val kitöltve)
+#define MEMORY_WRITE_BATCH 16              // Ennyi rekordot gyűjtünk egy írásba (16 x 16 bájt = egy 256 bájtos flash lap)
+#define MEMORY_FLUSH_DELAY_MSEC 3000       // Az utolsó módosítás után ennyi idővel írjuk ki a nem teljes köteget
+#define MEMORY_LOG_MAX_RECORDS 2048        // Ennyi rekord (32kB) után a naplót tömörítjük (csak az élő rekordok maradnak)
+#define MEMORY_INDEX_NONE 0xFFFF           // Üres csatorna az indexben
+
+// Egy memória csatorna rekordja (packed: 16 bájt, fix szélességű)
+struct __attribute__((packed)) MemoryChannel_t {
+    uint16_t channel;              // A csatorna száma (0 .. MEMORY_MAX_CHANNELS - 1)
+    uint16_t frequency;            // Frekvencia a band egységében (FM: 10kHz, egyébként kHz), 0: törölt csatorna
+    int16_t bfo;                   // BFO (SSB)
+    uint8_t bandIdx;               // A Band tábla indexe
+    uint8_t mode : 3;              // Moduláció (FM, LSB, USB, AM, CW)
+    uint8_t bandwidth : 5;         // Sávszélesség index (a mód szerinti bwIdx*)
+    char name[MEMORY_NAME_LENGTH]; // Név
+};
+
+/**
+ * Memória csatornák a flash-ben (LittleFS)
+ *
+ * A csatornák egy csak hozzáírással bővülő napló fájlba kerülnek fix szélességű rekordokként, a későbbi rekord felülírja
+ * a korábbit (törlés: 0 frekvenciájú rekord). Induláskor egyszer végigolvassuk a naplót, és felépítjük a RAM indexet
+ * (csatorna -> rekord sorszám), így a visszahívás egyetlen seek + 16 bájtos olvasás (O(1)).
+ *
+ * Az írások kötegelve mennek: a módosítások egy RAM pufferbe kerülnek, és egy flash lapnyi (MEMORY_WRITE_BATCH rekord)
+ * után, vagy a service() hívásakor az utolsó módosítás után MEMORY_FLUSH_DELAY_MSEC-cel egyetlen írással kerülnek a fájl végére.
+ * A napló MEMORY_LOG_MAX_RECORDS rekord után tömörítődik (az élő rekordok új fájlba, majd átnevezés).
+ * Csak a core0 használja.
+ */
+class MemoryStore {
+
+private:
+    uint16_t index[MEMORY_MAX_CHANNELS]; // Csatorna -> rekord sorszám (a fájlban, vagy fileRecords felett a pufferben)
+    uint16_t fileRecords = 0;            // A fájlban lévő rekordok száma
+    uint16_t channelCount = 0;           // A foglalt csatornák száma
+    bool mounted = false;
+
+    MemoryChannel_t pending[MEMORY_WRITE_BATCH]; // Még ki nem írt rekordok
+    uint8_t pendingCount = 0;
+    uint32_t lastChangeMsec = 0;
+
+    bool append(const MemoryChannel_t &record);
+    bool readRecord(uint16_t recordIdx, MemoryChannel_t &out);
+    bool compact();
+
+public:
+    /**
+     * Konstruktor
+     */
+    MemoryStore() { memset(index, 0xFF, sizeof(index)); }
+
+    /**
+     * A fájlrendszer csatolása és az index felépítése a naplóból
+     * @return false, ha a fájlrendszer nem érhető el
+     */
+    bool begin();
+
+    /**
+     * Csatorna mentése (a kiírás kötegelve, később történik)
+     * @return false, ha a csatorna száma vagy a frekvencia érvénytelen, vagy a teli puffer nem írható ki
+     */
+    bool save(const MemoryChannel_t &record);
+
+    /**
+     * Csatorna törlése
+     * @return false, ha a csatorna üres, vagy a teli puffer nem írható ki
+     */
+    bool erase(uint16_t channel);
+
+    /**
+     * Csatorna visszahívása
+     * @return false, ha a csatorna üres
+     */
+    bool recall(uint16_t channel, MemoryChannel_t &out);
+
+    /**
+     * Csatolva van a fájlrendszer? (ha a flash-ben nincs LittleFS partíció, nem)
+     */
+    bool isMounted() const { return mounted; }
+
+    /**
+     * Foglalt a csatorna? (csak az index alapján, flash olvasás nélkül)
+     */
+    bool isUsed(uint16_t channel) const { return channel < MEMORY_MAX_CHANNELS and index[channel] != MEMORY_INDEX_NONE; }
+
+    /**
+     * A foglalt csatornák száma
+     */
+    uint16_t getCount() const { return channelCount; }
+
+    /**
+     * A napló rekordjainak száma (a puffert is beleértve)
+     */
+    uint16_t getLogRecords() const { return fileRecords + pendingCount; }
+
+    /**
+     * A puffer kiírása, ha az utolsó módosítás óta letelt a várakozás (a memory task hívja)
+     */
+    void service();
+
+    /**
+     * A puffer azonnali kiírása (egyetlen hozzáírás a fájl végére)
+     */
+    bool flush();
+
+    /**
+     * A foglalt csatornák kiírása a soros portra
+     */
+    void dump();
+};
+
+#endif // __MEMORYSTORE_H
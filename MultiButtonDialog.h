@@ -45,9 +45,8 @@ private:
     /**
      * @brief Gombok elhelyezése a dialóguson belül.
      */
-    void positionButtons(uint8_t buttonsPerRow, uint8_t rowCount) {
+    void positionButtons(uint8_t buttonsPerRow) {
         uint16_t buttonHeight = DLG_BTN_H;
-        uint16_t totalHeight = rowCount * buttonHeight + (rowCount - 1) * DLG_BTN_GAP;
 
         uint16_t startY = contentY;
         uint8_t row = 0, col = 0;
@@ -114,7 +113,7 @@ protected:
         uint16_t maxRowWidth = w - 20;
         uint8_t buttonsPerRow, rowCount;
         calculateButtonLayout(maxRowWidth, buttonsPerRow, rowCount);
-        positionButtons(buttonsPerRow, rowCount);
+        positionButtons(buttonsPerRow);
     }
 
     /**
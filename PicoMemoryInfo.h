@@ -1,6 +1,7 @@
 #ifndef __PICOMEMORYINFO_H
 #define __PICOMEMORYINFO_H
 
+#include "IdleManager.h"
 #include "utils.h"
 #include <RP2040Support.h>
 
@@ -108,7 +109,7 @@ MemoryStatus_t getMemoryStatus() {
     MemoryStatus_t status;
 
     // Flash memória méretének meghatározása
-    status.programSize = (uint32_t)&__flash_binary_end - 0x10000000;
+    status.programSize = (uintptr_t)&__flash_binary_end - 0x10000000;
     status.programPercent = (status.programSize * 100.0) / FULL_FLASH_SIZE;
     status.freeFlash = FULL_FLASH_SIZE - status.programSize;
     status.freeFlashPercent = 100.0 - status.programPercent;
@@ -162,6 +163,15 @@ void debugMemoryInfo() {
           usedHeapMemoryMonitor.index, MEASUREMENTS_COUNT                    // max grow
     );
 
+    // Alvás az előző kiírás óta (core-onként)
+    for (uint8_t core = 0; core < 2; core++) {
+        const IdleManager::IdleStats_t &idle = IdleManager::getStats(core);
+        DEBUG("Idle core%d: %.1f%%, wake-up latency avg: %lu usec, max: %lu usec\n",
+              core, IdleManager::getIdlePercent(core),
+              idle.wakeLatencyCount ? idle.wakeLatencySumUsec / idle.wakeLatencyCount : 0, idle.wakeLatencyMaxUsec);
+    }
+    IdleManager::resetStats();
+
     DEBUG("---\n");
     DEBUG("\n");
 }
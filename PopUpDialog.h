@@ -24,7 +24,7 @@ protected:
     /// @param okText Az OK gomb felirata.
     /// @param cancelText A Cancel gomb felirata (opcionális).
     PopUpDialog(TFT_eSPI &tft, uint16_t w, uint16_t h, const __FlashStringHelper *title, const __FlashStringHelper *message, ButtonCallback_t callback, const char *okText = "OK", const char *cancelText = nullptr)
-        : PopupBase(tft, w, h, title, message), callback(callback), cancelButton(nullptr) {
+        : PopupBase(tft, w, h, title, message), cancelButton(nullptr), callback(callback) {
 
         // Kiszedjük a legnagyobb gomb felirat szélességét (10-10 pixel a szélén)
         uint8_t okButtonWidth = tft.textWidth(okText) + DIALOG_DEFAULT_BUTTON_TEXT_PADDING_X;                          // OK gomb szöveg szélessége + padding a gomb széleihez
@@ -47,7 +47,7 @@ protected:
      * @param title A dialógus címe (opcionális).
      */
     PopupBase(TFT_eSPI &tft, uint16_t w, uint16_t h, const __FlashStringHelper *title, const __FlashStringHelper *message = nullptr)
-        : tft(tft), w(w), h(h), title(title), message(message), visible(false) {
+        : title(title), message(message), tft(tft), w(w), h(h), visible(false) {
 
         // Dialóg bal felső sarkának kiszámítása a képernyő középre igzaításához
         x = (tft.width() - w) / 2;
@@ -111,7 +111,7 @@ public:
     /// @param touched Jelzi, hogy történt-e érintési esemény.
     /// @param tx Az érintési esemény x-koordinátája.
     /// @param ty Az érintési esemény y-koordinátája.
-    virtual void handleTouch(bool touched, uint16_t tx, uint16_t ty) {}
+    virtual void handleTouch(bool /*touched*/, uint16_t /*tx*/, uint16_t /*ty*/) {}
 
 protected:
     /**
@@ -0,0 +1,142 @@
+#include "PropertyShadow.h"
+
+/**
+ * Property keresése az árnyékban
+ * @return az index, vagy -1, ha nincs megjegyezve
+ */
+int8_t PropertyShadow::find(uint16_t id) const {
+    for (uint8_t i = 0; i < count; i++) {
+        if (entries[i].id == id) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+/**
+ * A chipben lévő érték megjegyzése
+ */
+void PropertyShadow::record(uint16_t id, uint16_t value) {
+
+    int8_t idx = find(id);
+    if (idx >= 0) {
+        entries[idx].value = value;
+        return;
+    }
+
+    // Betelt: nem jegyezzük meg, legközelebb is kiírjuk (csak a megtakarítás marad el)
+    if (count < PROPERTY_SHADOW_SIZE) {
+        entries[count++] = {id, value};
+    }
+}
+
+/**
+ * Property írása, ha az eltér a chipben lévőtől
+ */
+bool PropertyShadow::setProperty(uint16_t id, uint16_t value) {
+
+    if (matches(id, value)) {
+        stats.writeHits++;
+        stats.savedBytes += PROPERTY_SHADOW_SET_BYTES;
+        return false;
+    }
+
+    si4735.setProperty(id, value);
+    record(id, value);
+    stats.writeMisses++;
+    return true;
+}
+
+/**
+ * Property olvasása: ha ismert, a RAM-ból, különben a chipből
+ */
+uint16_t PropertyShadow::getProperty(uint16_t id) {
+
+    int8_t idx = find(id);
+    if (idx >= 0) {
+        stats.readHits++;
+        stats.savedBytes += PROPERTY_SHADOW_GET_BYTES;
+        return entries[idx].value;
+    }
+
+    uint16_t value = si4735.getProperty(id);
+    record(id, value);
+    stats.readMisses++;
+    return value;
+}
+
+/**
+ * Hangerő beállítása, ha változott
+ * A library setVolume()-ját hívjuk, hogy a saját hangerő változója is szinkronban maradjon
+ */
+bool PropertyShadow::setVolume(uint8_t volume) {
+
+    if (matches(SI473X_PROP_RX_VOLUME, volume)) {
+        stats.writeHits++;
+        stats.savedBytes += PROPERTY_SHADOW_SET_BYTES;
+        return false;
+    }
+
+    si4735.setVolume(volume);
+    record(SI473X_PROP_RX_VOLUME, volume);
+    stats.writeMisses++;
+    return true;
+}
+
+/**
+ * AGC beállítása, ha változott
+ */
+bool PropertyShadow::setAutomaticGainControl(uint8_t disable, uint8_t index) {
+
+    uint16_t state = (disable << 8) | index;
+    if (agcState == state) {
+        stats.writeHits++;
+        stats.savedBytes += PROPERTY_SHADOW_AGC_BYTES;
+        return false;
+    }
+
+    si4735.setAutomaticGainControl(disable, index);
+    agcState = state;
+    stats.writeMisses++;
+    return true;
+}
+
+/**
+ * Minden megjegyzett érték elfelejtése (POWER_UP, reset után)
+ */
+void PropertyShadow::invalidate() {
+    count = 0;
+    agcState = PROPERTY_SHADOW_AGC_UNKNOWN;
+    stats.invalidations++;
+}
+
+/**
+ * Statisztika törlése
+ */
+void PropertyShadow::resetStats() {
+    stats = {};
+    stats.sinceMsec = millis();
+}
+
+/**
+ * Statisztika kiírása a soros portra
+ */
+void PropertyShadow::debugStats() {
+
+    uint32_t elapsedMsec = millis() - stats.sinceMsec;
+    uint32_t writes = stats.writeHits + stats.writeMisses;
+    uint32_t reads = stats.readHits + stats.readMisses;
+
+    // A megtakarított buszidő: 9 bit (8 adat + ACK) bájtonként a normál órajelen
+    float savedMsec = stats.savedBytes * 9 * 1000.0f / PROPERTY_SHADOW_I2C_HZ;
+
+    Serial.printf("===== Property shadow =====\n");
+    Serial.printf("Entries: %u/%u, invalidations: %lu\n", count, PROPERTY_SHADOW_SIZE, stats.invalidations);
+    Serial.printf("Writes: %lu, skipped: %lu (%.1f%%)\n", writes, stats.writeHits, writes ? stats.writeHits * 100.0f / writes : 0.0f);
+    Serial.printf("Reads: %lu, from RAM: %lu (%.1f%%)\n", reads, stats.readHits, reads ? stats.readHits * 100.0f / reads : 0.0f);
+    Serial.printf("Saved I2C: %lu bytes, ~%.1f msec", stats.savedBytes, savedMsec);
+    if (elapsedMsec >= 1000) {
+        Serial.printf(" (~%.1f msec/hour)", savedMsec * 3600000.0f / elapsedMsec);
+    }
+    Serial.printf("\n---\n");
+}
@@ -0,0 +1,122 @@
+#ifndef __PROPERTYSHADOW_H
+#define __PROPERTYSHADOW_H
+
+#include <Arduino.h>
+#include <SI4735.h>
+
+#define PROPERTY_SHADOW_SIZE 32 // A megjegyzett property-k max. száma (statikus tábla)
+
+// A megtakarított buszidő becsléséhez (cím + parancs + válasz + CTS olvasás bájtokban, a mock könyvelése szerint)
+#define PROPERTY_SHADOW_SET_BYTES 9  // SET_PROPERTY
+#define PROPERTY_SHADOW_GET_BYTES 12 // GET_PROPERTY
+#define PROPERTY_SHADOW_AGC_BYTES 6  // AM/FM_AGC_OVERRIDE
+#define PROPERTY_SHADOW_I2C_HZ 100000 // Normál I2C órajel (a patch letöltésen kívül ezen megy a forgalom)
+
+#define SI473X_PROP_RX_VOLUME 0x4000 // Hangerő property
+
+#define PROPERTY_SHADOW_AGC_UNKNOWN 0xFFFF // Az AGC állapota nem ismert (POWER_UP után még nem írtuk)
+
+// Egy property és az értéke
+struct PropertyValue_t {
+    uint16_t id;
+    uint16_t value;
+};
+
+// Találati statisztika
+typedef struct {
+    uint32_t writeHits;     // Kihagyott (redundáns) írások
+    uint32_t writeMisses;   // Kiírt értékek
+    uint32_t readHits;      // RAM-ból kiszolgált olvasások
+    uint32_t readMisses;    // A chipből olvasott értékek
+    uint32_t invalidations; // POWER_UP/reset miatti érvénytelenítések
+    uint32_t savedBytes;    // Megtakarított I2C bájtok
+    uint32_t sinceMsec;     // A statisztika kezdete
+} PropertyShadowStats_t;
+
+/**
+ * Az SI4735 property-jeinek árnyéka
+ *
+ * Megjegyzi a chipbe utoljára írt (vagy onnan olvasott) property értékeket: ha a chipben már a kívánt érték van,
+ * az írás (SET_PROPERTY, I2C) elmarad, az ismert property-k olvasása pedig a RAM-ból megy.
+ * A hangerő és az AGC (ami parancs, nem property) is ezen keresztül megy.
+ * A POWER_UP (és a reset) a chip property-jeit alapértékre állítja, ilyenkor az árnyékot érvényteleníteni kell.
+ * Mindig csak az SI4735 tulajdonosa (a start() után a core1) használhatja!
+ */
+class PropertyShadow {
+
+private:
+    SI4735 &si4735;
+
+    PropertyValue_t entries[PROPERTY_SHADOW_SIZE];
+    uint8_t count = 0;
+    uint16_t agcState = PROPERTY_SHADOW_AGC_UNKNOWN; // AGCDIS << 8 | AGCIDX
+
+    PropertyShadowStats_t stats = {};
+
+    int8_t find(uint16_t id) const;
+    void record(uint16_t id, uint16_t value);
+
+public:
+    /**
+     * Konstruktor
+     */
+    PropertyShadow(SI4735 &si4735) : si4735(si4735) {}
+
+    /**
+     * Az árnyék szerint a chipben pont ez az érték van?
+     */
+    bool matches(uint16_t id, uint16_t value) const {
+        int8_t idx = find(id);
+        return idx >= 0 and entries[idx].value == value;
+    }
+
+    /**
+     * Property írása, ha az eltér a chipben lévőtől
+     * @return true, ha ki kellett írni
+     */
+    bool setProperty(uint16_t id, uint16_t value);
+
+    /**
+     * Property olvasása: ha ismert, a RAM-ból, különben a chipből (és megjegyezzük)
+     */
+    uint16_t getProperty(uint16_t id);
+
+    /**
+     * Hangerő beállítása (RX_VOLUME), ha változott
+     */
+    bool setVolume(uint8_t volume);
+
+    /**
+     * AGC beállítása (AM/FM_AGC_OVERRIDE), ha változott
+     * @param disable 1 = AGC tiltva (kézi erősítés)
+     * @param index a kézi csillapítás indexe
+     */
+    bool setAutomaticGainControl(uint8_t disable, uint8_t index);
+
+    /**
+     * Minden megjegyzett érték elfelejtése (POWER_UP, reset után)
+     */
+    void invalidate();
+
+    /**
+     * Megjegyzett property-k száma
+     */
+    uint8_t getCount() const { return count; }
+
+    /**
+     * Találati statisztika
+     */
+    const PropertyShadowStats_t &getStats() const { return stats; }
+
+    /**
+     * Statisztika törlése
+     */
+    void resetStats();
+
+    /**
+     * Statisztika kiírása a soros portra
+     */
+    void debugStats();
+};
+
+#endif // __PROPERTYSHADOW_H
@@ -0,0 +1,641 @@
+#include "RadioService.h"
+#include "I2cClockTuner.h"
+#include "IdleManager.h"
+#include "LoopProfiler.h"
+#include "RuntimeVars.h"
+#include "Squelch.h"
+
+std::atomic<bool> RadioService::irqPending{false};
+
+/**
+ * Konstruktor
+ */
+RadioService::RadioService(SI4735 &si4735, Band &band, Config &config, I2cClockStore &i2cClockStore)
+    : si4735(si4735), band(band), config(config), i2cClockStore(i2cClockStore), signalCache(si4735), bandScope(si4735, band, config), stationScanner(si4735, band, config) {
+    memset(&work, 0, sizeof(work));
+}
+
+/**
+ * A szolgáltatás indítása (core0)
+ */
+void RadioService::start() {
+
+    // Az első pillanatképet még a core0 készíti, így a képernyő első kirajzolásához már van adat
+    work.frequency = si4735.getFrequency();
+    work.signal = signalCache.get(0);
+    publish();
+
+    lastRdsPollMsec = millis();
+
+    // Innentől a core1 kezeli a chipet
+    started.store(true, std::memory_order_release);
+    IdleManager::wakeOtherCore();
+}
+
+/**
+ * GPO2/INT megszakítás kezelő: csak jelez a core1-nek, I2C-hez itt nem nyúlhatunk
+ */
+void RadioService::irqHandler() {
+    irqPending.store(true, std::memory_order_release);
+    IdleManager::wakeOtherCore();
+}
+
+/**
+ * A GPO2/INT megszakítás használata (core0, a start() előtt)
+ */
+void RadioService::enableInterrupt(uint8_t pin) {
+
+    irqPin = pin;
+    pinMode(pin, INPUT_PULLUP);
+    attachInterrupt(digitalPinToInterrupt(pin), irqHandler, FALLING);
+    configureInterrupt();
+
+    DEBUG("RadioService: GPO2/INT megszakítás a GPIO%d lábon\n", pin);
+}
+
+/**
+ * A megszakítás források beállítása a chipben (a POWER_UP törli a property-ket, ezért band váltás után újra kell)
+ */
+void RadioService::configureInterrupt() {
+
+    // RDS: megszakítás, ha legalább RADIO_RDS_IRQ_FIFO_COUNT csoport van a FIFO-ban
+    uint16_t sources = SI473X_GPO_IEN_RSQIEN;
+    if (band.currentMode == FM) {
+        band.getPropertyShadow().setProperty(SI473X_PROP_FM_RDS_INT_SOURCE, SI473X_RDS_INT_RDSRECV);
+        band.getPropertyShadow().setProperty(SI473X_PROP_FM_RDS_INT_FIFO_COUNT, RADIO_RDS_IRQ_FIFO_COUNT);
+        sources |= SI473X_GPO_IEN_RDSIEN;
+    }
+
+    // RSQ: a zajzár küszöbét az aktuális jelszinthez képest élesítjük
+    const SignalQuality_t &signal = signalCache.forceRefresh(true);
+    armSignalThreshold((config.data.squelchUsesRSSI ? signal.rssi : signal.snr) >= config.data.currentSquelch);
+
+    band.getPropertyShadow().setProperty(SI473X_PROP_GPO_IEN, sources);
+}
+
+/**
+ * Parancs küldése a core1-nek
+ */
+bool RadioService::postCommand(CommandType type, int32_t param) {
+    if (!commandQueue.push({type, param})) {
+        DEBUG("RadioService: a parancs sor megtelt, parancs eldobva: %d\n", type);
+        return false;
+    }
+    IdleManager::wakeOtherCore();
+    return true;
+}
+
+/**
+ * Memória csatorna visszahívása (core0)
+ * A rekord nem fér a parancs paraméterébe: a postafiókba tesszük, a core1 a parancs végrehajtásakor veszi ki
+ */
+bool RadioService::recallMemory(const MemoryChannel_t &record) {
+    memoryRecall.write(record);
+    return postCommand(RECALL_MEMORY);
+}
+
+/**
+ * Hány msec múlva van legközelebb teendője a core1-nek
+ */
+uint32_t RadioService::getMsecToNextWork() const {
+
+    // SSB patch betöltés: a következő lépésig (letöltés közben azonnal)
+    if (band.isSSBLoading()) {
+        return band.getSSBLoadWaitMsec();
+    }
+
+    // Függő munka: parancs, band scope sweep, állomás keresés, jelminőség igény vagy nyugtázatlan megszakítás
+    if (!commandQueue.isEmpty() or bandScope.isRunning() or stationScanner.isRunning() or signalRequestMaxAge.load(std::memory_order_relaxed) != RADIO_SIGNAL_NO_REQUEST
+        or (isInterruptEnabled() and (irqPending.load(std::memory_order_relaxed) or digitalRead(irqPin) == LOW))) {
+        return 0;
+    }
+
+    // Megszakítás módban, vagy ha nem FM, akkor nincs polling
+    if (!isStarted() or isInterruptEnabled() or band.currentMode != FM) {
+        return UINT32_MAX;
+    }
+
+    uint32_t elapsed = millis() - lastRdsPollMsec;
+    return elapsed >= RADIO_RDS_POLL_MSEC ? 0 : RADIO_RDS_POLL_MSEC - elapsed;
+}
+
+/**
+ * Jelminőség lekérése (core0)
+ */
+bool RadioService::getSignalQuality(SignalQuality_t &out, uint16_t maxAgeMsec) {
+
+    RadioSnapshot_t current;
+    snapshot.read(current);
+    out = current.signal;
+
+    if (out.timestamp != 0 and millis() - out.timestamp <= maxAgeMsec) {
+        return true;
+    }
+
+    // Túl régi: frissítést kérünk, több igény közül a legszigorúbb marad meg
+    uint16_t pending = signalRequestMaxAge.load(std::memory_order_relaxed);
+    while (maxAgeMsec < pending and !signalRequestMaxAge.compare_exchange_weak(pending, maxAgeMsec, std::memory_order_release)) {
+    }
+    IdleManager::wakeOtherCore();
+
+    return false;
+}
+
+/**
+ * A szolgáltatás ciklusa (core1)
+ */
+void RadioService::loop() {
+
+    if (!isStarted()) {
+        return;
+    }
+
+    // SSB patch betöltés közben a chip mást nem fogad: a parancsok és igények várnak
+    if (band.isSSBLoading()) {
+        serviceSSBLoad();
+        return;
+    }
+
+    // Parancsok végrehajtása
+    // Az egymást követő TUNE_STEPS parancsokat (pl.: gyors tekerés egy hangolás ideje alatt) összevonjuk: egyetlen hangolás a végső frekvenciára
+    Command_t command;
+    int32_t tuneSteps = 0;
+    while (commandQueue.pop(command)) {
+        PROFILE_STAGE_CORE1(STAGE_RADIO_CMD);
+        if (command.type == TUNE_STEPS) {
+            tuneSteps += command.param;
+            continue;
+        }
+        if (tuneSteps != 0) {
+            executeCommand({TUNE_STEPS, tuneSteps});
+            tuneSteps = 0;
+        }
+        executeCommand(command);
+    }
+    if (tuneSteps != 0) {
+        PROFILE_STAGE_CORE1(STAGE_RADIO_CMD);
+        executeCommand({TUNE_STEPS, tuneSteps});
+    }
+
+    // Band scope: a chip a sweep-é, a jelminőség igények és az RDS a leállításig várnak
+    if (bandScope.isRunning()) {
+        PROFILE_STAGE_CORE1(STAGE_RADIO_SCOPE);
+        bandScope.service();
+        return;
+    }
+
+    // Állomás keresés: ugyanígy, a végén a legerősebb állomáson állunk
+    if (stationScanner.isRunning()) {
+        PROFILE_STAGE_CORE1(STAGE_RADIO_SCOPE);
+        stationScanner.service();
+        if (!stationScanner.isRunning()) {
+            onTuned();
+        }
+        return;
+    }
+
+    uint32_t now = millis();
+
+    // Jelminőség (csak ha van függő igény)
+    uint16_t maxAge = signalRequestMaxAge.exchange(RADIO_SIGNAL_NO_REQUEST, std::memory_order_acquire);
+    if (maxAge != RADIO_SIGNAL_NO_REQUEST) {
+        updateSignalQuality(maxAge);
+    }
+
+    // Megszakítás módban nincs polling
+    // A flag mellett a láb szintjét is nézzük: ha egy él elveszne, a nyugtázatlan megszakítás akkor sem ragad be
+    if (isInterruptEnabled()) {
+        if (irqPending.exchange(false, std::memory_order_acquire) or digitalRead(irqPin) == LOW) {
+            serviceInterrupt();
+        }
+        return;
+    }
+
+    // RDS
+    if (band.currentMode == FM and now - lastRdsPollMsec >= RADIO_RDS_POLL_MSEC) {
+        lastRdsPollMsec = now;
+        {
+            PROFILE_STAGE_CORE1(STAGE_RADIO_RDS);
+            if (pollRds()) {
+                decodeRds();
+            }
+        }
+        publish();
+    }
+}
+
+/**
+ * Parancs végrehajtása (core1)
+ */
+void RadioService::executeCommand(const Command_t &command) {
+
+    // Hangolás és band váltás előtt a sweep-et és a keresést leállítjuk (visszahangolnak az eredeti frekvenciára)
+    if (command.type != SET_MUTE) {
+        bool wasRunning = bandScope.isRunning() or stationScanner.isRunning();
+        if (command.type != SCOPE_START) {
+            bandScope.stop();
+        }
+        if (command.type != SCAN_START) {
+            stationScanner.stop();
+        }
+        if (wasRunning and (command.type == SCOPE_STOP or command.type == SCAN_STOP)) {
+            onTuned();
+        }
+    }
+
+    switch (command.type) {
+    case FREQUENCY_UP:
+        si4735.frequencyUp();
+        onTuned();
+        break;
+
+    case FREQUENCY_DOWN:
+        si4735.frequencyDown();
+        onTuned();
+        break;
+
+    case SET_FREQUENCY:
+        si4735.setFrequency(command.param);
+        onTuned();
+        break;
+
+    case SET_MUTE:
+        si4735.setAudioMute(command.param);
+        break;
+
+    case SET_BAND:
+        if (command.param < 0 or command.param >= band.getBandCount()) {
+            break;
+        }
+        switchBand(command.param);
+        break;
+
+    case TUNE_KHZ: {
+        int8_t bandIdx = band.findBandByKHz(command.param);
+        if (bandIdx < 0) {
+            DEBUG("RadioService: %ld kHz egyik band-be sem esik\n", command.param);
+            break;
+        }
+        tuneBand(bandIdx, band.fromKHz(bandIdx, command.param));
+        break;
+    }
+
+    case TUNE_BAND: {
+        uint8_t bandIdx = command.param >> 16;
+        uint16_t frequency = command.param & 0xFFFF;
+        if (bandIdx >= band.getBandCount() or frequency < band.getBandDesc(bandIdx).minimumFreq or frequency > band.getBandDesc(bandIdx).maximumFreq) {
+            break;
+        }
+        tuneBand(bandIdx, frequency);
+        break;
+    }
+
+    case TUNE_STEPS:
+        si4735.setFrequency(band.getStepFrequency(si4735.getCurrentFrequency(), command.param));
+        onTuned();
+        break;
+
+    case RECALL_MEMORY: {
+        MemoryChannel_t record;
+        memoryRecall.read(record);
+        if (record.bandIdx >= band.getBandCount() or record.frequency < band.getBandDesc(record.bandIdx).minimumFreq or record.frequency > band.getBandDesc(record.bandIdx).maximumFreq) {
+            break;
+        }
+        applyMemory(record);
+        break;
+    }
+
+    case SCOPE_START:
+        bandScope.start();
+        break;
+
+    case SCAN_START:
+        // A seek a patch-csel (szinkron AM) nem működik: a keresés előtt sima AM-be indítjuk újra a chipet
+        // (a patch a következő SSB band-nél újra letöltődik)
+        if (band.currentMode == AM and band.isSSBLoaded()) {
+            band.invalidateChip();
+            band.BandSet();
+            onBandReady();
+        }
+        stationScanner.start();
+        break;
+
+    case SCOPE_STOP:
+    case SCAN_STOP:
+        break; // Már leállítottuk
+
+    default:
+        DEBUG("RadioService: ismeretlen parancs: %d\n", command.type);
+        break;
+    }
+}
+
+/**
+ * Band váltás (core1)
+ */
+void RadioService::switchBand(uint8_t bandIdx) {
+
+    // A BFO band-enként megmarad (a BandStore menti)
+    {
+        Band::StateLock lock(band);
+        BandState_t &oldState = band.getBandState(config.data.bandIdx);
+        oldState.lastBFO = config.data.currentBFO;
+        oldState.lastmanuBFO = config.data.currentBFOmanu;
+    }
+    const BandState_t &newState = band.getBandState(bandIdx); // Csak a core1 írja, olvasni zár nélkül is lehet
+    {
+        // A band index és a BFO együtt változik: a core0 mentése nem láthatja félkészen
+        Config::UpdateLock lock(config);
+        config.data.currentBFO = newState.lastBFO;
+        config.data.currentBFOmanu = newState.lastmanuBFO;
+        config.data.bandIdx = bandIdx;
+    }
+    if (band.BandSet(true)) {
+        onBandReady();
+    } else {
+        // SSB patch betöltés indult, a loop() lépésenként folytatja
+        ssbLoadProgress.store(0, std::memory_order_relaxed);
+    }
+}
+
+/**
+ * Hangolás a megadott band-en, ha kell, band váltással (core1)
+ */
+void RadioService::tuneBand(uint8_t bandIdx, uint16_t frequency) {
+    if (bandIdx == config.data.bandIdx) {
+        si4735.setFrequency(frequency);
+        onTuned();
+    } else {
+        // A band váltás a band állapotában tárolt frekvenciára hangol
+        {
+            Band::StateLock lock(band);
+            band.getBandState(bandIdx).currentFreq = frequency;
+        }
+        switchBand(bandIdx);
+    }
+}
+
+/**
+ * Memória csatorna beállítása (core1)
+ * A band váltás (az aktuális band-en is) a band állapotából és a beállításokból építi fel a chip profilját,
+ * így a frekvenciát, a BFO-t és a sávszélességet előtte, a zárak alatt írjuk be
+ */
+void RadioService::applyMemory(const MemoryChannel_t &record) {
+    {
+        Band::StateLock lock(band);
+        BandState_t &state = band.getBandState(record.bandIdx);
+        state.currentFreq = record.frequency;
+        state.lastBFO = record.bfo;
+    }
+    {
+        // A switchBand() az aktuális band BFO-ját előbb visszamenti: ugyanazon a band-en ez már a csatornáé legyen
+        Config::UpdateLock lock(config);
+        if (record.bandIdx == config.data.bandIdx) {
+            config.data.currentBFO = record.bfo;
+        }
+        if (record.mode == FM) {
+            config.data.bwIdxFM = record.bandwidth;
+        } else if (record.mode == AM) {
+            config.data.bwIdxAM = record.bandwidth;
+        } else {
+            config.data.bwIdxSSB = record.bandwidth;
+        }
+    }
+    band.setModeOverride(record.bandIdx, record.mode);
+    switchBand(record.bandIdx);
+}
+
+/**
+ * Band váltás után: a POWER_UP alapértékre állította a hangerőt és a megszakítás forrásokat
+ */
+void RadioService::onBandReady() {
+    band.getPropertyShadow().setVolume(config.data.currentVOL);
+    if (isInterruptEnabled()) {
+        configureInterrupt();
+    }
+    onTuned();
+    bandReadyCount.fetch_add(1, std::memory_order_release);
+}
+
+/**
+ * Az SSB patch betöltés következő lépése (core1)
+ */
+void RadioService::serviceSSBLoad() {
+
+    bool done;
+    {
+        PROFILE_STAGE_CORE1(STAGE_RADIO_CMD);
+        done = band.serviceSSBLoad();
+    }
+
+    if (done) {
+        ssbLoadProgress.store(RADIO_SSB_LOAD_IDLE, std::memory_order_relaxed);
+        if (checkPatchErrors()) {
+            return; // A patch újratöltése indult
+        }
+        onBandReady();
+    } else {
+        ssbLoadProgress.store(band.getSSBLoadProgress(), std::memory_order_relaxed);
+    }
+}
+
+/**
+ * Patch letöltés után: ha a chip ismétlődően hibát jelez, a biztonságos I2C órajelre váltunk, és újratöltjük a patch-et (core1)
+ * A kalibrálás csak a setup()-ban futhat, ezért a kalibrált értéket töröljük: a következő induláskor újrakalibrálunk
+ * @return true, ha a band beállítása újraindult
+ */
+bool RadioService::checkPatchErrors() {
+
+    uint32_t errors = band.getSwitchStats().patchStatusErrors;
+    if (errors == lastPatchStatusErrors) {
+        patchErrorRun = 0;
+        return false;
+    }
+    lastPatchStatusErrors = errors;
+    if (++patchErrorRun < RADIO_I2C_FALLBACK_ERRORS or getI2cClock() <= I2C_CLOCK_SAFE_HZ) {
+        return false;
+    }
+
+    DEBUG("RadioService: %u hibás patch letöltés %lu Hz-en, vissza %d Hz-re\n", patchErrorRun, getI2cClock(), I2C_CLOCK_SAFE_HZ);
+    patchErrorRun = 0;
+    setI2cClock(I2C_CLOCK_SAFE_HZ);
+    i2cClockStore.set(I2C_CLOCK_UNCALIBRATED); // A mentés a core0 dolga (EEPROM task)
+
+    // A chipben lévő patch nem megbízható: újraindítás és újratöltés az aktuális band-en
+    band.invalidateChip();
+    switchBand(config.data.bandIdx);
+    return true;
+}
+
+/**
+ * Hangolás után a frekvencia visszaolvasása és az RDS adatok törlése
+ */
+void RadioService::onTuned() {
+
+    work.frequency = si4735.getFrequency();
+
+    // Eltesszük a Band táblába is (a kijelző zár nélkül olvassa, a 16 bites írás atomi; a BandStore a zár alatt másol)
+    {
+        Band::StateLock lock(band);
+        band.getBandState(config.data.bandIdx).currentFreq = work.frequency;
+    }
+
+    if (band.currentMode == FM) {
+        si4735.RdsInit(); // A korábbi állomás RDS puffereinek törlése
+    }
+    clearRds();
+
+    // Az új frekvencián a korábbi jelminőség már nem érvényes, a következő igény frissíti
+    signalCache.invalidate();
+    work.signal.timestamp = 0;
+
+    publish();
+}
+
+/**
+ * Jelminőség frissítése a cache-ből és publikálása, ha új adat jött a chipből
+ */
+void RadioService::updateSignalQuality(uint16_t maxAgeMsec) {
+
+    uint32_t prevTimestamp = work.signal.timestamp;
+    {
+        PROFILE_STAGE_CORE1(STAGE_RADIO_RSQ);
+        work.signal = signalCache.get(maxAgeMsec);
+    }
+
+    if (work.signal.timestamp != prevTimestamp) {
+        publish();
+    }
+}
+
+/**
+ * A függő megszakítások kiszolgálása (core1)
+ */
+void RadioService::serviceInterrupt() {
+
+    si473x_status status = si4735.getInterruptStatus();
+
+    // RDS: a FIFO teljes kiürítése (minden getRdsStatus() egy csoportot vesz ki)
+    if (status.resp.RDSINT) {
+        PROFILE_STAGE_CORE1(STAGE_RADIO_RDS);
+        uint8_t groups = 0;
+        do {
+            pollRds(1);
+        } while (si4735.getNumRdsFifoUsed() > 0 and ++groups < RADIO_RDS_MAX_DRAIN);
+        decodeRds();
+    }
+
+    // RSQ: a zajzár küszöbét átlépte a jel, frissítünk és a másik irányra élesítünk
+    if (status.resp.RSQINT) {
+        PROFILE_STAGE_CORE1(STAGE_RADIO_RSQ);
+        work.signal = signalCache.forceRefresh(true);
+        armSignalThreshold((config.data.squelchUsesRSSI ? work.signal.rssi : work.signal.snr) >= config.data.currentSquelch);
+    }
+
+    if (status.resp.RDSINT or status.resp.RSQINT) {
+        publish();
+    }
+}
+
+/**
+ * Az RSQ megszakítás küszöbének élesítése a zajzár szintjére
+ * Ha van jel, akkor a zárási küszöb alá esést, ha nincs, akkor a nyitási küszöb elérését figyeljük, így nem jön folyamatosan megszakítás
+ * @param signalPresent a jel most a zajzár szintje felett van?
+ */
+void RadioService::armSignalThreshold(bool signalPresent) {
+
+    uint16_t base = band.currentMode == FM ? SI473X_PROP_FM_RSQ_INT_SOURCE : SI473X_PROP_AM_RSQ_INT_SOURCE;
+    uint8_t squelch = config.data.currentSquelch;
+
+    // Nincs zajzár -> nincs RSQ megszakítás sem
+    if (squelch == 0) {
+        band.getPropertyShadow().setProperty(base, 0);
+        return;
+    }
+
+    bool rssi = config.data.squelchUsesRSSI;
+    if (signalPresent) {
+        band.getPropertyShadow().setProperty(base + (rssi ? SI473X_RSQ_RSSI_LO_OFFSET : SI473X_RSQ_SNR_LO_OFFSET), Squelch::getCloseThreshold(squelch));
+        band.getPropertyShadow().setProperty(base, rssi ? SI473X_RSQ_INT_RSSILIEN : SI473X_RSQ_INT_SNRLIEN);
+    } else {
+        band.getPropertyShadow().setProperty(base + (rssi ? SI473X_RSQ_RSSI_HI_OFFSET : SI473X_RSQ_SNR_HI_OFFSET), squelch - 1);
+        band.getPropertyShadow().setProperty(base, rssi ? SI473X_RSQ_INT_RSSIHIEN : SI473X_RSQ_INT_SNRHIEN);
+    }
+}
+
+/**
+ * A könyvtár az utolsó FM_RDS_STATUS választ (a nyers A-D blokkokat és a blokk hibákat) csak egy protected tagban tartja,
+ * a getRdsText*() getterek pedig csak a PS/RT-t adják vissza: a tagot egy leszármazott osztály tag pointerével érjük el
+ */
+struct Si4735RdsStatusAccess : SI4735 {
+    static const si47x_rds_status &get(SI4735 &si4735) { return si4735.*(&Si4735RdsStatusAccess::currentRdsStatus); }
+};
+
+/**
+ * Egy RDS csoport kiolvasása a chip FIFO-jából a dekóder pufferébe
+ * @param intAck a függő RDS megszakítás nyugtázása
+ * @return true, ha jött csoport
+ */
+bool RadioService::pollRds(uint8_t intAck) {
+
+    si4735.getRdsStatus(intAck);
+
+    // Az INTACK a latch-elt RDSRECV/RDSSYNCFOUND biteket is törli, ezért megszakításos módban
+    // csak az aktuális szinkront nézzük; a FIFO szintjét ott a hívó (serviceInterrupt) ellenőrzi
+    bool valid = intAck ? si4735.getRdsSync() : si4735.getRdsReceived() and si4735.getRdsSync() and si4735.getRdsSyncFound();
+    if (!valid) {
+        return false;
+    }
+
+    work.rdsAvailable = true;
+
+    const si47x_rds_status &status = Si4735RdsStatusAccess::get(si4735);
+    RdsGroup_t group;
+    group.blocks[0] = (status.resp.BLOCKAH << 8) | status.resp.BLOCKAL;
+    group.blocks[1] = (status.resp.BLOCKBH << 8) | status.resp.BLOCKBL;
+    group.blocks[2] = (status.resp.BLOCKCH << 8) | status.resp.BLOCKCL;
+    group.blocks[3] = (status.resp.BLOCKDH << 8) | status.resp.BLOCKDL;
+    group.errors = (status.resp.BLEA << 6) | (status.resp.BLEB << 4) | (status.resp.BLEC << 2) | status.resp.BLED;
+    rdsDecoder.push(group);
+    return true;
+}
+
+/**
+ * A kiolvasott csoportok dekódolása, a mezők átmásolása a munkapéldányba
+ */
+void RadioService::decodeRds() {
+    if (rdsDecoder.process() > 0) {
+        work.rds = rdsDecoder.getState();
+        pendingRdsChanges |= rdsDecoder.takeChanges();
+    }
+}
+
+/**
+ * RDS adatok törlése a munkapéldányban és a dekóderben
+ */
+void RadioService::clearRds() {
+    rdsDecoder.reset();
+    work.rdsAvailable = false;
+    work.rds = rdsDecoder.getState();
+    pendingRdsChanges |= rdsDecoder.takeChanges();
+}
+
+/**
+ * A munkapéldány publikálása
+ */
+void RadioService::publish() {
+    work.timestamp = millis();
+
+    // A band állapotot a core1 váltja: a pillanatképben a frekvenciával együtt mindig összetartozó értékek vannak
+    work.bandIdx = config.data.bandIdx;
+    work.mode = band.currentMode;
+    work.bfo = config.data.currentBFO;
+    work.bandwidth = band.currentMode == FM ? config.data.bwIdxFM : band.currentMode == AM ? config.data.bwIdxAM : config.data.bwIdxSSB;
+    snapshot.write(work);
+
+    // A változás jelzők a pillanatkép után: a core0 a jelzőt követően már az új értékeket olvassa
+    if (pendingRdsChanges != 0) {
+        rdsChanges.fetch_or(pendingRdsChanges, std::memory_order_release);
+        pendingRdsChanges = 0;
+    }
+}
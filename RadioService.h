@@ -0,0 +1,278 @@
+#ifndef __RADIOSERVICE_H
+#define __RADIOSERVICE_H
+
+#include "Band.h"
+#include "BandScope.h"
+#include "Config.h"
+#include "I2cClockStore.h"
+#include "MemoryStore.h"
+#include "RdsDecoder.h"
+#include "SeqLock.h"
+#include "SignalQualityCache.h"
+#include "SpscQueue.h"
+#include "StationScanner.h"
+#include <SI4735.h>
+
+#define RADIO_RDS_POLL_MSEC 100  // RDS státusz lekérdezés periódusa (core1, csak FM)
+#define RADIO_CMD_QUEUE_SIZE 16  // Parancs sor mérete (2 hatványa!)
+#define RADIO_SIGNAL_NO_REQUEST UINT16_MAX // Nincs függő jelminőség igény
+#define RADIO_RDS_IRQ_FIFO_COUNT 4 // Megszakítás módban ennyi RDS csoport után jelez a chip (FM_RDS_INT_FIFO_COUNT)
+#define RADIO_RDS_MAX_DRAIN 25     // Egy megszakításra legfeljebb ennyi RDS csoportot olvasunk ki (a chip FIFO mérete)
+#define RADIO_SSB_LOAD_IDLE 0xFF   // Nincs SSB patch betöltés folyamatban
+#define RADIO_I2C_FALLBACK_ERRORS 2 // Ennyi egymást követő, a chip által hibásnak jelzett patch letöltés után a biztonságos I2C órajelre váltunk
+
+// Si473x property-k és bitek a megszakításokhoz (AN332)
+#define SI473X_PROP_GPO_IEN 0x0001
+#define SI473X_GPO_IEN_RDSIEN 0x0004
+#define SI473X_GPO_IEN_RSQIEN 0x0008
+#define SI473X_PROP_FM_RDS_INT_SOURCE 0x1500
+#define SI473X_PROP_FM_RDS_INT_FIFO_COUNT 0x1501
+#define SI473X_RDS_INT_RDSRECV 0x0001
+#define SI473X_PROP_FM_RSQ_INT_SOURCE 0x1200 // Az AM megfelelője 0x3200, az eltolások azonosak
+#define SI473X_PROP_AM_RSQ_INT_SOURCE 0x3200
+#define SI473X_RSQ_SNR_HI_OFFSET 1
+#define SI473X_RSQ_SNR_LO_OFFSET 2
+#define SI473X_RSQ_RSSI_HI_OFFSET 3
+#define SI473X_RSQ_RSSI_LO_OFFSET 4
+#define SI473X_RSQ_INT_RSSILIEN 0x0001
+#define SI473X_RSQ_INT_RSSIHIEN 0x0002
+#define SI473X_RSQ_INT_SNRLIEN 0x0004
+#define SI473X_RSQ_INT_SNRHIEN 0x0008
+
+/**
+ * A rádió aktuális állapotának pillanatképe
+ * A core1 publikálja, a core0 (UI) blokkolás nélkül olvassa
+ */
+struct RadioSnapshot_t {
+    uint32_t timestamp; // A legutóbbi frissítés ideje (millis)
+
+    // Hangolás (a frekvenciával együtt a band, a mód, a BFO és a sávszélesség is, így a core0 egy egységként látja)
+    uint16_t frequency;
+    uint8_t bandIdx;
+    uint8_t mode;      // FM, LSB, USB, AM, CW
+    int16_t bfo;       // SSB BFO (Hz)
+    uint8_t bandwidth; // A mód szerinti sávszélesség index (bwIdx*)
+
+    // Jelminőség (a signal.timestamp a lekérdezés ideje)
+    SignalQuality_t signal;
+
+    // RDS
+    bool rdsAvailable;     // Van szinkronizált RDS vétel?
+    RdsStationState_t rds; // A dekódolt RDS mezők (a változásokat a takeRdsChanges() jelzi)
+};
+
+/**
+ * Rádió szolgáltatás
+ *
+ * A core1-en fut, kizárólagosan birtokolja az SI4735 példányt (a setup() után a core0 már nem nyúlhat hozzá!).
+ * Periodikusan lekérdezi a chip állapotát, és az eredményt egy seqlock-kal védett pillanatképben publikálja.
+ * A core0 felől a parancsok egy SPSC soron keresztül érkeznek.
+ * A jelminőséget nem periodikusan kérdezi le: a fogyasztók megadják, milyen régi adat elég nekik,
+ * és a core1 csak akkor fordul a chiphez, ha a cache-ben lévő adat ennél régebbi.
+ *
+ * Ha a chip GPO2/INT lába be van kötve (enableInterrupt()), az RDS-t és a zajzár küszöb átlépését nem pollingoljuk:
+ * a megszakítás csak egy flag-et állít, a core1 a következő ciklusában üríti az RDS FIFO-t, illetve frissíti a jelminőséget.
+ */
+class RadioService {
+
+public:
+    // Parancs típusok
+    enum CommandType : uint8_t {
+        FREQUENCY_UP,   // Hangolás fel egy lépéssel
+        FREQUENCY_DOWN, // Hangolás le egy lépéssel
+        SET_FREQUENCY,  // Hangolás a megadott frekvenciára (param: frekvencia)
+        SET_MUTE,       // Némítás (param: AUDIO_MUTE_ON/AUDIO_MUTE_OFF)
+        SET_BAND,       // Band váltás (param: a Band tábla indexe)
+        SCOPE_START,    // Band scope sweep indítása (az aktuális band-en)
+        SCOPE_STOP,     // Band scope leállítása, visszahangolás
+        SCAN_START,     // Állomás keresés indítása (az aktuális band-en)
+        SCAN_STOP,      // Állomás keresés megszakítása, visszahangolás
+        TUNE_KHZ,       // Közvetlen hangolás (param: kHz), ha kell, band váltással a frekvenciát tartalmazó legszűkebb band-re
+        TUNE_BAND,      // Hangolás a megadott band-en, ha kell, band váltással (param: band index << 16 | frekvencia)
+        TUNE_STEPS,     // Hangolás a megadott számú lépéssel (param: előjeles lépésszám), az egymást követők egyetlen hangolássá vonódnak össze
+        RECALL_MEMORY   // Memória csatorna visszahívása (a rekordot a recallMemory() teszi a postafiókba)
+    };
+
+    // Parancs
+    struct Command_t {
+        CommandType type;
+        int32_t param;
+    };
+
+private:
+    SI4735 &si4735;
+    Band &band;
+    Config &config;
+    I2cClockStore &i2cClockStore;
+
+    SeqLock<RadioSnapshot_t> snapshot;                      // Publikált pillanatkép
+    SpscQueue<Command_t, RADIO_CMD_QUEUE_SIZE> commandQueue; // core0 -> core1 parancsok
+    RadioSnapshot_t work;                                   // A core1 munkapéldánya
+    std::atomic<bool> started{false};
+    SeqLock<MemoryChannel_t> memoryRecall;                  // A visszahívott memória csatorna (core0 -> core1)
+
+    SignalQualityCache signalCache;                                 // Jelminőség cache (core1)
+    BandScope bandScope;                                            // Band scope sweep (core1, a minták a core0-ról is olvashatók)
+    StationScanner stationScanner;                                  // Állomás keresés (core1, a tábla a keresés után a core0-ról is olvasható)
+    std::atomic<uint16_t> signalRequestMaxAge{RADIO_SIGNAL_NO_REQUEST}; // A legszigorúbb függő igény (core0 -> core1)
+
+    uint32_t lastRdsPollMsec = 0;
+    RdsDecoder rdsDecoder;                 // Saját RDS csoport dekóder (core1)
+    uint16_t pendingRdsChanges = 0;        // A következő publikálással jelzendő mező változások (core1)
+    std::atomic<uint16_t> rdsChanges{0};   // A core0 által még át nem vett mező változások (RDS_CHANGED_*)
+
+    // SSB patch betöltés állapota (0-100%, RADIO_SSB_LOAD_IDLE ha nem tölt), a core1 írja, a core0 olvassa
+    std::atomic<uint8_t> ssbLoadProgress{RADIO_SSB_LOAD_IDLE};
+    std::atomic<uint32_t> bandReadyCount{0}; // Befejezett band váltások (a core1 írja a váltás legvégén)
+
+    // I2C órajel (a setup()-ban a kalibrált, ismétlődő patch hibák után a core1 a biztonságosra állítja)
+    std::atomic<uint32_t> i2cClockHz{0};
+    uint32_t lastPatchStatusErrors = 0; // A patch hibák száma a legutóbbi letöltés után
+    uint8_t patchErrorRun = 0;          // Egymást követő hibás patch letöltések
+
+    // Megszakítás (GPO2/INT)
+    int8_t irqPin = -1;
+    static std::atomic<bool> irqPending;
+    static void irqHandler();
+
+    void executeCommand(const Command_t &command);
+    void onTuned();
+    void onBandReady();
+    void switchBand(uint8_t bandIdx);
+    void tuneBand(uint8_t bandIdx, uint16_t frequency);
+    void applyMemory(const MemoryChannel_t &record);
+    void serviceSSBLoad();
+    bool checkPatchErrors();
+    void configureInterrupt();
+    void updateSignalQuality(uint16_t maxAgeMsec);
+    void serviceInterrupt();
+    void armSignalThreshold(bool signalPresent);
+    bool pollRds(uint8_t intAck = 0);
+    void decodeRds();
+    void clearRds();
+    void publish();
+
+public:
+    /**
+     * Konstruktor
+     */
+    RadioService(SI4735 &si4735, Band &band, Config &config, I2cClockStore &i2cClockStore);
+
+    /**
+     * A szolgáltatás indítása (core0 hívja a setup() végén, a chip inicializálása után)
+     * Elkészíti az első pillanatképet, majd átadja a chip kezelését a core1-nek
+     */
+    void start();
+
+    /**
+     * A GPO2/INT megszakítás használata az RDS és RSQ eseményekhez (core0 hívja a start() előtt)
+     * A chipet a POWER_UP-ban GPO2 kimenet engedélyezéssel kell indítani (Band::BandInit())
+     * @param pin a GPO2/INT-re kötött GPIO
+     */
+    void enableInterrupt(uint8_t pin);
+
+    /**
+     * Megszakítás módban vagyunk?
+     */
+    bool isInterruptEnabled() const { return irqPin >= 0; }
+
+    /**
+     * Elindult már a szolgáltatás?
+     */
+    bool isStarted() const { return started.load(std::memory_order_acquire); }
+
+    /**
+     * A szolgáltatás ciklusa (core1 loop1() hívja)
+     */
+    void loop();
+
+    /**
+     * Hány msec múlva van legközelebb teendője a core1-nek (a core1 addig alhat)
+     * @return UINT32_MAX, ha csak a core0 ébresztése vagy megszakítás hozhat munkát
+     */
+    uint32_t getMsecToNextWork() const;
+
+    /**
+     * Parancs küldése a core1-nek (csak a core0-ról hívható)
+     * @return false, ha tele van a parancs sor
+     */
+    bool postCommand(CommandType type, int32_t param = 0);
+
+    /**
+     * Memória csatorna visszahívása: band, frekvencia, moduláció, BFO és sávszélesség (csak a core0-ról hívható)
+     * @return false, ha tele van a parancs sor
+     */
+    bool recallMemory(const MemoryChannel_t &record);
+
+    /**
+     * Az aktuális pillanatkép lekérése (blokkolásmentes)
+     */
+    void getSnapshot(RadioSnapshot_t &out) const { snapshot.read(out); }
+
+    /**
+     * A legutóbbi hívás óta változott RDS mezők (RDS_CHANGED_*), a jelzők törlődnek (csak egy fogyasztó, a core0 RDS kijelzője)
+     * A jelzők a pillanatkép publikálása után állnak be, így az utána olvasott pillanatképben már az új értékek vannak
+     */
+    uint16_t takeRdsChanges() { return rdsChanges.exchange(0, std::memory_order_acquire); }
+
+    /**
+     * A pillanatkép verziója (minden publikáláskor nő)
+     */
+    uint32_t getSnapshotVersion() const { return snapshot.getVersion(); }
+
+    /**
+     * Jelminőség lekérése (csak a core0-ról hívható, blokkolásmentes)
+     * Ha a publikált adat régebbi a megadottnál, a core1 a következő ciklusában frissíti
+     * @param out a legutóbb publikált jelminőség
+     * @param maxAgeMsec ennél régebbi adat esetén frissítést kérünk
+     * @return true, ha a visszaadott adat elég friss
+     */
+    bool getSignalQuality(SignalQuality_t &out, uint16_t maxAgeMsec);
+
+    /**
+     * Az SSB patch betöltés állapota (core0-ról is hívható)
+     * Betöltés közben a chip nem fogad más parancsot: a parancsok a sorban várnak, a UI tiltsa az SSB-függő vezérlőket
+     * @return 0-100%, vagy RADIO_SSB_LOAD_IDLE, ha nincs betöltés
+     */
+    uint8_t getSSBLoadProgress() const { return ssbLoadProgress.load(std::memory_order_relaxed); }
+
+    /**
+     * Folyamatban van az SSB patch betöltése?
+     */
+    bool isSSBLoading() const { return getSSBLoadProgress() != RADIO_SSB_LOAD_IDLE; }
+
+    /**
+     * Az I2C órajel beállítása (core0 a start() előtt, utána csak a core1)
+     */
+    void setI2cClock(uint32_t hz) {
+        si4735.setI2CFastModeCustom(hz);
+        i2cClockHz.store(hz, std::memory_order_relaxed);
+    }
+
+    /**
+     * Az aktuális I2C órajel (core0-ról is hívható)
+     */
+    uint32_t getI2cClock() const { return i2cClockHz.load(std::memory_order_relaxed); }
+
+    /**
+     * Befejezett band váltások száma (core0-ról is hívható, pl.: a váltás végének megvárásához)
+     */
+    uint32_t getBandReadyCount() const { return bandReadyCount.load(std::memory_order_acquire); }
+
+    /**
+     * Band scope (a minták és az állapot a core0-ról is olvashatók)
+     */
+    const BandScope &getBandScope() const { return bandScope; }
+
+    /**
+     * Állomás kereső (a tábla a keresés vége után a core0-ról is olvasható)
+     */
+    const StationScanner &getStationScanner() const { return stationScanner; }
+
+    /**
+     * Jelminőség cache statisztika
+     */
+    const SignalQualityCache &getSignalCache() const { return signalCache; }
+};
+
+#endif // __RADIOSERVICE_H
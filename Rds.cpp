@@ -54,8 +54,8 @@ int getLongestPtyStrLength() {
 /**
  * Konstruktor
  */
-RDS::RDS(TFT_eSPI &tft, SI4735 &si4735, uint16_t stationX, uint16_t stationY, uint16_t msgX, uint16_t msgY, uint16_t timeX, uint16_t timeY, uint16_t ptyX, uint16_t ptyY)
-    : tft(tft), si4735(si4735),
+RDS::RDS(TFT_eSPI &tft, RadioService &radioService, uint16_t stationX, uint16_t stationY, uint16_t msgX, uint16_t msgY, uint16_t timeX, uint16_t timeY, uint16_t ptyX, uint16_t ptyY)
+    : tft(tft), radioService(radioService),
       stationX(stationX), stationY(stationY),
       msgX(msgX), msgY(msgY),
       timeX(timeX), timeY(timeY),
@@ -81,87 +81,76 @@ RDS::RDS(TFT_eSPI &tft, SI4735 &si4735, uint16_t stationX, uint16_t stationY, ui
 /**
  * RDS adatok megjelenítése
  * (Az esetleges dialóg eltünése után a teljes képernyőt újra rajzolásakor kellhet -> forceDisplay = true)
- * @param forceDisplay erőből, ne csak a változáskor jelenítsen meg adatokat
+ * @param forceDisplay erőből, ne csak a változott mezőket jelenítse meg
  */
 void RDS::displayRds(bool forceDisplay) {
+    RadioSnapshot_t snapshot;
+    radioService.getSnapshot(snapshot);
+    pendingFields |= radioService.takeRdsChanges() | (forceDisplay ? RDS_CHANGED_ALL : 0);
+    displayRds(snapshot, pendingFields);
+    pendingFields = 0;
+}
+
+/**
+ * A megadott (változott) RDS mezők újrarajzolása a pillanatképből
+ * A mezőt előbb töröljük (a rövidebb új szöveg ne hagyjon maradékot), az üres mező törölve marad
+ * @param snapshot a rádió pillanatképe
+ * @param fields az újrarajzolandó mezők (RDS_CHANGED_*)
+ */
+void RDS::displayRds(const RadioSnapshot_t &snapshot, uint16_t fields) {
 
+    const RdsStationState_t &rds = snapshot.rds;
     tft.setFreeFont();
     tft.setTextDatum(BC_DATUM);
 
     // Állomásnév
-    rdsStationName = si4735.getRdsText0A();
-    if (rdsStationName != NULL) {
+    if (fields & RDS_CHANGED_PS) {
+        tft.fillRect(stationX, stationY, font2Width * MAX_STATION_NAME_LENGTH, font2Height, TFT_BLACK);
         tft.setTextSize(2);
         tft.setTextColor(TFT_CYAN, TFT_BLACK);
         tft.setCursor(stationX, stationY);
-        tft.print(rdsStationName);
+        tft.print(rds.ps);
+        rdsStationNameShown = rds.ps[0] != '\0';
     }
 
     // Info
-    rdsMsg = si4735.getRdsText2A();
-    if (rdsMsg != NULL) {
+    if (fields & RDS_CHANGED_RT) {
+        tft.fillRect(msgX, msgY, font1Width * MAX_MESSAGE_LENGTH, font1Height, TFT_BLACK);
         tft.setTextSize(1);
         tft.setTextColor(TFT_WHITE, TFT_BLACK);
         tft.setCursor(msgX, msgY);
-        tft.print(rdsMsg);
+        tft.print(rds.rt);
+        rdsMsgShown = rds.rt[0] != '\0';
     }
 
     // Idő
-    char dateTime[20];
-    uint16_t year, month, day, hour, minute;
-
-    bool rdsDateTimeSuccess = si4735.getRdsDateTime(&year, &month, &day, &hour, &minute);
-    // Ha izomból kell megjeleníteni vagy érvényes idő jött
-    if (forceDisplay or rdsDateTimeSuccess) {
-        // sprintf(dateTime, "%04d-%02d-%02d %02d:%02d", year, month, day, hour, minute);
-        //  DEBUG("RDS full datetime : %s  ", dateTime);
-
-        tft.setTextSize(1);
-        tft.setTextDatum(BC_DATUM);
-        tft.setTextColor(TFT_YELLOW, TFT_BLACK);
-        tft.setCursor(timeX, timeY);
-        sprintf(dateTime, "%02d:%02d", hour, minute);
-        // DEBUG("RDS time : %s\n", dateTime);
-        tft.print(dateTime);
+    if (fields & RDS_CHANGED_CT) {
+        tft.fillRect(timeX, timeY, font1Width * MAX_TIME_LENGTH, font1Height, TFT_BLACK);
+        if (rds.ctValid) {
+            char dateTime[20];
+            tft.setTextSize(1);
+            tft.setTextDatum(BC_DATUM);
+            tft.setTextColor(TFT_YELLOW, TFT_BLACK);
+            tft.setCursor(timeX, timeY);
+            sprintf(dateTime, "%02d:%02d", rds.ctHour, rds.ctMinute);
+            tft.print(dateTime);
+        }
     }
 
     // RDS program type (PTY)
-    uint8_t rdsPty = si4735.getRdsProgramType();
-    if (rdsPty < RDS_PTY_COUNT) {
-        const char *p = getPtyStrPointer(rdsPty); // PTY String PROGMEM pointerének megszerzése
-
-        // Ha izomból kell megjeleníteni vagy változás van
-        if (forceDisplay or rdsProgramType != p) {
-            // clear RDS programType
-            tft.fillRect(ptyX, ptyY, font2Width * ptyArrayMaxLength, font2Height, TFT_BLACK);
-
-            // Elmentjük az új pointert
-            rdsProgramType = p;
-
+    if (fields & RDS_CHANGED_PTY) {
+        tft.fillRect(ptyX, ptyY, font2Width * ptyArrayMaxLength, font2Height, TFT_BLACK);
+        if (rds.pty < RDS_PTY_COUNT) {
             // Kiírjuk a String-et a PROGMEM-ből
             tft.setTextSize(2);
             tft.setTextDatum(BC_DATUM);
             tft.setTextColor(TFT_YELLOW, TFT_BLACK);
             tft.setCursor(ptyX, ptyY);
-            tft.print((const __FlashStringHelper *)rdsProgramType);
+            tft.print((const __FlashStringHelper *)getPtyStrPointer(rds.pty));
         }
     }
 }
 
-/**
- * RDS adatok megszerzése és megjelenítése
- */
-void RDS::checkRds() {
-
-    // Ha nincs RDS akkor nem megyünk tovább
-    si4735.getRdsStatus();
-    if (!si4735.getRdsReceived() or !si4735.getRdsSync() or !si4735.getRdsSyncFound()) {
-        return;
-    }
-
-    displayRds();
-}
-
 /**
  *  RDS adatok törlése (csak FM módban hívható...nyílván....)
  */
@@ -170,33 +159,44 @@ void RDS::clearRds() {
     // clear RDS rdsStationName
     tft.fillRect(stationX, stationY, font2Width * MAX_STATION_NAME_LENGTH, font2Height, TFT_BLACK);
     // tft.drawRect(stationX, stationY, font2Width * MAX_STATION_NAME_LENGTH, font2Height, TFT_YELLOW);
-    rdsStationName = NULL;
+    rdsStationNameShown = false;
 
     // clear RDS rdsMsg
     tft.fillRect(msgX, msgY, font1Width * MAX_MESSAGE_LENGTH, font1Height, TFT_BLACK);
     // tft.drawRect(msgX, msgY, font1Width * MAX_MESSAGE_LENGTH, font1Height, TFT_YELLOW);
-    rdsMsg = NULL;
+    rdsMsgShown = false;
 
     // clear RDS rdsTime
     tft.fillRect(timeX, timeY, font1Width * MAX_TIME_LENGTH, font1Height, TFT_BLACK);
     // tft.drawRect(timeX, timeY, font1Width * MAX_TIME_LENGTH, font1Height, TFT_YELLOW);
-    // this->rdsTime = NULL;
 
     // clear RDS programType
     tft.fillRect(ptyX, ptyY, font2Width * ptyArrayMaxLength, font2Height, TFT_BLACK);
     // tft.drawRect(ptyX, ptyY, font2Width * ptyArrayMaxLength, font2Height, TFT_YELLOW);
-    rdsProgramType = NULL;
+
+    // A következő megjelenítéskor minden meglévő mezőt újra kirajzolunk
+    pendingFields = RDS_CHANGED_ALL;
 }
 
 /**
  * RDS adatok megjelenítése (csak FM módban hívható...nyílván....)
+ * Csak a core1 által változottnak jelzett mezőket rajzoljuk újra
  */
 void RDS::showRDS(uint8_t snr) {
 
+    // A jelzőket gyenge vételnél is átvesszük (összegyűlnek a következő megjelenítésig)
+    pendingFields |= radioService.takeRdsChanges();
+
     // Ha 'jó' a vétel akkor rámozdulunk az RDS-re
     if (snr >= RDS_GOOD_SNR) {
-        checkRds();
-    } else if (rdsStationName != NULL or rdsMsg != NULL) {
+        // Ha nincs RDS akkor nem megyünk tovább
+        RadioSnapshot_t snapshot;
+        radioService.getSnapshot(snapshot);
+        if (snapshot.rdsAvailable and pendingFields != 0) {
+            displayRds(snapshot, pendingFields);
+            pendingFields = 0;
+        }
+    } else if (rdsStationNameShown or rdsMsgShown) {
         clearRds(); // töröljük az esetleges korábbi RDS adatokat
     }
 }
@@ -1,8 +1,8 @@
 #ifndef __RDS_H
 #define __RDS_H
 
+#include "RadioService.h"
 #include "utils.h"
-#include <SI4735.h>
 #include <TFT_eSPI.h>
 
 /**
@@ -11,23 +11,19 @@
 class RDS {
 private:
     TFT_eSPI &tft;
-    SI4735 &si4735;
+    RadioService &radioService;
 
-#define MAX_STATION_NAME_LENGTH 8
-    // Az SI4735 bufferét használjuk,
-    // ez csak ez jelző pointer a képernyő törlésének szükségességének jelzésére
-    char *rdsStationName = NULL;
+    // Van a képernyőn RDS állomásnév/üzenet? (a képernyő törlésének szükségességének jelzésére)
+    bool rdsStationNameShown = false;
+    bool rdsMsgShown = false;
 
-#define MAX_MESSAGE_LENGTH 64
-    // Az SI4735 bufferét használjuk,
-    // ez csak ez jelző pointer a képernyő törlésének szükségességének jelzésére
-    char *rdsMsg = NULL;
+    // A következő megjelenítéskor újrarajzolandó mezők (RDS_CHANGED_*): a core1 jelzői, törlés után minden
+    uint16_t pendingFields = RDS_CHANGED_ALL;
 
 #define MAX_TIME_LENGTH 5
 
     // Program Type
-    uint8_t ptyArrayMaxLength;  // A RDS_PTY_ARRAY leghoszabb stringjének hossza, a képernyő törléshez
-    const char *rdsProgramType; // RDS_PTY_ARRAY PROGMEM pointer a kiíráshoz
+    uint8_t ptyArrayMaxLength; // A RDS_PTY_ARRAY leghoszabb stringjének hossza, a képernyő törléshez
 
     // 1. font méretek
     uint8_t font1Height;
@@ -48,15 +44,15 @@ private:
     uint16_t ptyY;
 
     /**
-     * RDS adatok megszerzése és megjelenítése
+     * A megadott (változott) RDS mezők újrarajzolása a pillanatképből
      */
-    void checkRds();
+    void displayRds(const RadioSnapshot_t &snapshot, uint16_t fields);
 
 public:
     /**
      * Konstruktor
      */
-    RDS(TFT_eSPI &Tft, SI4735 &si4735, uint16_t stationX, uint16_t stationY, uint16_t msgX, uint16_t msgY, uint16_t timeX, uint16_t timeY, uint16_t ptyX, uint16_t ptyY);
+    RDS(TFT_eSPI &Tft, RadioService &radioService, uint16_t stationX, uint16_t stationY, uint16_t msgX, uint16_t msgY, uint16_t timeX, uint16_t timeY, uint16_t ptyX, uint16_t ptyY);
 
     /**
      *  RDS adatok törlése (csak FM módban)
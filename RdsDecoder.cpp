@@ -0,0 +1,299 @@
+#include "RdsDecoder.h"
+
+static_assert((RDS_RAW_RING_SIZE & (RDS_RAW_RING_SIZE - 1)) == 0, "RDS_RAW_RING_SIZE: 2 hatványa kell legyen");
+
+/**
+ * Az állapot és a puffer törlése
+ */
+void RdsDecoder::reset() {
+
+    head = tail = 0;
+    memset(&state, 0, sizeof(state));
+
+    memset(psWork, ' ', sizeof(psWork));
+    psMask = 0;
+    memset(rtWork, ' ', sizeof(rtWork));
+    rtMask = 0;
+    rtAb = -1;
+    rtLength = MAX_MESSAGE_LENGTH;
+    memset(ptynWork, ' ', sizeof(ptynWork));
+    ptynMask = 0;
+    ptynAb = -1;
+    memset(eonPsWork, ' ', sizeof(eonPsWork));
+    eonPsMask = 0;
+    eonPsPi = 0;
+
+    // A korábbi állomás mezőit a megjelenítésnek is törölnie kell
+    changes = RDS_CHANGED_ALL;
+}
+
+/**
+ * Egy nyers csoport a pufferbe
+ */
+void RdsDecoder::push(const RdsGroup_t &group) {
+
+    uint8_t next = (head + 1) & (RDS_RAW_RING_SIZE - 1);
+    if (next == tail) {
+        tail = (tail + 1) & (RDS_RAW_RING_SIZE - 1);
+        droppedGroups++;
+    }
+    ring[head] = group;
+    head = next;
+}
+
+/**
+ * A pufferben lévő csoportok dekódolása
+ */
+uint8_t RdsDecoder::process() {
+
+    uint8_t count = 0;
+    while (tail != head) {
+        decode(ring[tail]);
+        tail = (tail + 1) & (RDS_RAW_RING_SIZE - 1);
+        count++;
+    }
+    return count;
+}
+
+/**
+ * Egy blokk két karaktere (a nem megjeleníthetőek helyett szóköz, a 0x0D szöveg végjel marad)
+ */
+void RdsDecoder::putChars(char *dest, uint16_t block) {
+
+    uint8_t chars[2] = {(uint8_t)(block >> 8), (uint8_t)(block & 0xFF)};
+    for (uint8_t i = 0; i < 2; i++) {
+        dest[i] = (chars[i] >= 0x20 and chars[i] < 0x7F) or chars[i] == '\r' ? chars[i] : ' ';
+    }
+}
+
+/**
+ * Egy összegyűlt szöveg mező átvétele az állapotba (a végjelig, a záró szóközök nélkül), ha eltér a korábbitól
+ */
+void RdsDecoder::publishText(char *dest, const char *src, uint8_t length, uint16_t flag) {
+
+    char text[MAX_MESSAGE_LENGTH + 1];
+    uint8_t n = 0;
+    while (n < length and src[n] != '\r') {
+        text[n] = src[n];
+        n++;
+    }
+    while (n > 0 and text[n - 1] == ' ') {
+        n--;
+    }
+    text[n] = '\0';
+
+    if (strcmp(dest, text) != 0) {
+        strcpy(dest, text);
+        changes |= flag;
+    }
+}
+
+/**
+ * Egy csoport dekódolása
+ */
+void RdsDecoder::decode(const RdsGroup_t &group) {
+
+    // Hibás B blokknál a csoport típusa sem ismert
+    if (!isBlockValid(group.errors, 1)) {
+        state.badGroups++;
+        return;
+    }
+    state.groups++;
+
+    uint16_t b = group.blocks[1];
+    uint8_t groupType = b >> 12;
+    bool versionB = b & 0x0800;
+
+    // PI: az A blokkban, B verzióban a C blokkban is
+    uint16_t pi = 0;
+    if (isBlockValid(group.errors, 0)) {
+        pi = group.blocks[0];
+    } else if (versionB and isBlockValid(group.errors, 2)) {
+        pi = group.blocks[2];
+    }
+    if (pi != 0 and pi != state.pi) {
+        state.pi = pi;
+        changes |= RDS_CHANGED_PI;
+    }
+
+    // PTY és TP minden csoportban
+    uint8_t pty = (b >> 5) & 0x1F;
+    if (pty != state.pty) {
+        state.pty = pty;
+        changes |= RDS_CHANGED_PTY;
+    }
+    bool tp = b & 0x0400;
+    if (tp != state.tp) {
+        state.tp = tp;
+        changes |= RDS_CHANGED_FLAGS;
+    }
+
+    bool blockCValid = isBlockValid(group.errors, 2);
+    bool blockDValid = isBlockValid(group.errors, 3);
+
+    switch (groupType) {
+
+    case 0: { // 0A/0B: állomásnév (szegmensenként 2 karakter a D blokkban), TA, MS
+        bool ta = b & 0x0010;
+        bool music = b & 0x0008;
+        if (ta != state.ta or music != state.music) {
+            state.ta = ta;
+            state.music = music;
+            changes |= RDS_CHANGED_FLAGS;
+        }
+        if (!blockDValid) {
+            break;
+        }
+        uint8_t segment = b & 0x03;
+        putChars(&psWork[segment * 2], group.blocks[3]);
+        psMask |= 1 << segment;
+        if (psMask == 0x0F) {
+            publishText(state.ps, psWork, MAX_STATION_NAME_LENGTH, RDS_CHANGED_PS);
+            psMask = 0;
+        }
+        break;
+    }
+
+    case 2: // 2A/2B: rádió szöveg
+        decodeRadioText(group, versionB);
+        break;
+
+    case 4: // 4A: idő
+        if (!versionB) {
+            decodeClockTime(group);
+        }
+        break;
+
+    case 10: { // 10A: program típus név (szegmensenként 4 karakter a C és D blokkban)
+        if (versionB or !blockCValid or !blockDValid) {
+            break;
+        }
+        int8_t ab = (b >> 4) & 0x01;
+        if (ab != ptynAb) {
+            ptynAb = ab;
+            memset(ptynWork, ' ', sizeof(ptynWork));
+            ptynMask = 0;
+        }
+        uint8_t segment = b & 0x01;
+        putChars(&ptynWork[segment * 4], group.blocks[2]);
+        putChars(&ptynWork[segment * 4 + 2], group.blocks[3]);
+        ptynMask |= 1 << segment;
+        if (ptynMask == 0x03) {
+            publishText(state.ptyn, ptynWork, RDS_PTYN_LENGTH, RDS_CHANGED_PTYN);
+            ptynMask = 0;
+        }
+        break;
+    }
+
+    case 14: { // 14A: más hálózat (EON), a D blokkban a PI, a 0-3. változatban a C blokkban az állomásnév 2 karaktere
+        if (versionB or !blockDValid) {
+            break;
+        }
+        uint16_t onPi = group.blocks[3];
+        if (onPi != eonPsPi) {
+            eonPsPi = onPi;
+            memset(eonPsWork, ' ', sizeof(eonPsWork));
+            eonPsMask = 0;
+        }
+        uint8_t variant = b & 0x0F;
+        if (variant > 3 or !blockCValid) {
+            break;
+        }
+        putChars(&eonPsWork[variant * 2], group.blocks[2]);
+        eonPsMask |= 1 << variant;
+        if (eonPsMask == 0x0F) {
+            if (state.eonPi != onPi) {
+                state.eonPi = onPi;
+                changes |= RDS_CHANGED_EON;
+            }
+            publishText(state.eonPs, eonPsWork, MAX_STATION_NAME_LENGTH, RDS_CHANGED_EON);
+            eonPsMask = 0;
+        }
+        break;
+    }
+
+    default:
+        break;
+    }
+}
+
+/**
+ * Rádió szöveg: 2A-ban szegmensenként 4 karakter a C és D blokkban (max. 64), 2B-ben 2 karakter a D blokkban (max. 32)
+ */
+void RdsDecoder::decodeRadioText(const RdsGroup_t &group, bool versionB) {
+
+    uint16_t b = group.blocks[1];
+
+    // Az A/B jelző váltása új szöveget jelent
+    int8_t ab = (b >> 4) & 0x01;
+    if (ab != rtAb) {
+        rtAb = ab;
+        memset(rtWork, ' ', sizeof(rtWork));
+        rtMask = 0;
+        rtLength = versionB ? MAX_MESSAGE_LENGTH / 2 : MAX_MESSAGE_LENGTH;
+    }
+
+    uint8_t segment = b & 0x0F;
+    uint8_t charsPerSegment = versionB ? 2 : 4;
+    char *dest = &rtWork[segment * charsPerSegment];
+    if (versionB) {
+        if (!isBlockValid(group.errors, 3)) {
+            return;
+        }
+        putChars(dest, group.blocks[3]);
+    } else {
+        if (!isBlockValid(group.errors, 2) or !isBlockValid(group.errors, 3)) {
+            return;
+        }
+        putChars(dest, group.blocks[2]);
+        putChars(dest + 2, group.blocks[3]);
+    }
+    rtMask |= 1 << segment;
+
+    // A 0x0D végjel lerövidíti a szöveget
+    for (uint8_t i = 0; i < charsPerSegment; i++) {
+        if (dest[i] == '\r') {
+            rtLength = segment * charsPerSegment + i;
+            break;
+        }
+    }
+
+    // Kész, ha a szöveg minden szegmense megjött
+    uint8_t segments = (rtLength + charsPerSegment - 1) / charsPerSegment;
+    uint16_t needed = segments >= 16 ? 0xFFFF : (1 << segments) - 1;
+    if ((rtMask & needed) == needed) {
+        publishText(state.rt, rtWork, rtLength, RDS_CHANGED_RT);
+    }
+}
+
+/**
+ * Idő (4A): UTC óra/perc a C és D blokkban, a D blokk alsó 6 bitje a helyi eltolás félórákban (előjellel)
+ * A dátumot (MJD) nem tartjuk meg, nincs hol megjeleníteni
+ */
+void RdsDecoder::decodeClockTime(const RdsGroup_t &group) {
+
+    if (!isBlockValid(group.errors, 2) or !isBlockValid(group.errors, 3)) {
+        return;
+    }
+
+    uint16_t c = group.blocks[2];
+    uint16_t d = group.blocks[3];
+    uint8_t hour = ((c & 0x01) << 4) | (d >> 12);
+    uint8_t minute = (d >> 6) & 0x3F;
+    if (hour > 23 or minute > 59) {
+        return;
+    }
+
+    int16_t offset = (d & 0x1F) * 30;
+    int16_t local = hour * 60 + minute + ((d & 0x20) ? -offset : offset);
+    local = (local + 24 * 60) % (24 * 60);
+    hour = local / 60;
+    minute = local % 60;
+
+    if (!state.ctValid or state.ctHour != hour or state.ctMinute != minute) {
+        state.ctValid = true;
+        state.ctHour = hour;
+        state.ctMinute = minute;
+        changes |= RDS_CHANGED_CT;
+    }
+}
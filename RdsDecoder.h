@@ -0,0 +1,133 @@
+#ifndef __RDSDECODER_H
+#define __RDSDECODER_H
+
+#include <Arduino.h>
+
+#define MAX_STATION_NAME_LENGTH 8 // RDS állomásnév max hossza
+#define MAX_MESSAGE_LENGTH 64     // RDS üzenet max hossza
+#define RDS_PTYN_LENGTH 8         // RDS program típus név (10A) hossza
+
+#define RDS_RAW_RING_SIZE 32   // Nyers csoportok gyűrűs puffere (2 hatványa!), egy teljes chip FIFO (25 csoport) is elfér benne
+#define RDS_MAX_BLOCK_ERRORS 1 // Blokk hiba szint (BLE: 0 hibátlan, 1: 1-2, 2: 3-5 javított bit, 3: javíthatatlan), e felett a blokkot eldobjuk
+
+// Mező változás jelzők (a megjelenítés csak a ténylegesen változott mezőket rajzolja újra)
+#define RDS_CHANGED_PI 0x0001    // Program azonosító
+#define RDS_CHANGED_PTY 0x0002   // Program típus
+#define RDS_CHANGED_PS 0x0004    // Állomásnév (0A/0B)
+#define RDS_CHANGED_RT 0x0008    // Rádió szöveg (2A/2B)
+#define RDS_CHANGED_CT 0x0010    // Idő (4A)
+#define RDS_CHANGED_PTYN 0x0020  // Program típus név (10A)
+#define RDS_CHANGED_FLAGS 0x0040 // TP/TA/MS
+#define RDS_CHANGED_EON 0x0080   // Más hálózat (14A)
+#define RDS_CHANGED_ALL 0x00FF
+
+// Egy nyers RDS csoport (az A-D blokkok és a chip blokk hiba szintjei)
+struct RdsGroup_t {
+    uint16_t blocks[4];
+    uint8_t errors; // BLEA..BLED blokkonként 2 bit, az A blokk a legfelső
+};
+
+// A dekódolt állomás adatok (csak a teljesen összegyűlt mezők)
+struct RdsStationState_t {
+    uint16_t pi;     // Program azonosító (0: még nincs)
+    uint8_t pty;     // Program típus
+    bool tp : 1;     // Közlekedési program
+    bool ta : 1;     // Közlekedési hír megy
+    bool music : 1;  // Zene/beszéd
+    bool ctValid : 1; // Érvényes az idő?
+    uint8_t ctHour;  // Helyi idő (a 4A csoport UTC ideje + eltolás)
+    uint8_t ctMinute;
+    char ps[MAX_STATION_NAME_LENGTH + 1]; // Állomásnév (üres, ha még nincs)
+    char rt[MAX_MESSAGE_LENGTH + 1];      // Rádió szöveg (üres, ha még nincs)
+    char ptyn[RDS_PTYN_LENGTH + 1];       // Program típus név (üres, ha még nincs)
+    uint16_t eonPi;                       // Más hálózat (EON) PI-je, és az állomásneve
+    char eonPs[MAX_STATION_NAME_LENGTH + 1];
+    uint16_t groups;    // A hangolás óta dekódolt csoportok
+    uint16_t badGroups; // A hibás B blokk miatt eldobott csoportok
+};
+
+/**
+ * Saját RDS csoport dekóder
+ *
+ * A core1 a chip FIFO-jából kiolvasott nyers A-D blokkokat (a blokk hiba szintekkel együtt) a push()-sal egy gyűrűs
+ * pufferbe teszi, a process() ezeket dekódolja. A 0A/0B (PS, TP/TA/MS), 2A/2B (RT), 4A (CT), 10A (PTYN) és
+ * 14A (EON PI/PS) csoportokat szegmensenként gyűjtjük, egy mező csak akkor kerül az állapotba, ha minden szegmense
+ * megjött, és ha eltér a korábbitól, a változás jelzője is beáll. A hibás (RDS_MAX_BLOCK_ERRORS feletti) blokkokat
+ * eldobjuk, hibás B blokknál a csoport típusa sem ismert, ilyenkor a teljes csoportot.
+ * Csak a core1 használja, a core0 a RadioService pillanatképén keresztül látja az állapotot.
+ */
+class RdsDecoder {
+
+private:
+    RdsGroup_t ring[RDS_RAW_RING_SIZE];
+    uint8_t head = 0; // A következő írás helye
+    uint8_t tail = 0; // A következő dekódolandó csoport
+    uint32_t droppedGroups = 0;
+
+    RdsStationState_t state;
+    uint16_t changes = 0;
+
+    // Szegmensenként gyűjtött mezők (a beérkezett szegmensek bitmaszkjával)
+    char psWork[MAX_STATION_NAME_LENGTH];
+    uint8_t psMask;
+    char rtWork[MAX_MESSAGE_LENGTH];
+    uint16_t rtMask;
+    int8_t rtAb;        // Az RT A/B jelzője (-1: még nem jött), váltáskor új szöveg indul
+    uint8_t rtLength;   // A szöveg hossza (a 0x0D végjel, 2B-ben 32, egyébként 64)
+    char ptynWork[RDS_PTYN_LENGTH];
+    uint8_t ptynMask;
+    int8_t ptynAb;
+    char eonPsWork[MAX_STATION_NAME_LENGTH];
+    uint8_t eonPsMask;
+    uint16_t eonPsPi; // Az EON állomásnév ehhez a PI-hez gyűlik
+
+    static bool isBlockValid(uint8_t errors, uint8_t block) { return ((errors >> (6 - block * 2)) & 0x03) <= RDS_MAX_BLOCK_ERRORS; }
+    static void putChars(char *dest, uint16_t block);
+    void publishText(char *dest, const char *src, uint8_t length, uint16_t flag);
+    void decode(const RdsGroup_t &group);
+    void decodeRadioText(const RdsGroup_t &group, bool versionB);
+    void decodeClockTime(const RdsGroup_t &group);
+
+public:
+    /**
+     * Konstruktor
+     */
+    RdsDecoder() { reset(); }
+
+    /**
+     * Az állapot és a puffer törlése (hangoláskor), minden mező változottnak számít
+     */
+    void reset();
+
+    /**
+     * Egy nyers csoport a pufferbe (a FIFO kiolvasásakor), tele puffernél a legrégebbi elveszik
+     */
+    void push(const RdsGroup_t &group);
+
+    /**
+     * A pufferben lévő csoportok dekódolása
+     * @return a dekódolt csoportok száma
+     */
+    uint8_t process();
+
+    /**
+     * A dekódolt állapot
+     */
+    const RdsStationState_t &getState() const { return state; }
+
+    /**
+     * A legutóbbi lekérdezés óta változott mezők (RDS_CHANGED_*), a jelzők törlődnek
+     */
+    uint16_t takeChanges() {
+        uint16_t result = changes;
+        changes = 0;
+        return result;
+    }
+
+    /**
+     * A megtelt puffer miatt elveszett csoportok száma
+     */
+    uint32_t getDroppedGroups() const { return droppedGroups; }
+};
+
+#endif // __RDSDECODER_H
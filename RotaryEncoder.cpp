@@ -42,8 +42,8 @@ const int8_t ClickEncoder::table[16] __attribute__((__progmem__)) = {
  *
  */
 RotaryEncoder::RotaryEncoder(uint8_t A, uint8_t B, uint8_t BTN, uint8_t stepsPerNotch, bool pinsActive)
-    : pinA(A), pinB(B), pinBTN(BTN), steps(stepsPerNotch), pinsActive(pinsActive),
-      doubleClickEnabled(true), accelerationEnabled(true), delta(0), last(0), acceleration(0), buttonState(ButtonState::Open) {
+    : pinA(A), pinB(B), pinBTN(BTN), pinsActive(pinsActive), delta(0), last(0), steps(stepsPerNotch),
+      acceleration(0), accelerationEnabled(true), buttonState(ButtonState::Open), doubleClickEnabled(true) {
 
     uint8_t mode = (pinsActive == LOW) ? INPUT_PULLUP : INPUT;
     pinMode(pinA, mode);
@@ -218,7 +218,7 @@ RotaryEncoder::ButtonState RotaryEncoder::getButton(void) {
 //
 RotaryEncoder::EncoderState RotaryEncoder::read() {
 
-    EncoderState result = {NONE, Open};
+    EncoderState result = {NONE, Open, 0};
 
     // Gomb állapotának lekérdezése
     result.buttonState = getButton();
@@ -228,6 +228,7 @@ RotaryEncoder::EncoderState RotaryEncoder::read() {
 
         value += getValue();
 
+        result.value = oldValue - value / 2;
         if (value / 2 > oldValue) {
             oldValue = value / 2;
             result.direction = DOWN;
@@ -51,6 +51,7 @@ public:
     struct EncoderState {
         Direction direction;
         ButtonState buttonState;
+        int16_t value; // Előjeles lépésszám a gyorsítással együtt (pozitív: UP, gyors tekerésnél több lépés)
     };
 
 private:
@@ -107,13 +108,13 @@ public:
             acceleration = 0;
         }
     }
-    const bool getAccelerationEnabled() { return accelerationEnabled; }
+    bool getAccelerationEnabled() { return accelerationEnabled; }
 
     /**
      * Dupla kattintás engedélyezése/letiltása
      */
     void setDoubleClickEnabled(const bool &enabled) { doubleClickEnabled = enabled; }
-    const bool getDoubleClickEnabled() { return doubleClickEnabled; }
+    bool getDoubleClickEnabled() { return doubleClickEnabled; }
 
     /**
      * Az enkóder jelenlegi állapotának lekérdezése
@@ -12,9 +12,6 @@ bool bfoOn = false;
 #define AUDIO_MUTE_OFF false
 bool muteStat = false;
 
-// Squelch
-long squelchDecay = 0;
-
 // Scan
 bool SCANpause = true; // LWH - SCANpause must be initialized to a value else the squelch function will
 
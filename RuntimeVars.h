@@ -1,7 +1,7 @@
 #ifndef __RUNTIMEVARS_H
 #define __RUNTIMEVARS_H
 
-#include <sys/types.h>
+#include <stdint.h>
 
 // AGC
 extern uint8_t currentAGCgain;
@@ -16,10 +16,8 @@ extern bool bfoOn;
 extern bool muteStat;
 
 // Squelch
-#define SQUELCH_DECAY_TIME 500
 #define MIN_SQUELCH 0
 #define MAX_SQUELCH 50
-extern long squelchDecay;
 
 // Scan
 extern bool SCANpause;
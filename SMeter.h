@@ -20,7 +20,7 @@ private:
         uint8_t spoint;
         if (!isFM) {
             // dBuV to S point conversion HF
-            if ((rssi >= 0) and (rssi <= 1))
+            if (rssi <= 1)
                 spoint = 12; // S0
             if ((rssi > 1) and (rssi <= 2))
                 spoint = 24; // S1
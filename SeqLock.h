@@ -0,0 +1,56 @@
+#ifndef __SEQLOCK_H
+#define __SEQLOCK_H
+
+#include <atomic>
+#include <string.h>
+
+/**
+ * Szekvencia zár (seqlock) egy író és tetszőleges számú olvasó között
+ *
+ * Az író (pl.: core1) soha nem várakozik, az olvasó (pl.: core0) addig ismétli a másolást,
+ * amíg konzisztens (nem félbeírt) példányt nem kap. A T típusnak triviálisan másolhatónak kell lennie.
+ */
+template <typename T>
+class SeqLock {
+
+private:
+    std::atomic<uint32_t> sequence{0}; // Páratlan érték -> írás folyamatban
+    T data;
+
+public:
+    /**
+     * Új érték publikálása (csak egy író lehet!)
+     */
+    void write(const T &value) {
+        uint32_t seq = sequence.load(std::memory_order_relaxed);
+        sequence.store(seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        memcpy(&data, &value, sizeof(T));
+
+        sequence.store(seq + 2, std::memory_order_release);
+    }
+
+    /**
+     * Konzisztens másolat készítése
+     * @param out ide másoljuk az adatokat
+     */
+    void read(T &out) const {
+        uint32_t before, after;
+        do {
+            before = sequence.load(std::memory_order_acquire);
+            memcpy(&out, &data, sizeof(T));
+            std::atomic_thread_fence(std::memory_order_acquire);
+            after = sequence.load(std::memory_order_relaxed);
+        } while ((before & 1) or before != after);
+    }
+
+    /**
+     * Az utolsó publikálás sorszáma (a változás figyeléséhez)
+     */
+    uint32_t getVersion() const {
+        return sequence.load(std::memory_order_acquire) >> 1;
+    }
+};
+
+#endif // __SEQLOCK_H
@@ -0,0 +1,79 @@
+#include "SerialCommands.h"
+
+/**
+ * Parancs regisztrálása
+ */
+bool SerialCommands::addCommand(const char *name, const char *help, CommandCallback_t callback) {
+    if (commandCount >= SERIAL_CMD_MAX_COMMANDS) {
+        // Nem maradhat észrevétlen: induláskor a soros porton látszik, hogy a SERIAL_CMD_MAX_COMMANDS-ot emelni kell
+        Serial.printf("SerialCommands: betelt a parancs tabla (%d), a '%s' parancs kimarad\n", SERIAL_CMD_MAX_COMMANDS, name);
+        return false;
+    }
+    commands[commandCount++] = {name, help, callback};
+    return true;
+}
+
+/**
+ * A beérkezett karakterek feldolgozása
+ */
+void SerialCommands::poll() {
+
+    while (Serial.available() > 0) {
+        char c = Serial.read();
+
+        if (c == '\r' or c == '\n') {
+            if (lineLength > 0) {
+                line[lineLength] = '\0';
+                dispatch();
+                lineLength = 0;
+            }
+            continue;
+        }
+
+        // A túl hosszú sort csonkoljuk
+        if (lineLength < SERIAL_CMD_LINE_LENGTH) {
+            line[lineLength++] = c;
+        }
+    }
+}
+
+/**
+ * A beolvasott sor végrehajtása
+ */
+void SerialCommands::dispatch() {
+
+    // Parancs név és argumentumok szétválasztása
+    char *args = strchr(line, ' ');
+    if (args != nullptr) {
+        *args++ = '\0';
+        while (*args == ' ') {
+            args++;
+        }
+    } else {
+        args = line + lineLength; // üres string
+    }
+
+    if (strcmp(line, "help") == 0) {
+        printHelp();
+        return;
+    }
+
+    for (uint8_t i = 0; i < commandCount; i++) {
+        if (strcmp(line, commands[i].name) == 0) {
+            commands[i].callback(args);
+            return;
+        }
+    }
+
+    Serial.printf("Ismeretlen parancs: '%s' (help: parancsok listája)\n", line);
+}
+
+/**
+ * A parancsok listájának kiírása
+ */
+void SerialCommands::printHelp() {
+    Serial.printf("Parancsok:\n");
+    for (uint8_t i = 0; i < commandCount; i++) {
+        Serial.printf("  %-10s %s\n", commands[i].name, commands[i].help);
+    }
+}
@@ -0,0 +1,59 @@
+#ifndef __SERIALCOMMANDS_H
+#define __SERIALCOMMANDS_H
+
+#include <Arduino.h>
+#include <functional>
+
+#define SERIAL_CMD_MAX_COMMANDS 16 // Maximálisan regisztrálható parancsok száma
+#define SERIAL_CMD_LINE_LENGTH 48  // Egy parancssor maximális hossza
+
+/**
+ * Egyszerű, blokkolásmentes soros parancsértelmező
+ *
+ * A poll() csak a már beérkezett karaktereket olvassa ki, soha nem vár.
+ * Egy sor: '<parancs> [argumentumok]', a parancs nevét a callback nem kapja meg, csak az argumentumokat.
+ */
+class SerialCommands {
+
+public:
+    // Parancs callback típusa (argumentumok, üres string, ha nincs)
+    typedef std::function<void(const char *args)> CommandCallback_t;
+
+private:
+    struct Command_t {
+        const char *name;
+        const char *help;
+        CommandCallback_t callback;
+    };
+
+    Command_t commands[SERIAL_CMD_MAX_COMMANDS];
+    uint8_t commandCount = 0;
+
+    char line[SERIAL_CMD_LINE_LENGTH + 1];
+    uint8_t lineLength = 0;
+
+    void dispatch();
+    void printHelp();
+
+public:
+    /**
+     * Parancs regisztrálása
+     * @param name parancs neve
+     * @param help rövid leírás a 'help' parancshoz
+     * @param callback végrehajtandó függvény
+     * @return false, ha betelt a parancs tábla (ezt a soros portra is kiírja)
+     */
+    bool addCommand(const char *name, const char *help, CommandCallback_t callback);
+
+    /**
+     * A regisztrált parancsok száma
+     */
+    uint8_t getCommandCount() const { return commandCount; }
+
+    /**
+     * A beérkezett karakterek feldolgozása (blokkolásmentes)
+     */
+    void poll();
+};
+
+#endif // __SERIALCOMMANDS_H
@@ -0,0 +1,41 @@
+#include "SignalQualityCache.h"
+
+/**
+ * Jelminőség lekérése (csak akkor megy ki az I2C-re, ha a tárolt adat túl régi)
+ */
+const SignalQuality_t &SignalQualityCache::get(uint16_t maxAgeMsec) {
+
+    if (isFresh(maxAgeMsec)) {
+        hits++;
+    } else {
+        misses++;
+        refresh(0);
+    }
+
+    return data;
+}
+
+/**
+ * Azonnali lekérdezés
+ */
+const SignalQuality_t &SignalQualityCache::forceRefresh(bool intAck) {
+    misses++;
+    refresh(intAck ? 1 : 0);
+    return data;
+}
+
+/**
+ * RSQ_STATUS lekérdezése
+ */
+void SignalQualityCache::refresh(uint8_t intAck) {
+    si4735.getCurrentReceivedSignalQuality(intAck);
+    data.rssi = si4735.getCurrentRSSI();
+    data.snr = si4735.getCurrentSNR();
+    data.pilot = si4735.getCurrentPilot();
+    data.multipath = si4735.getCurrentMultipath();
+    data.freqOffset = si4735.getCurrentSignedFrequencyOffset();
+
+    // A 0 az érvénytelen adat jelzése
+    uint32_t now = millis();
+    data.timestamp = now ? now : 1;
+}
@@ -0,0 +1,77 @@
+#ifndef __SIGNALQUALITYCACHE_H
+#define __SIGNALQUALITYCACHE_H
+
+#include <SI4735.h>
+
+/**
+ * Jelminőség adatok (RSQ_STATUS) időbélyeggel
+ */
+struct SignalQuality_t {
+    uint32_t timestamp; // A lekérdezés ideje (millis), 0 -> még nincs érvényes adat
+    uint8_t rssi;
+    uint8_t snr;
+    bool pilot;         // Sztereo?
+    uint8_t multipath;  // Többutas terjedés (csak FM)
+    int8_t freqOffset;  // Frekvencia eltérés (kHz)
+};
+
+/**
+ * Időbélyeges jelminőség cache
+ *
+ * A fogyasztók megadják, milyen régi adatot fogadnak még el, a cache csak akkor kérdezi le a chipet (I2C),
+ * ha a tárolt adat ennél régebbi. Hangolás után érvényteleníteni kell.
+ * Csak a chipet birtokló core (core1) használhatja!
+ */
+class SignalQualityCache {
+
+private:
+    SI4735 &si4735;
+    SignalQuality_t data;
+
+    // Statisztika
+    uint32_t hits = 0;
+    uint32_t misses = 0;
+
+    void refresh(uint8_t intAck);
+
+public:
+    /**
+     * Konstruktor
+     */
+    SignalQualityCache(SI4735 &si4735) : si4735(si4735) {
+        memset(&data, 0, sizeof(data));
+    }
+
+    /**
+     * Jelminőség lekérése
+     * @param maxAgeMsec ennél régebbi adat esetén újra lekérdezzük a chipet
+     * @return a (legfeljebb maxAgeMsec korú) adatok
+     */
+    const SignalQuality_t &get(uint16_t maxAgeMsec);
+
+    /**
+     * Azonnali lekérdezés a kortól függetlenül (pl.: RSQ megszakítás után)
+     * @param intAck a függő RSQ megszakítás nyugtázása
+     */
+    const SignalQuality_t &forceRefresh(bool intAck);
+
+    /**
+     * Az adat elég friss?
+     */
+    bool isFresh(uint16_t maxAgeMsec) const {
+        return data.timestamp != 0 and millis() - data.timestamp <= maxAgeMsec;
+    }
+
+    /**
+     * A tárolt adat érvénytelenítése (pl.: hangolás után)
+     */
+    void invalidate() { data.timestamp = 0; }
+
+    /**
+     * Statisztika
+     */
+    uint32_t getHits() const { return hits; }
+    uint32_t getMisses() const { return misses; }
+};
+
+#endif // __SIGNALQUALITYCACHE_H
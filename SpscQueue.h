@@ -0,0 +1,62 @@
+#ifndef __SPSCQUEUE_H
+#define __SPSCQUEUE_H
+
+#include <atomic>
+#include <stdint.h>
+
+/**
+ * Lock-free, fix méretű FIFO egy termelő és egy fogyasztó között (Single Producer Single Consumer)
+ *
+ * A két core közötti parancsátadásra használjuk: a termelő csak a head-et, a fogyasztó csak a tail-t írja.
+ * @tparam T elemek típusa
+ * @tparam N a puffer mérete, 2 hatványának kell lennie (a tényleges kapacitás N - 1)
+ */
+template <typename T, uint16_t N>
+class SpscQueue {
+
+    static_assert(N >= 2 and (N & (N - 1)) == 0, "SpscQueue: N must be a power of 2");
+
+private:
+    T buffer[N];
+    std::atomic<uint16_t> head{0}; // A következő írási pozíció (termelő)
+    std::atomic<uint16_t> tail{0}; // A következő olvasási pozíció (fogyasztó)
+
+public:
+    /**
+     * Elem betétele (csak a termelő hívhatja)
+     * @return false, ha tele van a sor
+     */
+    bool push(const T &item) {
+        uint16_t h = head.load(std::memory_order_relaxed);
+        uint16_t next = (h + 1) & (N - 1);
+        if (next == tail.load(std::memory_order_acquire)) {
+            return false;
+        }
+        buffer[h] = item;
+        head.store(next, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * Elem kivétele (csak a fogyasztó hívhatja)
+     * @return false, ha üres a sor
+     */
+    bool pop(T &item) {
+        uint16_t t = tail.load(std::memory_order_relaxed);
+        if (t == head.load(std::memory_order_acquire)) {
+            return false;
+        }
+        item = buffer[t];
+        tail.store((t + 1) & (N - 1), std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * Üres a sor?
+     */
+    bool isEmpty() const {
+        return tail.load(std::memory_order_acquire) == head.load(std::memory_order_acquire);
+    }
+};
+
+#endif // __SPSCQUEUE_H
@@ -0,0 +1,81 @@
+#include "Squelch.h"
+#include "RuntimeVars.h"
+
+/**
+ * Egy minta feldolgozása
+ */
+void Squelch::process() {
+
+    // Felhasználói némítás alatt nem avatkozunk be, utána újra döntünk
+    if (muteStat) {
+        state = UNKNOWN;
+        return;
+    }
+
+    // Nincs zajzár: folyamatosan nyitva
+    uint8_t squelch = config.data.currentSquelch;
+    if (squelch == MIN_SQUELCH) {
+        setState(OPEN);
+        return;
+    }
+
+    // Hangolás vagy band váltás: a pillanatképet csak akkor másoljuk, ha a core1 újat publikált
+    uint32_t version = radioService.getSnapshotVersion();
+    if (version != snapshotVersion) {
+        snapshotVersion = version;
+        RadioSnapshot_t snapshot;
+        radioService.getSnapshot(snapshot);
+        if (snapshot.frequency != lastFrequency or snapshot.bandIdx != lastBandIdx) {
+            lastFrequency = snapshot.frequency;
+            lastBandIdx = snapshot.bandIdx;
+            reset();
+        }
+    }
+
+    // A jelminőséget a core1 cache-éből vesszük (csak akkor megy I2C-re, ha régebbi a megengedettnél)
+    SignalQuality_t signal;
+    radioService.getSignalQuality(signal, radioService.isInterruptEnabled() ? SQUELCH_SIGNAL_MAX_AGE_IRQ_MSEC : SQUELCH_SIGNAL_MAX_AGE_MSEC);
+    if (signal.timestamp == 0) {
+        return; // Hangolás után még nincs friss adat
+    }
+    samples++;
+
+    // Simítás: levelQ8 += (minta - levelQ8) * k, ahol k felfutáskor SQUELCH_ATTACK_Q8, lecsengéskor SQUELCH_DECAY_Q8
+    // (felfelé kerekítünk felfutáskor, lefelé lecsengéskor, így a simított érték mindkét irányban eléri a mintát)
+    int32_t sampleQ8 = (config.data.squelchUsesRSSI ? signal.rssi : signal.snr) << 8;
+    int32_t diff = sampleQ8 - levelQ8;
+    if (state == UNKNOWN or !seeded) {
+        levelQ8 = sampleQ8; // Az első mintát elfogadjuk
+        seeded = true;
+    } else if (diff > 0) {
+        levelQ8 += (diff * SQUELCH_ATTACK_Q8 + 255) >> 8;
+    } else {
+        levelQ8 += (diff * SQUELCH_DECAY_Q8) >> 8;
+    }
+
+    // Hiszterézis: nyitás a beállított szinten, zárás alatta
+    uint8_t level = levelQ8 >> 8;
+    if (state != OPEN and level >= getOpenThreshold(squelch)) {
+        // Scan közben nem nyitunk
+        if (SCANpause) {
+            setState(OPEN);
+        }
+    } else if (state != CLOSED and level < getCloseThreshold(squelch)) {
+        setState(CLOSED);
+    } else if (state == UNKNOWN) {
+        // A hiszterézis sávban indultunk: zárva maradunk
+        setState(CLOSED);
+    }
+}
+
+/**
+ * Állapotváltás: csak ekkor küldünk némítás parancsot
+ */
+void Squelch::setState(State newState) {
+    if (newState == state) {
+        return;
+    }
+    state = newState;
+    transitions++;
+    radioService.postCommand(RadioService::SET_MUTE, newState == CLOSED ? AUDIO_MUTE_ON : AUDIO_MUTE_OFF);
+}
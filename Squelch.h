@@ -0,0 +1,78 @@
+#ifndef __SQUELCH_H
+#define __SQUELCH_H
+
+#include "Config.h"
+#include "RadioService.h"
+
+#define SQUELCH_SAMPLE_PERIOD_MSEC 50         // Mintavételezés (a zajzár task periódusa)
+#define SQUELCH_SIGNAL_MAX_AGE_MSEC 200       // A zajzárhoz elfogadott legrégebbi jelminőség adat
+#define SQUELCH_SIGNAL_MAX_AGE_IRQ_MSEC 2000  // Ugyanez megszakítás módban (a küszöb átlépését a chip jelzi)
+#define SQUELCH_HYSTERESIS 3                  // A zárási küszöb ennyivel van a nyitási (beállított) szint alatt
+#define SQUELCH_ATTACK_Q8 192                 // Felfutási együttható (Q8, 256 = azonnal követi a jelet)
+#define SQUELCH_DECAY_Q8 64                   // Lecsengési együttható (Q8, kisebb -> lassabban zár)
+
+/**
+ * Zajzár
+ *
+ * A jelszintet (RSSI vagy SNR) fixpontos (Q8), aszimmetrikus exponenciális átlaggal simítjuk: gyors felfutás, lassú lecsengés.
+ * A zajzár a beállított szintnél nyit, és csak SQUELCH_HYSTERESIS-szel alatta zár, így a küszöb körül nem "kattog".
+ * Némítás parancsot (I2C írás) csak tényleges állapotváltáskor küldünk.
+ */
+class Squelch {
+
+public:
+    enum State : uint8_t {
+        UNKNOWN = 0, // Még nem döntöttünk (pl.: a felhasználói némítás után), a következő mintánál mindenképp küldünk parancsot
+        OPEN,        // Szól
+        CLOSED       // Némítva
+    };
+
+private:
+    RadioService &radioService;
+    Config &config;
+
+    uint16_t levelQ8 = 0; // Simított jelszint (Q8)
+    bool seeded = false;  // Van már kiinduló minta a simításhoz?
+    State state = UNKNOWN;
+
+    // A legutóbb látott hangolás (a pillanatképből, csak ha az változott)
+    uint32_t snapshotVersion = 0;
+    uint16_t lastFrequency = 0;
+    uint8_t lastBandIdx = 0;
+
+    // Statisztika
+    uint32_t samples = 0;
+    uint32_t transitions = 0;
+
+    void setState(State newState);
+
+public:
+    /**
+     * Konstruktor
+     */
+    Squelch(RadioService &radioService, Config &config) : radioService(radioService), config(config) {}
+
+    /**
+     * Egy minta feldolgozása (a zajzár task hívja SQUELCH_SAMPLE_PERIOD_MSEC-enként)
+     */
+    void process();
+
+    /**
+     * A simítás újraindítása (hangolás vagy band váltás után): a következő minta lesz a kiinduló szint,
+     * így az előző állomás szintje nem késlelteti a döntést. A némítás állapota marad (nincs fölösleges parancs)
+     */
+    void reset() { seeded = false; }
+
+    /**
+     * Nyitási/zárási küszöb a beállított szintből
+     */
+    static inline uint8_t getOpenThreshold(uint8_t squelch) { return squelch; }
+    static inline uint8_t getCloseThreshold(uint8_t squelch) { return squelch > SQUELCH_HYSTERESIS ? squelch - SQUELCH_HYSTERESIS : 0; }
+
+    State getState() const { return state; }
+    uint8_t getLevel() const { return levelQ8 >> 8; }
+    uint32_t getTransitions() const { return transitions; }
+    uint32_t getSamples() const { return samples; }
+};
+
+#endif // __SQUELCH_H
@@ -0,0 +1,217 @@
+#include "StationScanner.h"
+#include "utils.h"
+
+/**
+ * Állapotváltás
+ */
+void StationScanner::setState(State newState) {
+    state = newState;
+    stateStartMsec = millis();
+}
+
+/**
+ * Keresés indítása
+ */
+void StationScanner::start() {
+
+    if (state != IDLE) {
+        return;
+    }
+
+    // A seek csak FM és AM módban működik (SSB/szinkron AM patch-csel nem)
+    if (band.currentMode != FM and (band.currentMode != AM or band.isSSBLoaded())) {
+        DEBUG("StationScanner: ebben a módban nincs keresés\n");
+        refused.store(true, std::memory_order_release);
+        return;
+    }
+    refused.store(false, std::memory_order_release);
+
+    savedFrequency = si4735.getCurrentFrequency();
+    lastFrequency = 0;
+    count.store(0, std::memory_order_relaxed);
+    scanStartMsec = millis();
+
+    // Keresés közben nem szólunk, a band aljától indulunk
+    band.getPropertyShadow().setVolume(0);
+    si4735.setMaxDelaySetFrequency(0);
+    si4735.setFrequency(band.getBandDesc(config.data.bandIdx).minimumFreq);
+    setState(WAIT_START);
+    running.store(true, std::memory_order_release);
+}
+
+/**
+ * A keresés vége: hangolás a megadott frekvenciára
+ */
+void StationScanner::finish(uint16_t frequency) {
+
+    // Egy még futó seek/hangolás STC-jét nyugtázzuk, majd a könyvtár szokásos várakozásával hangolunk
+    si4735.getStatus(1, 0);
+    si4735.setMaxDelaySetFrequency(SI4735_TUNE_DELAY_MSEC);
+    si4735.setFrequency(frequency);
+    band.getPropertyShadow().setVolume(config.data.currentVOL);
+
+    state = IDLE;
+    running.store(false, std::memory_order_release);
+}
+
+/**
+ * Keresés megszakítása
+ */
+void StationScanner::stop() {
+    if (state != IDLE) {
+        finish(savedFrequency);
+    }
+}
+
+/**
+ * Állomás beszúrása a jelerősség (RSSI, azon belül SNR) szerint csökkenő sorrendbe
+ * Ha a tábla tele van, a leggyengébb kiesik (vagy az új, ha az a leggyengébb)
+ */
+void StationScanner::insert(const StationEntry_t &entry) {
+
+    uint8_t n = count.load(std::memory_order_relaxed);
+    int16_t i = n < STATION_DB_SIZE ? n : STATION_DB_SIZE - 1;
+
+    auto weaker = [](const StationEntry_t &a, const StationEntry_t &b) {
+        return a.rssi < b.rssi or (a.rssi == b.rssi and a.snr < b.snr);
+    };
+    if (n == STATION_DB_SIZE and !weaker(entries[i], entry)) {
+        return;
+    }
+
+    while (i > 0 and weaker(entries[i - 1], entry)) {
+        entries[i] = entries[i - 1];
+        i--;
+    }
+    entries[i] = entry;
+
+    if (n < STATION_DB_SIZE) {
+        count.store(n + 1, std::memory_order_release);
+    }
+}
+
+/**
+ * RDS PI/PS gyűjtése az aktuális állomáson
+ */
+void StationScanner::collectRds() {
+
+    si4735.getRdsStatus();
+    if (!si4735.getRdsReceived() or !si4735.getRdsSync()) {
+        return;
+    }
+
+    if (pending.pi == 0) {
+        pending.pi = si4735.getRdsPI();
+    }
+    char *ps = si4735.getRdsText0A();
+    if (ps != NULL and ps[0] != '\0') {
+        strncpy(pending.ps, ps, STATION_PS_LENGTH);
+    }
+}
+
+/**
+ * A keresés következő lépése
+ */
+void StationScanner::service() {
+
+    switch (state) {
+
+    case WAIT_START:
+    case WAIT_STC: {
+        if (!si4735.getInterruptStatus().resp.STCINT) {
+            if (millis() - stateStartMsec >= STATION_SCAN_STC_TIMEOUT_MSEC) {
+                DEBUG("StationScanner: időtúllépés, a keresés leállt\n");
+                finish(count.load(std::memory_order_relaxed) ? entries[0].frequency : savedFrequency);
+            }
+            break;
+        }
+
+        si4735.getStatus(1, 0);
+        if (state == WAIT_START) {
+            setState(SEEK);
+            break;
+        }
+
+        // A seek a band tetejénél megállt, vagy nem jutott tovább: vége
+        uint16_t frequency = si4735.getFrequency();
+        if (si4735.getBandLimit() or !si4735.getStatusValid() or frequency <= lastFrequency) {
+            lastScanMsec = millis() - scanStartMsec;
+            DEBUG("StationScanner: %d állomás, %lu msec\n", getCount(), lastScanMsec);
+            finish(count.load(std::memory_order_relaxed) ? entries[0].frequency : savedFrequency);
+            break;
+        }
+
+        lastFrequency = frequency;
+        memset(&pending, 0, sizeof(pending));
+        pending.frequency = frequency;
+        pending.rssi = si4735.getReceivedSignalStrengthIndicator();
+        pending.snr = si4735.getStatusSNR();
+
+        // FM-ben, elég erős jelnél várunk az RDS-re
+        if (band.currentMode == FM and pending.snr >= STATION_SCAN_RDS_MIN_SNR) {
+            si4735.RdsInit();
+            lastRdsPollMsec = millis();
+            setState(WAIT_RDS);
+        } else {
+            insert(pending);
+            setState(SEEK);
+        }
+        break;
+    }
+
+    case WAIT_RDS: {
+        uint32_t now = millis();
+        if (now - lastRdsPollMsec >= STATION_SCAN_RDS_POLL_MSEC) {
+            lastRdsPollMsec = now;
+            collectRds();
+        }
+        // Megvan a PI és a teljes PS, vagy letelt az idő
+        if ((pending.pi != 0 and pending.ps[STATION_PS_LENGTH - 1] != '\0') or now - stateStartMsec >= STATION_SCAN_RDS_DWELL_MSEC) {
+            insert(pending);
+            setState(SEEK);
+        }
+        break;
+    }
+
+    case SEEK:
+        si4735.seekStation(1, 0); // Felfelé, wrap nélkül
+        setState(WAIT_STC);
+        break;
+
+    default:
+        break;
+    }
+}
+
+/**
+ * Az állomás indexe a frekvencia alapján
+ */
+int8_t StationScanner::find(uint16_t frequency) const {
+    for (uint8_t i = 0; i < getCount(); i++) {
+        if (entries[i].frequency == frequency) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+/**
+ * A tábla kiírása a soros portra
+ */
+void StationScanner::dump() const {
+
+    Serial.printf("===== Stations =====\n");
+    Serial.printf("Scanning: %s, found: %u, last scan: %lu msec\n", isRunning() ? "yes" : isRefused() ? "refused (SSB mode)" : "no", getCount(), lastScanMsec);
+    if (!isRunning()) {
+        for (uint8_t i = 0; i < getCount(); i++) {
+            const StationEntry_t &entry = entries[i];
+            int8_t bandIdx = band.findBandByKHz(band.toKHz(config.data.bandIdx, entry.frequency)); // A legszűkebb band (pl.: SW-n a 49M)
+            Serial.printf("%2u: %5u %-4s RSSI %2u SNR %2u", i, entry.frequency, bandIdx < 0 ? "-" : band.getBandDesc(bandIdx).bandName, entry.rssi, entry.snr);
+            if (entry.pi) {
+                Serial.printf(" PI %04X '%.8s'", entry.pi, entry.ps);
+            }
+            Serial.printf("\n");
+        }
+    }
+    Serial.printf("---\n");
+}
@@ -0,0 +1,133 @@
+#ifndef __STATIONSCANNER_H
+#define __STATIONSCANNER_H
+
+#include "Band.h"
+#include "Config.h"
+#include <SI4735.h>
+#include <atomic>
+
+#define STATION_DB_SIZE 64               // A megtalált állomások max. száma
+#define STATION_PS_LENGTH 8              // RDS PS (állomásnév) hossza
+#define STATION_SCAN_STC_TIMEOUT_MSEC 10000 // Egy seek max. ideje (a teljes band, ha nincs állomás)
+#define STATION_SCAN_RDS_DWELL_MSEC 1500   // Ennyi ideig várunk az RDS PI/PS-re egy állomáson (FM)
+#define STATION_SCAN_RDS_POLL_MSEC 40      // RDS lekérdezés a várakozás alatt (egy RDS csoport ~88msec)
+#define STATION_SCAN_RDS_MIN_SNR 10        // Ennél gyengébb állomáson nem várunk RDS-re
+
+// Egy megtalált állomás (packed: 14 bájt)
+struct __attribute__((packed)) StationEntry_t {
+    uint16_t frequency;
+    uint8_t rssi;
+    uint8_t snr;
+    uint16_t pi;                  // RDS program azonosító (0: nincs)
+    char ps[STATION_PS_LENGTH];   // RDS állomásnév (nem lezárt, '\0'-val kitöltve)
+};
+
+/**
+ * Állomás kereső (scan-all)
+ *
+ * A core1-en fut (a RadioService hívja a service()-t), lépésenként, soha nem vár.
+ * A band aljáról a chip seek funkciójával (SEEK_START, wrap nélkül) keres felfelé, amíg a band tetejét el nem éri.
+ * Minden megállásnál a TUNE_STATUS-ból eltesszük a frekvenciát, az RSSI-t és az SNR-t, FM-ben elég erős jelnél
+ * rövid ideig az RDS PI/PS-re is várunk.
+ *
+ * A találatok egy fix méretű statikus tömbbe kerülnek (nincs heap), jelerősség szerint csökkenő sorrendben
+ * (beszúrásos rendezéssel, így a tábla keresés közben is mindig rendezett).
+ * A core0 csak a keresés vége után olvassa a táblát (isRunning() == false), a keresés közben csak a darabszámot.
+ * A végén a legerősebb állomásra hangolunk, megszakításkor vissza az eredeti frekvenciára.
+ */
+class StationScanner {
+
+private:
+    enum State : uint8_t {
+        IDLE = 0,
+        WAIT_START, // A band aljára hangolunk
+        SEEK,       // A következő seek indítása
+        WAIT_STC,   // A seek végére várunk
+        WAIT_RDS    // RDS PI/PS gyűjtése az állomáson
+    };
+
+    SI4735 &si4735;
+    Band &band;
+    Config &config;
+
+    State state = IDLE;
+    uint16_t savedFrequency = 0;
+    uint16_t lastFrequency = 0; // Az utolsó megállás (ha a seek nem jut tovább, vége)
+    uint32_t stateStartMsec = 0;
+    uint32_t lastRdsPollMsec = 0;
+    uint32_t scanStartMsec = 0;
+    uint32_t lastScanMsec = 0;
+    StationEntry_t pending; // Az aktuális állomás (az RDS várakozás alatt)
+
+    // A tábla (a keresés alatt csak a core1 írja)
+    StationEntry_t entries[STATION_DB_SIZE];
+    std::atomic<uint8_t> count{0};
+    std::atomic<bool> running{false};
+    std::atomic<bool> refused{false}; // Az utolsó indítást a mód miatt (SSB) elutasította
+
+    void setState(State newState);
+    void insert(const StationEntry_t &entry);
+    void finish(uint16_t frequency);
+    void collectRds();
+
+public:
+    /**
+     * Konstruktor
+     */
+    StationScanner(SI4735 &si4735, Band &band, Config &config) : si4735(si4735), band(band), config(config) {}
+
+    /**
+     * Keresés indítása az aktuális band-en (core1)
+     * SSB módban (és betöltött patch mellett) a chip nem tud keresni, ekkor nem indul, és az isRefused() jelzi
+     * A patch-csel vett (szinkron) AM-ből a RadioService indítás előtt sima AM-be indítja újra a chipet
+     */
+    void start();
+
+    /**
+     * Keresés megszakítása, visszahangolás az eredeti frekvenciára (core1)
+     */
+    void stop();
+
+    /**
+     * A keresés következő lépése, soha nem vár (core1)
+     */
+    void service();
+
+    /**
+     * Fut a keresés? (core0-ról is hívható)
+     */
+    bool isRunning() const { return running.load(std::memory_order_acquire); }
+
+    /**
+     * Az utolsó indítást a mód miatt elutasította? (core0-ról is hívható, a következő sikeres indításig marad)
+     */
+    bool isRefused() const { return refused.load(std::memory_order_acquire); }
+
+    /**
+     * A megtalált állomások száma (core0-ról is hívható)
+     */
+    uint8_t getCount() const { return count.load(std::memory_order_acquire); }
+
+    /**
+     * Egy állomás (jelerősség szerinti sorrendben, 0: a legerősebb), csak a keresés után olvasható a core0-ról
+     */
+    const StationEntry_t &getEntry(uint8_t idx) const { return entries[idx]; }
+
+    /**
+     * Az állomás indexe a frekvencia alapján
+     * @return -1, ha nincs a táblában
+     */
+    int8_t find(uint16_t frequency) const;
+
+    /**
+     * Az utolsó teljes keresés ideje
+     */
+    uint32_t getLastScanMsec() const { return lastScanMsec; }
+
+    /**
+     * A tábla kiírása a soros portra
+     */
+    void dump() const;
+};
+
+#endif // __STATIONSCANNER_H
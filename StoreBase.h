@@ -2,11 +2,15 @@
 #define __STOREBASE_H
 #include "EepromManager.h"
 #include <Arduino.h>
+#include <CoreMutex.h>
 #include <Ticker.h>
 #include <list>
 
 /**
  * Generikus wrapper ősosztály a mentés és betöltés + CRC számítás funkciókhoz
+ *
+ * A mentés nem az élő adatokon dolgozik: a checkSave() egy rövid zár alatt (egy memcpy ideje) pillanatképet készít,
+ * a CRC számítás és az EEPROM írás már a pillanatképen, zár nélkül történik. Így a mentés nem blokkolja a UI-t.
  */
 template <typename T>
 class StoreBase {
@@ -15,6 +19,20 @@ private:
     // A tárolt adatok CRC32 ellenőrző összege
     uint16_t lastCRC = 0;
 
+    // A pillanatkép készítését és az összefüggő módosításokat védő zár
+    mutex_t dataMutex;
+
+    // A mentéshez használt pillanatkép (nem a stack-en, a T mérete miatt)
+    T snapshot;
+
+    /**
+     * Pillanatkép készítése a tárolt adatokról
+     */
+    void takeSnapshot() {
+        CoreMutex mtx(&dataMutex);
+        memcpy(&snapshot, &r(), sizeof(T));
+    }
+
 protected:
     /**
      * Referencia az adattagra, ez az ős használja
@@ -22,11 +40,31 @@ protected:
     virtual T &r() = 0;
 
 public:
+    /**
+     * Rövid zár a tárolt adatok több mezős, összefüggő módosításához
+     * A zár alatt a mentés nem készíthet pillanatképet, így nem kerülhet félkész állapot az EEPROM-ba
+     */
+    class UpdateLock {
+    private:
+        CoreMutex mtx;
+
+    public:
+        UpdateLock(StoreBase<T> &store) : mtx(&store.dataMutex) {}
+    };
+
+    /**
+     * Konstruktor
+     */
+    StoreBase() {
+        mutex_init(&dataMutex);
+    }
+
     /**
      * Tárolt adatok mentése
      */
     virtual void forceSave() {
-        EepromManager<T>::save(r());
+        takeSnapshot();
+        lastCRC = EepromManager<T>::save(snapshot);
     }
 
     /**
@@ -47,9 +85,12 @@ public:
      */
     virtual void checkSave() final {
 
-        uint16_t crc = calcCRC16((uint8_t *)&r(), sizeof(T));
+        // A CRC számítás és a mentés már a pillanatképen történik, zár nélkül
+        takeSnapshot();
+
+        uint16_t crc = calcCRC16((uint8_t *)&snapshot, sizeof(T));
         if (lastCRC != crc) {
-            crc = EepromManager<T>::save(r());
+            crc = EepromManager<T>::save(snapshot);
             lastCRC = crc;
             DEBUG("EEPROM save end, crc = %d\n", crc);
         }
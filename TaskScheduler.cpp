@@ -0,0 +1,163 @@
+#include "TaskScheduler.h"
+#include "utils.h"
+
+/**
+ * Task regisztrálása
+ */
+int8_t TaskScheduler::addTask(const char *name, uint32_t periodMsec, uint32_t deadlineMsec, Priority priority, TaskCallback_t callback) {
+
+    if (taskCount >= TASK_SCHEDULER_MAX_TASKS) {
+        DEBUG("TaskScheduler: betelt a task tábla, '%s' nem regisztrálható!\n", name);
+        return TASK_INVALID_ID;
+    }
+
+    Task_t &task = tasks[taskCount];
+    task.name = name;
+    task.callback = callback;
+    task.periodMsec = periodMsec;
+    task.deadlineMsec = deadlineMsec == 0 ? periodMsec : deadlineMsec;
+    task.releaseMsec = millis(); // Az első futás azonnal esedékes
+    task.priority = priority;
+    task.enabled = true;
+    task.runs = 0;
+    task.deadlineMisses = 0;
+    task.maxRunMsec = 0;
+
+    return taskCount++;
+}
+
+/**
+ * Task engedélyezése/tiltása
+ */
+void TaskScheduler::setEnabled(int8_t taskId, bool enabled) {
+    if (taskId < 0 or taskId >= taskCount) {
+        return;
+    }
+
+    // Engedélyezéskor azonnal esedékes legyen
+    if (enabled and !tasks[taskId].enabled) {
+        tasks[taskId].releaseMsec = millis();
+    }
+    tasks[taskId].enabled = enabled;
+}
+
+/**
+ * A task következő futásának elhalasztása
+ */
+void TaskScheduler::postpone(int8_t taskId, uint32_t delayMsec) {
+    if (taskId >= 0 and taskId < taskCount) {
+        tasks[taskId].releaseMsec = millis() + delayMsec;
+    }
+}
+
+/**
+ * A task azonnali futtatásának kérése
+ */
+void TaskScheduler::trigger(int8_t taskId) {
+    if (taskId >= 0 and taskId < taskCount) {
+        tasks[taskId].releaseMsec = millis();
+    }
+}
+
+/**
+ * A lejárt taskok közül a következő futtatandó kiválasztása
+ * Elsődleges szempont a prioritás, azonos prioritásnál a legkorábbi abszolút határidő
+ */
+int8_t TaskScheduler::selectNext(uint32_t now) {
+
+    int8_t selected = TASK_INVALID_ID;
+    uint32_t selectedDeadline = 0;
+
+    for (uint8_t i = 0; i < taskCount; i++) {
+        const Task_t &task = tasks[i];
+
+        // Nem futtatható, vagy még nem esedékes (a millis() átfordulását is kezeljük)
+        if (!task.enabled or (int32_t)(now - task.releaseMsec) < 0) {
+            continue;
+        }
+
+        uint32_t deadline = task.releaseMsec + task.deadlineMsec;
+        if (selected == TASK_INVALID_ID                                                                     //
+            or task.priority > tasks[selected].priority                                                     //
+            or (task.priority == tasks[selected].priority and (int32_t)(deadline - selectedDeadline) < 0)) { //
+            selected = i;
+            selectedDeadline = deadline;
+        }
+    }
+
+    return selected;
+}
+
+/**
+ * A következő futtatható task futtatása
+ */
+bool TaskScheduler::runNext() {
+
+    uint32_t now = millis();
+    int8_t taskId = selectNext(now);
+    if (taskId == TASK_INVALID_ID) {
+        return false;
+    }
+
+    Task_t &task = tasks[taskId];
+
+    // Határidő túllépés?
+    if ((int32_t)(now - (task.releaseMsec + task.deadlineMsec)) > 0) {
+        task.deadlineMisses++;
+    }
+
+    // Következő kiadás: periódusonként lépünk, de ha nagyon lemaradtunk, akkor nem futtatjuk le a kimaradt periódusokat
+    task.releaseMsec += task.periodMsec;
+    if ((int32_t)(now - task.releaseMsec) >= 0) {
+        task.releaseMsec = now + task.periodMsec;
+    }
+
+    task.callback();
+
+    uint32_t runMsec = millis() - now;
+    if (runMsec > task.maxRunMsec) {
+        task.maxRunMsec = runMsec;
+    }
+    task.runs++;
+
+    return true;
+}
+
+/**
+ * Hány msec múlva lesz futtatható a következő task?
+ */
+uint32_t TaskScheduler::getMsecToNextRelease() {
+
+    uint32_t now = millis();
+    uint32_t minWait = UINT32_MAX;
+
+    for (uint8_t i = 0; i < taskCount; i++) {
+        if (!tasks[i].enabled) {
+            continue;
+        }
+
+        int32_t wait = (int32_t)(tasks[i].releaseMsec - now);
+        if (wait <= 0) {
+            return 0;
+        }
+        if ((uint32_t)wait < minWait) {
+            minWait = wait;
+        }
+    }
+
+    return minWait;
+}
+
+/**
+ * Task statisztikák kiírása a soros portra
+ */
+void TaskScheduler::debugTaskStats() {
+    Serial.printf("===== Task stats =====\n");
+    Serial.printf("Name\t\tPeriod\tDeadl.\tPrio\tRuns\tMisses\tMax\n");
+    for (uint8_t i = 0; i < taskCount; i++) {
+        const Task_t &task = tasks[i];
+        Serial.printf("%-12s\t%lu\t%lu\t%d\t%lu\t%lu\t%lu\n",
+                      task.name, task.periodMsec, task.deadlineMsec, task.priority, task.runs, task.deadlineMisses, task.maxRunMsec);
+    }
+    Serial.printf("---\n");
+}
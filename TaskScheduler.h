@@ -0,0 +1,121 @@
+#ifndef __TASKSCHEDULER_H
+#define __TASKSCHEDULER_H
+
+#include <Arduino.h>
+#include <functional>
+
+#define TASK_SCHEDULER_MAX_TASKS 12 // Maximálisan regisztrálható taskok száma (statikus tömb, nincs heap)
+#define TASK_INVALID_ID -1          // Érvénytelen task ID (pl.: betelt a task tábla)
+
+/**
+ * Kooperatív, határidő alapú task ütemező
+ *
+ * Minden task saját periódussal, határidővel és prioritással rendelkezik.
+ * A runNext() egyszerre csak egy taskot futtat: a lejárt taskok közül a legnagyobb prioritásút,
+ * azonos prioritás esetén a legkorábbi határidejűt (EDF). Így a magas prioritású taskok (pl.: rotary encoder)
+ * késleltetése legfeljebb egyetlen másik task futásideje lehet.
+ */
+class TaskScheduler {
+
+public:
+    // Task callback típusa
+    typedef std::function<void()> TaskCallback_t;
+
+    // Task prioritások (nagyobb érték -> nagyobb prioritás)
+    enum Priority : uint8_t {
+        PRIO_LOW = 0,
+        PRIO_NORMAL = 1,
+        PRIO_HIGH = 2,
+        PRIO_REALTIME = 3
+    };
+
+    // Egy task adatai
+    struct Task_t {
+        const char *name;        // Task neve (debug)
+        TaskCallback_t callback; // Futtatandó függvény
+        uint32_t periodMsec;     // Periódusidő
+        uint32_t deadlineMsec;   // Relatív határidő a kiadástól (release) számítva
+        uint32_t releaseMsec;    // A következő kiadás időpontja
+        uint8_t priority;        // Prioritás
+        bool enabled;            // Engedélyezve van?
+        uint32_t runs;           // Futások száma
+        uint32_t deadlineMisses; // Határidő túllépések száma
+        uint32_t maxRunMsec;     // A leghosszabb futásidő
+    };
+
+private:
+    Task_t tasks[TASK_SCHEDULER_MAX_TASKS];
+    uint8_t taskCount = 0;
+
+    /**
+     * A lejárt taskok közül a következő futtatandó kiválasztása
+     * @param now aktuális idő
+     * @return a task indexe vagy TASK_INVALID_ID, ha nincs futtatható task
+     */
+    int8_t selectNext(uint32_t now);
+
+public:
+    /**
+     * Konstruktor
+     */
+    TaskScheduler() = default;
+
+    /**
+     * Task regisztrálása
+     * @param name task neve
+     * @param periodMsec periódusidő
+     * @param deadlineMsec relatív határidő (0 esetén a periódusidő)
+     * @param priority prioritás
+     * @param callback futtatandó függvény
+     * @return a task ID-je vagy TASK_INVALID_ID, ha betelt a task tábla
+     */
+    int8_t addTask(const char *name, uint32_t periodMsec, uint32_t deadlineMsec, Priority priority, TaskCallback_t callback);
+
+    /**
+     * Task engedélyezése/tiltása
+     */
+    void setEnabled(int8_t taskId, bool enabled);
+
+    /**
+     * A task következő futásának elhalasztása
+     * @param taskId task ID
+     * @param delayMsec ennyi msec múlva fusson legközelebb
+     */
+    void postpone(int8_t taskId, uint32_t delayMsec);
+
+    /**
+     * A task azonnali futtatásának kérése (a következő runNext() hívásnál futhat)
+     */
+    void trigger(int8_t taskId);
+
+    /**
+     * A következő futtatható task futtatása
+     * @return true, ha futott task
+     */
+    bool runNext();
+
+    /**
+     * Hány msec múlva lesz futtatható a következő task?
+     * @return 0, ha már van lejárt task
+     */
+    uint32_t getMsecToNextRelease();
+
+    /**
+     * Task adatainak lekérése (debug/statisztika)
+     */
+    const Task_t *getTask(int8_t taskId) const {
+        return (taskId >= 0 and taskId < taskCount) ? &tasks[taskId] : nullptr;
+    }
+
+    /**
+     * Regisztrált taskok száma
+     */
+    uint8_t getTaskCount() const { return taskCount; }
+
+    /**
+     * Task statisztikák kiírása a soros portra
+     */
+    void debugTaskStats();
+};
+
+#endif // __TASKSCHEDULER_H
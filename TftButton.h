@@ -111,14 +111,14 @@ public:
      * Konstruktor
      */
     TftButton(uint8_t id, TFT_eSPI &tft, uint16_t x, uint16_t y, uint16_t w, uint16_t h, const char *label, ButtonType_t type, ButtonCallback_t callback = nullptr, ButtonState_t state = OFF)
-        : id(id), pTft(&tft), x(x), y(y), w(w), h(h), label(label), type(type), callback(callback), buttonPressed(false), state(state), oldState(state) {}
+        : pTft(&tft), x(x), y(y), w(w), h(h), id(id), label(label), state(state), oldState(state), type(type), callback(callback), buttonPressed(false) {}
 
     /**
      * Konstruktor X/Y pozíció nélkül
      * Automatikus elrendezéshez csak a szélesség és a magasság van megadva
      */
     TftButton(uint8_t id, TFT_eSPI &tft, uint16_t w, uint16_t h, const char *label, ButtonType_t type, ButtonCallback_t callback = NULL, ButtonState_t state = OFF)
-        : id(id), pTft(&tft), x(0), y(0), w(w), h(h), label(label), type(type), callback(callback), buttonPressed(false), state(state), oldState(state) {}
+        : pTft(&tft), x(0), y(0), w(w), h(h), id(id), label(label), state(state), oldState(state), type(type), callback(callback), buttonPressed(false) {}
 
     // A label F() makróval megadva
     // TftButton(uint8_t id, TFT_eSPI &tft, uint16_t x, uint16_t y, uint16_t w, uint16_t h, const __FlashStringHelper *label, ButtonType_t type, ButtonCallback_t callback = nullptr, ButtonState_t state = OFF)
@@ -5,6 +5,8 @@
 #define PIN_SI4735_I2C_SDA 8
 #define PIN_SI4735_I2C_SCL 9
 #define PIN_SI4735_RESET 10
+// Si473x GPO2/INT (opcionális, aktív LOW): ha be van kötve, az RDS/RSQ eseményeket megszakításból kezeljük, nem pollingolunk
+// #define PIN_SI4735_INT 11
 
 // Rotary Encoder
 #define PIN_ENCODER_CLK 16
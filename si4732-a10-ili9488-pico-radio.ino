@@ -30,17 +30,26 @@ RotaryEncoder rotaryEncoder = RotaryEncoder(PIN_ENCODER_CLK, PIN_ENCODER_DT, PIN
 SI4735 si4735;
 
 //------------------- EEPROM Config
-#define EEPROM_SAVE_CHECK_TICKER_INTERVAL_SECONDS 60 * 5 // 5 perc
-Ticker eepromSaveChecker;
-auto_init_mutex(saveEepromMutex); // Core lock, az EEPROM írásánálhasználjuk
+#define EEPROM_SAVE_CHECK_INTERVAL_MSEC 1000 * 60 * 5 // 5 perc
 
 #include "Config.h"
 Config config;
 
 //------------------- Band
 #include "Band.h"
+#include "I2cClockTuner.h"
 Band band(si4735, config);
 
+#include "BandStore.h"
+BandStore bandStore(band); // A band-enkénti hangolási állapot (frekvencia, lépésköz, BFO)
+
+#include "I2cClockStore.h"
+I2cClockStore i2cClockStore; // A kalibrált Si4735 I2C órajel (a Config_t-n kívül)
+
+//------------------- Rádió szolgáltatás (core1)
+#include "RadioService.h"
+RadioService radioService(si4735, band, config, i2cClockStore);
+
 //------------------- Runtime variables
 #include "RuntimeVars.h"
 
@@ -48,6 +57,51 @@ Band band(si4735, config);
 #include "EventManager.h"
 EventManager eventManager;
 
+//------------------- Task ütemező
+#include "TaskScheduler.h"
+TaskScheduler scheduler;
+
+// Taskok periódusideje/határideje
+#define TASK_ENCODER_PERIOD_MSEC 2          // Rotary encoder olvasása (a frekvencia hangolás késleltetését ez határozza meg)
+#define TASK_ENCODER_DEADLINE_MSEC 5        //
+#define TASK_TOUCH_PERIOD_MSEC 30           // Touch olvasása
+#define TASK_TOUCH_DEADLINE_MSEC 50         //
+#define TASK_DISPLAY_PERIOD_MSEC 10         // Frekvencia kijelzés frissítése (csak változáskor rajzol)
+#define TASK_SMETER_PERIOD_MSEC 250         // S-Meter, mono/sztereo
+#define TASK_RDS_PERIOD_MSEC 500            // RDS
+#define ENCODER_HELD_REPORT_DELAY_MSEC 1000 // Nyomva tartott encoder gomb esetén ennyi ideig nem olvassuk az encodert
+
+int8_t encoderTaskId = TASK_INVALID_ID;
+
+//------------------- Alacsony fogyasztású várakozás
+#include "IdleManager.h"
+
+//------------------- Zajzár
+#include "Squelch.h"
+Squelch squelch(radioService, config);
+
+//------------------- Hardver watchdog
+#include "LoopWatchdog.h"
+LoopWatchdog loopWatchdog;
+#define WATCHDOG_BUDGET_MSEC 2000 // A loop() és a core1 életjele között legfeljebb ennyi idő telhet el (max. 8000)
+
+//------------------- Futásidő mérés és soros parancsok
+#include "LoopProfiler.h"
+#include "SerialCommands.h"
+SerialCommands serialCommands;
+#define TASK_SERIAL_CMD_PERIOD_MSEC 50 // Soros parancsok feldolgozása
+
+//------------------- Band váltás/hangolás késleltetés mérés
+#include "Benchmark.h"
+Benchmark benchmark(radioService, band, config, []() { pDisplay->drawScreen(); }, []() { pDisplay->drawFrequency(); });
+#define TASK_BENCH_PERIOD_MSEC 1 // A mérés lépései (csak mérés közben fut)
+int8_t benchTaskId = TASK_INVALID_ID;
+
+//------------------- Memória csatornák (LittleFS)
+#include "MemoryStore.h"
+MemoryStore memoryStore;
+#define TASK_MEMORY_PERIOD_MSEC 1000 // A kötegelt csatorna mentések kiírásának ellenőrzése
+
 //------------------- Memória információk megjelenítése
 #include "PicoMemoryInfo.h"
 #ifdef __DEBUG
@@ -91,8 +145,9 @@ void allEventLogger(const EventManager::EventData &event) {
  * Arduino setup
  */
 void setup() {
-#ifdef __DEBUG
+    // A soros port DEBUG nélkül is kell a diagnosztikai parancsokhoz
     Serial.begin(115200);
+#ifdef __DEBUG
     pinMode(LED_BUILTIN, OUTPUT);
 #endif
 
@@ -112,12 +167,6 @@ void setup() {
     rotaryTicker.attach_ms(ROTARY_ENCODER_TICKER_INTERVAL_MSEC, []() {
         rotaryEncoder.service();
     });
-    // Pico Ticker beállítása az EEPROM adatok mentésének ellenőrzésére
-    eepromSaveChecker.attach(EEPROM_SAVE_CHECK_TICKER_INTERVAL_SECONDS, []() {
-        // Lokkolunk, hogy ne tudjuk piszkálni a konfigot a mentés közben
-        CoreMutex mtx(&saveEepromMutex);
-        config.checkSave();
-    });
 
     // TFT inicializálása
     tft.init();
@@ -134,14 +183,21 @@ void setup() {
         delay(1500);
         if (digitalRead(PIN_ENCODER_SW) == LOW) { // Ha még mindig nyomják
             config.loadDefaults();
+            bandStore.invalidate(); // A band-ek az alapértékeikkel indulnak, a következő mentés mindet kiírja
+            i2cClockStore.set(I2C_CLOCK_UNCALIBRATED);
             Beeper::tick();
             DEBUG("Default settings resored!\n");
         }
     } else {
-        // konfig betöltése
+        // konfig és a band állapotok betöltése
         config.load();
+        bandStore.load();
+        i2cClockStore.load();
     }
 
+    // Memória csatornák (a napló egyszeri végigolvasása, az index felépítése)
+    memoryStore.begin();
+
     // Kell kalibrálni a TFT Touch-t?
     if (isZeroArray(config.data.tftCalibrateData)) {
         Beeper::error();
@@ -178,15 +234,32 @@ void setup() {
 
     // Band init
     band.BandInit();
+
+    // Az I2C órajel kalibrálása (csak az első induláskor, vagy ha az 'i2c recal' paranccsal kértük)
+    if (i2cClockStore.get() == I2C_CLOCK_UNCALIBRATED) {
+        tft.println(F("I2C clock calibration..."));
+        band.BandSet(); // A kalibráláshoz a chipnek futnia kell
+        i2cClockStore.set(I2cClockTuner::calibrate(si4735, band, band.getBandDesc(config.data.bandIdx).bandType == FM_BAND_TYPE));
+        i2cClockStore.checkSave();
+    }
+    radioService.setI2cClock(i2cClockStore.get()); // Innentől minden forgalom a kalibrált órajelen megy
     band.BandSet();
 
     // Si4735 init
-    si4735.setVolume(config.data.currentVOL);  // Hangerő
+    band.getPropertyShadow().setVolume(config.data.currentVOL); // Hangerő
     si4735.setAudioMuteMcuPin(PIN_AUDIO_MUTE); // Audio Mute pin
 
+#ifdef PIN_SI4735_INT
+    // RDS és RSQ események a GPO2/INT lábról (még a core0-n állítjuk be)
+    radioService.enableInterrupt(PIN_SI4735_INT);
+#endif
+
+    // Innentől az SI4735-öt kizárólag a core1 (RadioService) kezeli
+    radioService.start();
+
     // Képernyő példányosítása az aktuális mód alapján
     if (band.currentMode == FM) {
-        pDisplay = new FmDisplay(tft, si4735, band, config, 0, 0);
+        pDisplay = new FmDisplay(tft, radioService, band, config, 0, 0);
     } else {
         // pDisplay = new AmDisplay(tft, si4735, band);
     }
@@ -199,50 +272,286 @@ void setup() {
     debugMemoryInfo();
     memoryInfoTicker.attach(MEMORY_INFO_TICKER_INTERVAL_SECONDS, []() {
         debugMemoryInfo();
+        scheduler.debugTaskStats();
     });
 #endif
 
     eventManager.subscribe(EventManager::ALL_EVENTS, allEventLogger); // Minden eseményt figyel
+
+    // Taskok és soros parancsok regisztrálása
+    registerTasks();
+    registerSerialCommands();
+
+    // Watchdog élesítése (a setup() blokkoló részei - pl.: hiányzó Si4735, touch kalibráció - ezelőtt futnak le)
+    loopWatchdog.begin(WATCHDOG_BUDGET_MSEC);
 }
 
 /**
- * Arduino loop
+ * Zajzár kezelése
  */
-void loop() {
+void manageSquelch() {
+    PROFILE_STAGE(STAGE_SQUELCH);
 
-    // Lokkolunk, hogy ne tudjuk menteni az EEPROM-ot a változtatások közben
-    CoreMutex mtx(&saveEepromMutex);
-
-    // ======================= Manage Squelch =========================
     // squelchIndicator(pCfg->vars.currentSquelch);
-    if (!muteStat) {
-        si4735.getCurrentReceivedSignalQuality();
-        uint8_t rssi = si4735.getCurrentRSSI();
-        uint8_t snr = si4735.getCurrentSNR();
-
-        uint8_t signalQuality = config.data.squelchUsesRSSI ? rssi : snr;
-        if (signalQuality >= config.data.currentSquelch) {
-            if (SCANpause == true) {
-                si4735.setAudioMute(AUDIO_MUTE_OFF);
-                squelchDecay = millis();
-            }
-        } else {
-            if (millis() > (squelchDecay + SQUELCH_DECAY_TIME)) {
-                si4735.setAudioMute(AUDIO_MUTE_ON);
-            }
-        }
-    }
-    // ================================================================
+    squelch.process();
+}
+
+/**
+ * Rotary Encoder olvasása és továbbítása az aktuális képernyőnek
+ */
+void handleEncoder() {
+    PROFILE_STAGE(STAGE_ENCODER);
 
-    // Rotary Encoder olvasása
     RotaryEncoder::EncoderState encoderState = rotaryEncoder.read();
     if (encoderState.buttonState == RotaryEncoder::ButtonState::Held) {
         // TODO: Kikapcsolás figyelését még implementálni
         DEBUG("Ki kellene kapcsolni...\n");
-        delay(1000);
+        scheduler.postpone(encoderTaskId, ENCODER_HELD_REPORT_DELAY_MSEC);
         return;
     }
 
-    // Aktuális Display loopja
-    pDisplay->handleLoop(encoderState);
+    pDisplay->processRotaryEncoder(encoderState);
+}
+
+/**
+ * Taskok regisztrálása az ütemezőbe
+ * A prioritás dönt a lejárt taskok között, azonos prioritásnál a korábbi határidejű fut előbb
+ */
+void registerTasks() {
+
+    encoderTaskId = scheduler.addTask("encoder", TASK_ENCODER_PERIOD_MSEC, TASK_ENCODER_DEADLINE_MSEC, TaskScheduler::PRIO_REALTIME, handleEncoder);
+
+    scheduler.addTask("touch", TASK_TOUCH_PERIOD_MSEC, TASK_TOUCH_DEADLINE_MSEC, TaskScheduler::PRIO_HIGH, []() {
+        PROFILE_STAGE(STAGE_TOUCH);
+        pDisplay->processTouch();
+    });
+
+    scheduler.addTask("display", TASK_DISPLAY_PERIOD_MSEC, 0, TaskScheduler::PRIO_HIGH, []() {
+        PROFILE_STAGE(STAGE_DISPLAY);
+        pDisplay->processLoop();
+    });
+
+    scheduler.addTask("squelch", SQUELCH_SAMPLE_PERIOD_MSEC, 0, TaskScheduler::PRIO_NORMAL, manageSquelch);
+
+    scheduler.addTask("smeter", TASK_SMETER_PERIOD_MSEC, 0, TaskScheduler::PRIO_NORMAL, []() {
+        PROFILE_STAGE(STAGE_SMETER);
+        pDisplay->refreshSignalValues();
+    });
+
+    scheduler.addTask("rds", TASK_RDS_PERIOD_MSEC, 0, TaskScheduler::PRIO_LOW, []() {
+        PROFILE_STAGE(STAGE_RDS);
+        pDisplay->refreshRdsValues();
+    });
+
+    scheduler.addTask("serial", TASK_SERIAL_CMD_PERIOD_MSEC, 0, TaskScheduler::PRIO_LOW, []() {
+        serialCommands.poll();
+    });
+
+    // Band váltás/hangolás mérés (a "bench" parancs engedélyezi)
+    benchTaskId = scheduler.addTask("bench", TASK_BENCH_PERIOD_MSEC, 0, TaskScheduler::PRIO_LOW, []() {
+        benchmark.step();
+        if (!benchmark.isRunning()) {
+            scheduler.setEnabled(benchTaskId, false);
+        }
+    });
+    scheduler.setEnabled(benchTaskId, false);
+
+    // A memória csatornák kötegelt kiírása (az utolsó módosítás után kis késleltetéssel)
+    scheduler.addTask("memory", TASK_MEMORY_PERIOD_MSEC, 0, TaskScheduler::PRIO_LOW, []() {
+        PROFILE_STAGE(STAGE_MEMORY);
+        memoryStore.service();
+    });
+
+    // Az EEPROM mentés ellenőrzése (első futás csak egy periódus múlva)
+    // A mentés a konfig pillanatképén dolgozik, ezért nem kell a UI-t lezárni alatta
+    int8_t eepromTaskId = scheduler.addTask("eeprom", EEPROM_SAVE_CHECK_INTERVAL_MSEC, 0, TaskScheduler::PRIO_LOW, []() {
+        PROFILE_STAGE(STAGE_EEPROM);
+        config.checkSave();
+        bandStore.checkSave(); // Csak a megváltozott band-ek
+        i2cClockStore.checkSave(); // A core1 a patch hibák után érvénytelenítheti
+    });
+    scheduler.postpone(eepromTaskId, EEPROM_SAVE_CHECK_INTERVAL_MSEC);
+}
+
+/**
+ * Soros diagnosztikai parancsok regisztrálása
+ */
+void registerSerialCommands() {
+
+    serialCommands.addCommand("prof", "Futasido statisztikak [hist|reset]", [](const char *args) {
+        if (strcmp(args, "reset") == 0) {
+            LoopProfiler::reset();
+            Serial.printf("Profiler statisztikak torolve\n");
+        } else {
+            LoopProfiler::dump(strcmp(args, "hist") == 0);
+        }
+    });
+
+    serialCommands.addCommand("tasks", "Utemezo task statisztikak", [](const char *) {
+        scheduler.debugTaskStats();
+    });
+
+    serialCommands.addCommand("idle", "Alvas statisztika [on|off|reset]", [](const char *args) {
+        if (strcmp(args, "on") == 0 or strcmp(args, "off") == 0) {
+            IdleManager::setEnabled(strcmp(args, "on") == 0);
+        }
+        if (args[0] != '\0') {
+            IdleManager::resetStats();
+        }
+        IdleManager::dump();
+    });
+
+    serialCommands.addCommand("rsq", "Jelminoseg cache statisztika", [](const char *) {
+        const SignalQualityCache &cache = radioService.getSignalCache();
+        Serial.printf("RSQ cache: hit %lu, miss (I2C) %lu\n", cache.getHits(), cache.getMisses());
+        Serial.printf("Squelch: %s, level %d, samples %lu, transitions %lu\n",
+                      squelch.getState() == Squelch::OPEN ? "open" : (squelch.getState() == Squelch::CLOSED ? "closed" : "-"),
+                      squelch.getLevel(), squelch.getSamples(), squelch.getTransitions());
+    });
+    serialCommands.addCommand("rds", "RDS dekoder allapot", [](const char *) {
+        RadioSnapshot_t snapshot;
+        radioService.getSnapshot(snapshot);
+        const RdsStationState_t &rds = snapshot.rds;
+        Serial.printf("RDS: %s, PI %04X, PTY %u, TP %u, TA %u, MS %u\n", snapshot.rdsAvailable ? "yes" : "no", rds.pi, rds.pty, rds.tp, rds.ta, rds.music);
+        Serial.printf("PS '%s', PTYN '%s', CT %s %02u:%02u\n", rds.ps, rds.ptyn, rds.ctValid ? "valid" : "-", rds.ctHour, rds.ctMinute);
+        Serial.printf("RT '%s'\n", rds.rt);
+        Serial.printf("EON PI %04X '%s'\n", rds.eonPi, rds.eonPs);
+        Serial.printf("Groups: %u, bad B block: %u\n", rds.groups, rds.badGroups);
+    });
+    serialCommands.addCommand("band", "Band valtas statisztika [index: valtas]", [](const char *args) {
+        if (*args) {
+            radioService.postCommand(RadioService::SET_BAND, atoi(args));
+            return;
+        }
+        band.debugSwitchStats();
+    });
+    serialCommands.addCommand("props", "Property arnyek statisztika [reset]", [](const char *args) {
+        if (strcmp(args, "reset") == 0) {
+            band.getPropertyShadow().resetStats();
+        }
+        band.getPropertyShadow().debugStats();
+    });
+    serialCommands.addCommand("bench", "Band valtas/hangolas meres, CSV [stop|csv]", [](const char *args) {
+        if (strcmp(args, "stop") == 0) {
+            benchmark.stop();
+        } else if (strcmp(args, "csv") == 0) {
+            benchmark.dumpCsv();
+        } else if (benchmark.start()) {
+            scheduler.setEnabled(benchTaskId, true);
+        } else {
+            Serial.printf("A meres most nem indithato\n");
+        }
+    });
+    serialCommands.addCommand("scope", "Band scope sweep statisztika [start|stop]", [](const char *args) {
+        if (strcmp(args, "start") == 0) {
+            radioService.postCommand(RadioService::SCOPE_START);
+        } else if (strcmp(args, "stop") == 0) {
+            radioService.postCommand(RadioService::SCOPE_STOP);
+        } else {
+            radioService.getBandScope().debugStats();
+        }
+    });
+    serialCommands.addCommand("scan", "Allomas kereses, talalatok [start|stop]", [](const char *args) {
+        if (strcmp(args, "start") == 0) {
+            radioService.postCommand(RadioService::SCAN_START);
+        } else if (strcmp(args, "stop") == 0) {
+            radioService.postCommand(RadioService::SCAN_STOP);
+        } else {
+            radioService.getStationScanner().dump();
+        }
+    });
+    serialCommands.addCommand("tune", "Kozvetlen hangolas: <kHz> vagy <MHz.tizedes>, ha kell, band valtassal", [](const char *args) {
+        uint32_t kHz = parseFrequencyKHz(args);
+        int8_t bandIdx = band.findBandByKHz(kHz);
+        if (bandIdx < 0) {
+            Serial.printf("Hibas frekvencia: '%s'\n", args);
+            return;
+        }
+        Serial.printf("%lu kHz -> %s\n", kHz, band.getBandDesc(bandIdx).bandName);
+        radioService.postCommand(RadioService::TUNE_KHZ, kHz);
+    });
+    serialCommands.addCommand("mem", "Memoria csatornak [save <n> [nev]|recall <n>|del <n>|flush]", [](const char *args) {
+        char cmd[8] = {};
+        char name[MEMORY_NAME_LENGTH + 1] = {};
+        unsigned int channel = 0;
+        int n = sscanf(args, "%7s %u %8s", cmd, &channel, name);
+        if (n >= 2 and !memoryStore.isMounted()) {
+            Serial.printf("Nincs fajlrendszer (a flash-ben nincs LittleFS particio)\n");
+        } else if (n >= 2 and strcmp(cmd, "save") == 0) {
+            // Az aktuális hangolás mentése (a band állapotot a core1 váltja: a pillanatképből, egy egységként olvassuk)
+            RadioSnapshot_t snapshot;
+            radioService.getSnapshot(snapshot);
+            MemoryChannel_t record = {};
+            record.channel = channel;
+            record.frequency = snapshot.frequency;
+            record.bfo = snapshot.bfo;
+            record.bandIdx = snapshot.bandIdx;
+            record.mode = snapshot.mode;
+            record.bandwidth = snapshot.bandwidth;
+            strncpy(record.name, name, MEMORY_NAME_LENGTH);
+            Serial.printf("%s\n", memoryStore.save(record) ? "OK" : "Hibas csatorna");
+        } else if (n == 2 and strcmp(cmd, "recall") == 0) {
+            MemoryChannel_t record;
+            if (memoryStore.recall(channel, record)) {
+                radioService.recallMemory(record);
+            } else {
+                Serial.printf("Ures csatorna\n");
+            }
+        } else if (n == 2 and strcmp(cmd, "del") == 0) {
+            Serial.printf("%s\n", memoryStore.erase(channel) ? "OK" : "Ures csatorna");
+        } else if (n == 1 and strcmp(cmd, "flush") == 0) {
+            memoryStore.flush();
+        } else {
+            memoryStore.dump();
+        }
+    });
+    serialCommands.addCommand("i2c", "Si4735 I2C orajel [recal: ujrakalibralas a kovetkezo indulaskor]", [](const char *args) {
+        uint32_t currentHz = radioService.getI2cClock(); // Amin a chip most fut (ismétlődő patch hibák után a biztonságos)
+        if (strcmp(args, "recal") == 0) {
+            // A chip a core1-é: az órajelet csak a setup()-ban, a RadioService indítása előtt kalibrálhatjuk
+            i2cClockStore.set(I2C_CLOCK_UNCALIBRATED);
+            i2cClockStore.checkSave();
+            Serial.printf("Ujrakalibralas a kovetkezo indulaskor\n");
+        }
+        I2cClockTuner::dump(currentHz);
+    });
+    serialCommands.addCommand("wdt", "Watchdog: az elozo ujraindulas oka", [](const char *) {
+        loopWatchdog.dump();
+    });
+}
+
+/**
+ * Arduino loop
+ */
+void loop() {
+
+    loopWatchdog.feed();
+
+    // A következő esedékes task futtatása (csak a ténylegesen lefutott taskokat mérjük)
+    uint32_t start = LoopProfiler::now();
+    if (scheduler.runNext()) {
+        LoopProfiler::record(STAGE_LOOP, LoopProfiler::now() - start);
+    } else {
+        // Nincs esedékes task: alszunk a következőig (vagy amíg egy megszakítás fel nem ébreszt)
+        IdleManager::sleepCore0(scheduler.getMsecToNextRelease());
+    }
+}
+
+/**
+ * Arduino setup a core1-en
+ */
+void setup1() {
+    // A RadioService a core0 setup()-jának végén indul el, addig a loop1() üresen fut
+}
+
+/**
+ * Arduino loop a core1-en
+ * Az SI4735 I2C forgalma kizárólag itt zajlik
+ */
+void loop1() {
+    loopWatchdog.core1Alive();
+    radioService.loop();
+
+    // Ha nincs teendő, alszunk a következő pollingig vagy a core0 ébresztéséig
+    IdleManager::sleepCore1(radioService.getMsecToNextWork());
 }
@@ -0,0 +1,119 @@
+/**
+ * SSB patch tömörítő (host eszköz)
+ *
+ * A patch_full.h tartalmát LZSS-sel tömöríti, és patch_lz.h néven kiírja (ssb_patch_lz[] + a kitömörített méret).
+ * Ellenőrzésként a firmware LzssDecoder-ével visszacsomagolja és összehasonlítja.
+ * Ha a patch_lz.h a sketch mellett van, a Band.cpp azt használja a patch_full.h helyett.
+ *
+ *   cmake -S sim -B build -DSI4735_LIBRARY_DIR=<PU2CLR SI4735 könyvtár>/src
+ *   cmake --build build --target sketch_patch_lz
+ *
+ * SI4735_LIBRARY_DIR nélkül a mock patch-et tömöríti (a szimulációs build ezt használja).
+ */
+#include <chrono>
+#include <stdint.h>
+#include <stdio.h>
+#include <vector>
+
+#ifndef PROGMEM
+#define PROGMEM
+#endif
+#include <patch_full.h>
+
+#include "LzssDecoder.h"
+#include <CRC.h>
+
+/**
+ * Tömörítés: mohó keresés a legutóbbi LZSS_WINDOW_SIZE bájtban
+ */
+static std::vector<uint8_t> compress(const uint8_t *data, uint32_t size) {
+
+    std::vector<uint8_t> out;
+    uint32_t pos = 0;
+
+    while (pos < size) {
+        size_t flagIdx = out.size();
+        out.push_back(0);
+
+        for (uint8_t item = 0; item < 8 and pos < size; item++) {
+            uint32_t bestLen = 0;
+            uint32_t bestOffset = 0;
+            uint32_t maxOffset = pos < LZSS_WINDOW_SIZE ? pos : LZSS_WINDOW_SIZE;
+
+            for (uint32_t offset = 1; offset <= maxOffset; offset++) {
+                uint32_t len = 0;
+                while (len < LZSS_MAX_MATCH and pos + len < size and data[pos + len] == data[pos + len - offset]) {
+                    len++;
+                }
+                if (len > bestLen) {
+                    bestLen = len;
+                    bestOffset = offset;
+                }
+            }
+
+            if (bestLen >= LZSS_MIN_MATCH) {
+                out.push_back(bestOffset - 1);
+                out.push_back(bestLen - LZSS_MIN_MATCH);
+                pos += bestLen;
+            } else {
+                out[flagIdx] |= 1 << item;
+                out.push_back(data[pos++]);
+            }
+        }
+    }
+
+    return out;
+}
+
+int main(int argc, char **argv) {
+
+    if (argc < 2) {
+        fprintf(stderr, "usage: %s <patch_lz.h>\n", argv[0]);
+        return 1;
+    }
+
+    const uint8_t *raw = ssb_patch_content;
+    const uint32_t rawSize = sizeof(ssb_patch_content);
+    std::vector<uint8_t> packed = compress(raw, rawSize);
+
+    // Ellenőrzés a firmware kitömörítőjével, a letöltéssel azonos darabokban
+    LzssDecoder decoder;
+    uint8_t chunk[64];
+    uint32_t checked = 0;
+    auto start = std::chrono::steady_clock::now();
+    decoder.begin(packed.data(), packed.size());
+    while (uint16_t len = decoder.read(chunk, sizeof(chunk))) {
+        for (uint16_t i = 0; i < len; i++) {
+            if (checked >= rawSize or chunk[i] != raw[checked]) {
+                fprintf(stderr, "patch_compress: mismatch at %u\n", checked);
+                return 1;
+            }
+            checked++;
+        }
+    }
+    auto usec = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+    if (checked != rawSize) {
+        fprintf(stderr, "patch_compress: decoded %u of %u bytes\n", checked, rawSize);
+        return 1;
+    }
+
+    FILE *f = fopen(argv[1], "w");
+    if (!f) {
+        perror(argv[1]);
+        return 1;
+    }
+    fprintf(f, "// A patch_full.h LZSS tömörített változata, a sim/PatchCompress.cpp generálta - ne szerkeszd!\n");
+    fprintf(f, "#ifndef __PATCH_LZ_H\n#define __PATCH_LZ_H\n\n#include <stdint.h>\n\n");
+    fprintf(f, "#define SSB_PATCH_LZ_RAW_SIZE %u // A kitömörített patch mérete\n", rawSize);
+    fprintf(f, "#define SSB_PATCH_LZ_RAW_CRC16 0x%04X // A kitömörített patch CRC-16-ja (calcCRC16())\n\n", calcCRC16(raw, rawSize));
+    fprintf(f, "const uint8_t ssb_patch_lz[] = {");
+    for (size_t i = 0; i < packed.size(); i++) {
+        fprintf(f, "%s0x%02X%s", i % 16 == 0 ? "\n    " : "", packed[i], i + 1 < packed.size() ? "," : "");
+    }
+    fprintf(f, "\n};\n\n#endif // __PATCH_LZ_H\n");
+    fclose(f);
+
+    printf("patch_compress: %u -> %zu bytes (%.1f%%), host decode %lld usec\n",
+           rawSize, packed.size(), packed.size() * 100.0 / rawSize, (long long)usec);
+    return 0;
+}
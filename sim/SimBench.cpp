@@ -0,0 +1,46 @@
+/**
+ * Band váltás és hangolás késleltetés mérés a host szimulációban
+ *
+ * Az időhű mock-okkal fut: az I2C/SPI forgalom a busz órajele szerint, a chip várakozásai (POWER_UP, hangolás)
+ * a PU2CLR könyvtár késleltetései szerint léptetik a virtuális órát, így a fázisonkénti idők a valós hardverhez
+ * közeliek (a CPU idő nincs benne). A firmware "bench" parancsát futtatja, a mérő szondát a mock időszámlálói adják.
+ *
+ * Kimenet (stdout, CSV): band-enként egy sor, lásd Benchmark::dumpCsv()
+ * Használat: sim_bench [--verbose]
+ *   --verbose a firmware soros (DEBUG) kimenetét is kiírja
+ */
+#include "SimRunner.h"
+
+#define SIM_BENCH_MAX_SEC 600 // A mérés max. (virtuális) ideje
+
+/**
+ * Mérő szonda: a mock összesített I2C buszideje és chip várakozása
+ */
+static void busTimingProbe(uint32_t &i2cUsec, uint32_t &settleUsec) {
+    i2cUsec = (uint32_t)busTiming.i2cMicros;
+    settleUsec = (uint32_t)busTiming.settleMicros;
+}
+
+int main(int argc, char *argv[]) {
+
+    bool verbose = argc > 1 and strcmp(argv[1], "--verbose") == 0;
+    Serial.muted = !verbose;
+
+    busTiming.enabled = true;
+    simBoot();
+    benchmark.setProbe(busTimingProbe);
+
+    simSerialCommand("bench");
+    simRunMsec(100);
+    for (uint32_t sec = 0; sec < SIM_BENCH_MAX_SEC and benchmark.isRunning(); sec++) {
+        simRunMsec(1000);
+    }
+
+    // A CSV-t a firmware is kiírta (némítva), itt a DEBUG kimenet nélkül még egyszer
+    Serial.muted = false;
+    if (!verbose) {
+        benchmark.dumpCsv();
+    }
+
+    return benchmark.getRowCount() == band.getBandCount() ? 0 : 1;
+}
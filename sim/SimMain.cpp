@@ -0,0 +1,72 @@
+/**
+ * Szimulált rádió futtatása egy rögzített forgatókönyvvel
+ *
+ * Kimenet (stdout, CSV): keretenként (SIM_FRAME_MSEC) a buszforgalom (I2C, SPI, EEPROM) és az aktuális frekvencia.
+ * Használat: sim_radio [futásidő sec] [--verbose]
+ *   --verbose a firmware soros (DEBUG) kimenetét is kiírja
+ */
+#include "SimRunner.h"
+
+#define SIM_FRAME_MSEC 100      // Egy CSV sor ennyi virtuális msec forgalmát összesíti
+#define SIM_DEFAULT_RUN_SEC 10  // Alapértelmezett futásidő
+
+/**
+ * A forgatókönyv: jel megjelenése, RDS, hangolás az encoderrel, soros parancs
+ * @param frameIdx a keret sorszáma
+ */
+static void scenario(uint32_t frameIdx) {
+    uint32_t ms = frameIdx * SIM_FRAME_MSEC;
+
+    if (ms == 1000) {
+        si4735.simSetSignal(45, 25, true, 5, 1);
+    } else if (ms == 2000) {
+        si4735.simSetRds("SIMRADIO", "Host simulation RDS radio text", 10, 12, 34);
+    } else if (ms == 4000) {
+        simTurnEncoder(10);
+    } else if (ms == 6000) {
+        simTurnEncoder(-4);
+    } else if (ms == 8000) {
+        si4735.simSetSignal(5, 0);
+        simSerialCommand("prof");
+    }
+}
+
+int main(int argc, char *argv[]) {
+
+    uint32_t runSec = SIM_DEFAULT_RUN_SEC;
+    Serial.muted = true;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--verbose") == 0) {
+            Serial.muted = false;
+        } else if (atoi(argv[i]) > 0) {
+            runSec = atoi(argv[i]);
+        }
+    }
+
+    busStatsReset();
+    simBoot();
+    printf("# boot: i2c %u tr / %u B, spi %u tr / %u B, eeprom %u commits / %u B\n",
+           busStats.i2cTransactions, busStats.i2cBytes, busStats.spiTransactions, busStats.spiBytes,
+           busStats.eepromCommits, busStats.eepromBytes);
+
+    printf("time_ms,i2c_tr,i2c_bytes,spi_tr,spi_bytes,eeprom_commits,eeprom_bytes,frequency\n");
+    for (uint32_t frame = 0; frame < runSec * 1000 / SIM_FRAME_MSEC; frame++) {
+        busStatsReset();
+        uint32_t startMs = millis();
+        scenario(frame);
+
+        // A forgatókönyv lépései maguk is futtathatják a szimulációt (pl.: encoder tekerés)
+        uint32_t elapsed = millis() - startMs;
+        if (elapsed < SIM_FRAME_MSEC) {
+            simRunMsec(SIM_FRAME_MSEC - elapsed);
+        }
+
+        RadioSnapshot_t snapshot;
+        radioService.getSnapshot(snapshot);
+        printf("%lu,%u,%u,%u,%u,%u,%u,%u\n", millis(),
+               busStats.i2cTransactions, busStats.i2cBytes, busStats.spiTransactions, busStats.spiBytes,
+               busStats.eepromCommits, busStats.eepromBytes, snapshot.frequency);
+    }
+
+    return 0;
+}
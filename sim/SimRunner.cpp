@@ -0,0 +1,92 @@
+#include "SimRunner.h"
+#include "pinout.h"
+
+// A sketch setup()/loop() függvényei
+void setup();
+void loop();
+void setup1();
+void loop1();
+
+/**
+ * A firmware indítása
+ */
+void simBoot() {
+    static bool booted = false;
+    if (booted) {
+        return;
+    }
+    booted = true;
+
+    // Felengedett encoder (a pinek felhúzása a RotaryEncoder konstruktorában már megtörtént)
+    simPinLevels[PIN_ENCODER_SW] = HIGH;
+
+#ifdef PIN_SI4735_INT
+    si4735.simSetInterruptPin(PIN_SI4735_INT);
+#endif
+
+    setup1();
+    setup();
+}
+
+/**
+ * A két core futtatása a megadott virtuális ideig
+ */
+void simRunMsec(uint32_t msec, std::function<void(uint32_t)> everyMsec) {
+
+    for (uint32_t i = 0; i < msec; i++) {
+        if (everyMsec) {
+            everyMsec(i);
+        }
+
+        // 1 msec-es hardver timer, RDS csoportok érkezése
+        rotaryTicker.simTick();
+        si4735.simTick();
+
+        // core0: az összes lejárt task (a loop() egyszerre egyet futtat)
+        for (uint8_t n = 0; n < SIM_LOOP_MAX_TASKS_PER_MSEC and scheduler.getMsecToNextRelease() == 0; n++) {
+            loop();
+        }
+
+        // core1
+        loop1();
+
+        simAdvanceMicros(1000);
+    }
+}
+
+/**
+ * A kvadratúra jelek egy teljes periódusa (A, B aktív szintje), a RotaryEncoder ENC_NORMAL dekódere szerint
+ * Egy kattanás egy teljes periódus, a pinek aktív szintje LOW
+ */
+static const uint8_t QUADRATURE[4][2] = {{0, 0}, {0, 1}, {1, 1}, {1, 0}};
+
+void simTurnEncoder(int16_t notches) {
+    uint16_t count = abs(notches);
+    int8_t dir = notches > 0 ? 1 : -1;
+    int8_t phase = 0;
+
+    for (uint16_t n = 0; n < count; n++) {
+        // Kattanásonként 4 fázis, fázisonként 2 msec (a ticker 1 msec-enként mintavételez)
+        for (uint8_t s = 0; s < 4; s++) {
+            phase = (phase + dir + 4) % 4;
+            simPinLevels[PIN_ENCODER_CLK] = QUADRATURE[phase][0] ? LOW : HIGH;
+            simPinLevels[PIN_ENCODER_DT] = QUADRATURE[phase][1] ? LOW : HIGH;
+            simRunMsec(2);
+        }
+    }
+}
+
+void simPressButton(uint32_t holdMsec) {
+    simPinLevels[PIN_ENCODER_SW] = LOW;
+    simRunMsec(holdMsec);
+    simPinLevels[PIN_ENCODER_SW] = HIGH;
+
+#ifdef PIN_SI4735_INT
+    si4735.simSetInterruptPin(PIN_SI4735_INT);
+#endif
+}
+
+void simSerialCommand(const char *line) {
+    Serial.simInput(line);
+    Serial.simInput("\n");
+}
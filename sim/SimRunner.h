@@ -0,0 +1,71 @@
+#ifndef __SIMRUNNER_H
+#define __SIMRUNNER_H
+
+#include <Arduino.h>
+#include <SI4735.h>
+#include <TFT_eSPI.h>
+#include <Ticker.h>
+
+#include "BandStore.h"
+#include "Benchmark.h"
+#include "Config.h"
+#include "I2cClockStore.h"
+#include "LoopWatchdog.h"
+#include "MemoryStore.h"
+#include "RadioService.h"
+#include "SerialCommands.h"
+#include "TaskScheduler.h"
+
+/**
+ * A firmware sketch globális objektumai (SimSketch.cpp)
+ */
+extern TFT_eSPI tft;
+extern SI4735 si4735;
+extern Config config;
+extern Band band;
+extern BandStore bandStore;
+extern I2cClockStore i2cClockStore;
+extern RadioService radioService;
+extern TaskScheduler scheduler;
+extern SerialCommands serialCommands;
+extern Ticker rotaryTicker;
+extern LoopWatchdog loopWatchdog;
+extern MemoryStore memoryStore;
+extern Benchmark benchmark;
+
+#define SIM_LOOP_MAX_TASKS_PER_MSEC 16 // Egy virtuális msec alatt legfeljebb ennyi core0 task futhat
+
+/**
+ * A firmware indítása (setup()) a szimulált hardveren
+ * Többször hívva csak az első hívás indít
+ */
+void simBoot();
+
+/**
+ * A két core futtatása a megadott virtuális ideig
+ *
+ * Minden virtuális msec-ben: rotary ticker, a lejárt core0 taskok (loop()), majd egy loop1().
+ * A core-ok egymás után futnak (nincs valódi párhuzamosság), ezért a futásidők nem, de a sorrendek és a buszforgalom reálisak.
+ * @param msec futtatási idő
+ * @param everyMsec opcionális callback minden virtuális msec elején (pl.: bemenet szkript)
+ */
+void simRunMsec(uint32_t msec, std::function<void(uint32_t)> everyMsec = nullptr);
+
+/**
+ * Rotary encoder tekerése (kvadratúra jelek generálása a tickerhez igazítva)
+ * @param notches kattanások száma, az előjel az irány
+ */
+void simTurnEncoder(int16_t notches);
+
+/**
+ * Rotary encoder gomb nyomása
+ * @param holdMsec ennyi ideig tartjuk nyomva
+ */
+void simPressButton(uint32_t holdMsec);
+
+/**
+ * Soros parancs beküldése (a következő "serial" task dolgozza fel)
+ */
+void simSerialCommand(const char *line);
+
+#endif // __SIMRUNNER_H
@@ -0,0 +1,17 @@
+/**
+ * A firmware sketch fordítása a host buildben
+ *
+ * Az Arduino IDE a .ino-ból automatikusan prototípusokat generál, itt ezt kézzel pótoljuk,
+ * majd a sketch-et változtatás nélkül beemeljük. Így a szimuláció pontosan a firmware setup()/loop()-ját futtatja.
+ */
+#include <Arduino.h>
+
+#include "EventManager.h"
+
+void allEventLogger(const EventManager::EventData &event);
+void manageSquelch();
+void handleEncoder();
+void registerTasks();
+void registerSerialCommands();
+
+#include "../si4732-a10-ili9488-pico-radio.ino"
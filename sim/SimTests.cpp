@@ -0,0 +1,1044 @@
+/**
+ * Regressziós tesztek a host szimulációhoz
+ *
+ * Egyszerű, függőség nélküli teszt keret: minden teszt egy függvény, a CHECK hibánál kiírja a feltételt és a sort.
+ * A firmware-t egyszer indítjuk (simBoot()), a tesztek a sorrendjükben egymás állapotára építhetnek.
+ */
+#include "SimRunner.h"
+
+#include "FmDisplay.h"
+#include "I2cClockTuner.h"
+#include "Squelch.h"
+#include <patch_full.h>
+#include "SeqLock.h"
+#include "SpscQueue.h"
+#include <hardware/watchdog.h>
+
+static uint16_t failures = 0;
+
+#define CHECK(cond)                                                             \
+    do {                                                                        \
+        if (!(cond)) {                                                          \
+            fprintf(stderr, "  FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond); \
+            failures++;                                                         \
+        }                                                                       \
+    } while (0)
+
+//--- Alap építőkövek
+
+static void testSchedulerPriorityAndDeadline() {
+    TaskScheduler sched;
+    char order[8] = {};
+    uint8_t idx = 0;
+
+    sched.addTask("low", 10, 0, TaskScheduler::PRIO_LOW, [&]() { order[idx++] = 'l'; });
+    sched.addTask("late", 10, 50, TaskScheduler::PRIO_NORMAL, [&]() { order[idx++] = 'b'; });
+    sched.addTask("early", 10, 20, TaskScheduler::PRIO_NORMAL, [&]() { order[idx++] = 'a'; });
+    sched.addTask("rt", 10, 0, TaskScheduler::PRIO_REALTIME, [&]() { order[idx++] = 'r'; });
+
+    while (sched.runNext()) {
+    }
+
+    // Prioritás szerint, azonos prioritásnál a korábbi határidő előbb
+    CHECK(strcmp(order, "rabl") == 0);
+    CHECK(sched.getMsecToNextRelease() == 10);
+}
+
+static void testSchedulerPostpone() {
+    TaskScheduler sched;
+    uint8_t runs = 0;
+
+    int8_t id = sched.addTask("t", 5, 0, TaskScheduler::PRIO_NORMAL, [&]() { runs++; });
+    sched.postpone(id, 100);
+    CHECK(!sched.runNext());
+    CHECK(sched.getMsecToNextRelease() == 100);
+
+    simAdvanceMicros(100 * 1000);
+    CHECK(sched.runNext());
+    CHECK(runs == 1);
+}
+
+static void testSpscQueue() {
+    SpscQueue<uint16_t, 4> queue;
+    uint16_t value;
+
+    CHECK(queue.isEmpty());
+    for (uint16_t i = 0; i < 3; i++) {
+        CHECK(queue.push(i));
+    }
+    CHECK(!queue.push(99)); // N-1 elem fér el
+
+    for (uint16_t round = 0; round < 10; round++) {
+        CHECK(queue.pop(value));
+        CHECK(queue.push(value));
+    }
+    CHECK(queue.pop(value) and value == 1);
+    CHECK(queue.pop(value) and value == 2);
+    CHECK(queue.pop(value) and value == 0);
+    CHECK(!queue.pop(value));
+}
+
+static void testSeqLock() {
+    struct Data_t {
+        uint32_t a, b;
+    };
+    SeqLock<Data_t> lock;
+    Data_t in = {1, 2}, out;
+
+    uint32_t v0 = lock.getVersion();
+    lock.write(in);
+    lock.read(out);
+    CHECK(out.a == 1 and out.b == 2);
+    CHECK(lock.getVersion() != v0);
+}
+
+//--- A firmware a szimulált hardveren
+
+static void testBoot() {
+    busStatsReset();
+    simBoot();
+
+    // Band beállítás + első RSQ lekérdezés az I2C-n, teljes képernyő az SPI-n
+    CHECK(busStats.i2cTransactions > 0);
+    CHECK(busStats.spiBytes > 480 * 320 * 3);
+    CHECK(radioService.isStarted());
+
+    simRunMsec(1000);
+    CHECK(scheduler.getTaskCount() >= 8);
+}
+
+static void testIdleDisplayHasNoFullRedraw() {
+    si4735.simSetSignal(30, 20, true);
+    simRunMsec(1000); // a változás kirajzolása
+
+    // Változatlan jel mellett csak az S-meter/RDS frissítések mennek ki, a frekvencia kijelző nem rajzol újra
+    busStatsReset();
+    simRunMsec(1000);
+    CHECK(busStats.spiBytes < 480 * 320 * 3 / 4);
+
+    // Az RSQ-t a core1 csak a fogyasztók (zajzár, S-Meter) igényére kérdezi, ha a cache-ben lévő adat túl régi, az RDS-t 100 msec-enként
+    CHECK(busStats.i2cTransactions > 0);
+    CHECK(busStats.eepromCommits == 0);
+}
+
+static void testSignalQualityCache() {
+    si4735.simSetSignal(40, 22, true, 7, -2);
+    simRunMsec(1000);
+
+    // A fogyasztók (zajzár, S-Meter) igényei egy cache-en osztoznak, a legszigorúbb az S-Meter
+    uint32_t misses = radioService.getSignalCache().getMisses();
+    simRunMsec(1000);
+    uint32_t rsqPerSec = radioService.getSignalCache().getMisses() - misses;
+    CHECK(rsqPerSec > 0 and rsqPerSec <= 1000 / FM_SIGNAL_MAX_AGE_MSEC + 1);
+
+    SignalQuality_t signal;
+    radioService.getSignalQuality(signal, FM_SIGNAL_MAX_AGE_MSEC);
+    CHECK(signal.rssi == 40 and signal.snr == 22 and signal.pilot);
+    CHECK(signal.multipath == 7 and signal.freqOffset == -2);
+    CHECK(millis() - signal.timestamp <= FM_SIGNAL_MAX_AGE_MSEC * 2);
+}
+
+static void testEncoderTunes() {
+    RadioSnapshot_t before, middle, after;
+    radioService.getSnapshot(before);
+
+    simTurnEncoder(6);
+    simRunMsec(200);
+    radioService.getSnapshot(middle);
+    CHECK(middle.frequency != before.frequency);
+    CHECK((middle.frequency - before.frequency) % config.data.ssIdxFM == 0);
+
+    // Visszafelé tekerve az ellenkező irányba hangol (a gyorsítás miatt nem feltétlenül ugyanannyit)
+    simTurnEncoder(-6);
+    simRunMsec(200);
+    radioService.getSnapshot(after);
+    CHECK((middle.frequency > before.frequency) == (after.frequency < middle.frequency));
+}
+
+static void testEncoderBurstCoalesced() {
+    RadioSnapshot_t before, after;
+    simRunMsec(50);
+    radioService.getSnapshot(before);
+    uint32_t tunes = si4735.simGetTunes();
+
+    // Egy hangolás ideje alatt beérkező, gyorsuló lépések (a core1 még nem vette ki őket a sorból)
+    int32_t steps = 0;
+    for (uint8_t i = 0; i < 10; i++) {
+        CHECK(radioService.postCommand(RadioService::TUNE_STEPS, 1 + i / 4));
+        steps += 1 + i / 4;
+    }
+    CHECK(radioService.postCommand(RadioService::TUNE_STEPS, -2));
+    steps -= 2;
+
+    // Egyetlen hangolás a végső frekvenciára
+    simRunMsec(1);
+    CHECK(si4735.simGetTunes() - tunes == 1);
+    simRunMsec(50);
+    radioService.getSnapshot(after);
+    CHECK(after.frequency == band.getStepFrequency(before.frequency, steps));
+    CHECK(after.frequency != before.frequency);
+}
+
+static void testRdsGroupDecoder() {
+    RdsDecoder decoder;
+    CHECK(decoder.takeChanges() == RDS_CHANGED_ALL);
+
+    auto push = [&](uint16_t b, const char *cd, uint8_t errors = 0) {
+        decoder.push({{0xC201, b, (uint16_t)((cd[0] << 8) | cd[1]), (uint16_t)((cd[2] << 8) | cd[3])}, errors});
+    };
+
+    // 0B (TA): a PS csak mind a 4 szegmens után kerül az állapotba
+    const char *ps = "RADIO 1 ";
+    auto pushPs = [&](uint8_t segment) {
+        char cd[] = {'.', '.', ps[segment * 2], ps[segment * 2 + 1]};
+        push(0x0810 | segment, cd);
+    };
+    for (uint8_t segment = 0; segment < 3; segment++) {
+        pushPs(segment);
+    }
+    CHECK(decoder.process() == 3);
+    CHECK(decoder.getState().ps[0] == '\0' and decoder.getState().pi == 0xC201 and decoder.getState().ta);
+    uint16_t changes = decoder.takeChanges();
+    CHECK((changes & RDS_CHANGED_PI) and (changes & RDS_CHANGED_FLAGS) and !(changes & RDS_CHANGED_PS));
+    push(0x0813, "..1 ");
+    decoder.process();
+    CHECK(strcmp(decoder.getState().ps, "RADIO 1") == 0);
+    CHECK(decoder.takeChanges() == RDS_CHANGED_PS);
+
+    // Ugyanaz a PS újra: nincs változás jelzés
+    for (uint8_t segment = 0; segment < 4; segment++) {
+        pushPs(segment);
+    }
+    decoder.process();
+    CHECK(decoder.takeChanges() == 0);
+
+    // Hibás B blokk: a csoport eldobva, hibás D blokk: a szegmens nem számít
+    push(0x0810, "..XX", 0x30);
+    push(0x0810, "..XX", 0x03);
+    push(0x0811, "..YY");
+    push(0x0812, "..YY");
+    push(0x0813, "..YY");
+    decoder.process();
+    CHECK(decoder.getState().badGroups == 1);
+    CHECK(strcmp(decoder.getState().ps, "RADIO 1") == 0 and decoder.takeChanges() == 0);
+
+    // 2B: 2 karakter szegmensenként, a 0x0D végjelig
+    push(0x2800, "..Hi");
+    push(0x2801, "..!\r");
+    decoder.process();
+    CHECK(strcmp(decoder.getState().rt, "Hi!") == 0 and decoder.takeChanges() == RDS_CHANGED_RT);
+
+    // 10A: program típus név, PTY = 24 (Jazz)
+    push(0xA300, "JAZZ");
+    push(0xA301, " FM ");
+    decoder.process();
+    CHECK(strcmp(decoder.getState().ptyn, "JAZZ FM") == 0 and decoder.getState().pty == 24);
+    CHECK(decoder.takeChanges() == (RDS_CHANGED_PTYN | RDS_CHANGED_PTY));
+
+    // 14A: más hálózat PI-je (D blokk) és állomásneve (0-3. változat, C blokk)
+    const char *eon[] = {"OT\xC2\x02", "HE\xC2\x02", "R \xC2\x02", "  \xC2\x02"};
+    for (uint8_t variant = 0; variant < 4; variant++) {
+        push(0xE300 | variant, eon[variant]);
+    }
+    decoder.process();
+    CHECK(decoder.getState().eonPi == 0xC202 and strcmp(decoder.getState().eonPs, "OTHER") == 0);
+    CHECK(decoder.takeChanges() == RDS_CHANGED_EON);
+
+    // 4A: 12:34 UTC, +2 óra (4 félóra) eltolás
+    decoder.push({{0xC201, 0x4300, 0x0000, (12 << 12) | (34 << 6) | 4}, 0});
+    decoder.process();
+    CHECK(decoder.getState().ctValid and decoder.getState().ctHour == 14 and decoder.getState().ctMinute == 34);
+    CHECK(decoder.takeChanges() == RDS_CHANGED_CT);
+
+    // Hangoláskor minden mező törlődik és változottnak számít
+    decoder.reset();
+    CHECK(decoder.getState().ps[0] == '\0' and decoder.takeChanges() == RDS_CHANGED_ALL);
+}
+
+static void testRdsDecoded() {
+    si4735.simSetSignal(45, 25, true);
+    si4735.simSetRds("SIMRADIO", "Hello from the host", 10, 12, 34);
+    simRunMsec(1000);
+
+    RadioSnapshot_t snapshot;
+    radioService.getSnapshot(snapshot);
+    CHECK(snapshot.rdsAvailable);
+    CHECK(strcmp(snapshot.rds.ps, "SIMRADIO") == 0);
+    CHECK(snapshot.rds.ctValid and snapshot.rds.ctHour == 12 and snapshot.rds.ctMinute == 34);
+    CHECK(snapshot.rds.pi == SIM_RDS_DEFAULT_PI and snapshot.rds.pty == 10);
+
+    // A teljes rádió szöveg (5 szegmens) a 2A csoportokból
+    simRunMsec(1500);
+    radioService.getSnapshot(snapshot);
+    CHECK(strcmp(snapshot.rds.rt, "Hello from the host") == 0);
+}
+
+static void testRdsInterruptDrainsFifo() {
+    CHECK(radioService.isInterruptEnabled());
+    CHECK(si4735.simIsGpo2Enabled());
+
+    // A megszakítás kiszolgálása után a FIFO-ban a küszöbnél kevesebb csoport maradhat, és nem veszhet el csoport
+    si4735.simSetRds("IRQRADIO", "Drained by interrupt", 5, 8, 15);
+    simRunMsec(2000);
+    CHECK(si4735.simGetRdsFifoUsed() < RADIO_RDS_IRQ_FIFO_COUNT);
+    CHECK(si4735.simGetRdsGroupsLost() == 0);
+
+    RadioSnapshot_t snapshot;
+    radioService.getSnapshot(snapshot);
+    CHECK(strcmp(snapshot.rds.ps, "IRQRADIO") == 0);
+}
+
+static void testRdsBlockErrorsDropped() {
+    // Minden 3. csoport B blokkja javíthatatlan: a csoportot eldobjuk, a mezők nem sérülnek
+    si4735.simSetRdsErrorEvery(3);
+    si4735.simSetRds("ERRRADIO", "Errors on block B", 3, 9, 41);
+    simRunMsec(4000);
+    si4735.simSetRdsErrorEvery(0);
+
+    RadioSnapshot_t snapshot;
+    radioService.getSnapshot(snapshot);
+    CHECK(strcmp(snapshot.rds.ps, "ERRRADIO") == 0);
+    CHECK(strcmp(snapshot.rds.rt, "Errors on block B") == 0);
+    CHECK(snapshot.rds.pty == 3);
+    CHECK(snapshot.rds.badGroups > 0 and snapshot.rds.groups > snapshot.rds.badGroups);
+}
+
+static void testSquelchMutes() {
+    config.data.squelchUsesRSSI = true;
+    config.data.currentSquelch = 20;
+
+    si4735.simSetSignal(5, 0);
+    simRunMsec(1000);
+    CHECK(si4735.simIsMuted());
+
+    si4735.simSetSignal(45, 25, true);
+    simRunMsec(1000);
+    CHECK(!si4735.simIsMuted());
+
+    // Stabil jelnél nincs több némítás írás
+    uint32_t writes = si4735.simGetMuteWrites();
+    simRunMsec(1000);
+    CHECK(si4735.simGetMuteWrites() == writes);
+
+    // A küszöb körül ingadozó jel a hiszterézis sávon belül nem kapcsolgat
+    for (uint8_t i = 0; i < 10; i++) {
+        si4735.simSetSignal(i % 2 ? 21 : 18, 10);
+        simRunMsec(300);
+    }
+    CHECK(!si4735.simIsMuted());
+    CHECK(si4735.simGetMuteWrites() == writes);
+
+    // Rövid jelesés (egy minta) nem zár, a tartós igen
+    si4735.simSetSignal(5, 0);
+    simRunMsec(SQUELCH_SAMPLE_PERIOD_MSEC);
+    CHECK(!si4735.simIsMuted());
+    simRunMsec(1000);
+    CHECK(si4735.simIsMuted());
+    CHECK(si4735.simGetMuteWrites() == writes + 1);
+
+    // Hangolás után az előző állomás szintje nem számít: az első új mintánál zár (nem a lecsengés után)
+    si4735.simSetSignal(45, 25, true);
+    simRunMsec(1000);
+    CHECK(!si4735.simIsMuted());
+    si4735.simSetSignal(5, 0);
+    radioService.postCommand(RadioService::FREQUENCY_UP);
+    simRunMsec(3 * SQUELCH_SAMPLE_PERIOD_MSEC);
+    CHECK(si4735.simIsMuted());
+    radioService.postCommand(RadioService::FREQUENCY_DOWN);
+
+    si4735.simSetSignal(45, 25, true);
+    config.data.currentSquelch = 0;
+    simRunMsec(200);
+    CHECK(!si4735.simIsMuted());
+}
+
+static void testSerialCommands() {
+    SerialCommands commands;
+    char received[16] = {};
+
+    commands.addCommand("echo", "teszt", [&](const char *args) { safeStrCpy(received, args); });
+    Serial.simInput("echo  abc\n");
+    commands.poll();
+    CHECK(strcmp(received, "abc") == 0);
+
+    // A tele tábla nem fogad több parancsot
+    while (commands.getCommandCount() < SERIAL_CMD_MAX_COMMANDS) {
+        CHECK(commands.addCommand("nop", "teszt", [](const char *) {}));
+    }
+    CHECK(!commands.addCommand("extra", "teszt", [](const char *) {}));
+
+    // A sketch minden parancsa befért (ha egy kimaradt volna, a tábla tele lenne)
+    CHECK(serialCommands.getCommandCount() < SERIAL_CMD_MAX_COMMANDS);
+}
+
+static const TaskScheduler::Task_t *findTask(const char *name) {
+    for (uint8_t i = 0; i < scheduler.getTaskCount(); i++) {
+        if (strcmp(scheduler.getTask(i)->name, name) == 0) {
+            return scheduler.getTask(i);
+        }
+    }
+    return nullptr;
+}
+
+static void testSsbPatchStaysResident() {
+    // 40M (LSB) -> 41M (AM) -> 40M: a patch csak egyszer töltődik le (a soros parancsokat 50 msec-enként dolgozzuk fel)
+    uint32_t downloads = si4735.simGetPatchDownloads();
+    simSerialCommand("band 12");
+    for (uint8_t i = 0; i < 100 and !radioService.isSSBLoading(); i++) {
+        simRunMsec(1);
+    }
+    CHECK(radioService.isSSBLoading());
+
+    // Betöltés közben a UI fut, a hangolás tiltva, a folyamatjelző halad
+    uint16_t freq = band.getBandState(12).currentFreq;
+    uint32_t displayRuns = findTask("display")->runs;
+    simTurnEncoder(3);
+    uint8_t lastProgress = 0;
+    bool progressed = false;
+    for (uint16_t i = 0; i < 1000 and radioService.isSSBLoading(); i++) {
+        simRunMsec(1);
+        uint8_t progress = radioService.getSSBLoadProgress();
+        if (progress != RADIO_SSB_LOAD_IDLE) {
+            progressed |= progress > lastProgress and lastProgress > 0;
+            lastProgress = progress;
+        }
+    }
+    CHECK(!radioService.isSSBLoading());
+    CHECK(progressed);
+    CHECK(findTask("display")->runs > displayRuns + 10);
+    CHECK(band.getBandState(12).currentFreq == freq);
+
+    CHECK(si4735.simGetPatchDownloads() == downloads + 1);
+    CHECK(band.getSwitchStats().lastLoadedPatch);
+
+    // A tömörített patch darabonként letöltve bájtra azonos a nyers patch-csel
+    CHECK(si4735.simGetPatchBytes() == sizeof(ssb_patch_content));
+    CHECK(si4735.simGetPatchChecksum() == simFnv1a(SIM_FNV_OFFSET, ssb_patch_content, sizeof(ssb_patch_content)));
+    uint32_t loadUsec = band.getSwitchStats().lastUsec;
+
+    simSerialCommand("band 13");
+    simRunMsec(100);
+    CHECK(band.currentMode == AM);
+    CHECK(band.isSSBLoaded());
+    CHECK(si4735.simGetPatchBytes() > 0);
+
+    simSerialCommand("band 12");
+    simRunMsec(100);
+    CHECK(si4735.simGetPatchDownloads() == downloads + 1);
+    CHECK(!band.getSwitchStats().lastLoadedPatch);
+    CHECK(band.getSwitchStats().lastUsec < loadUsec);
+
+    // Az FM törli a patch-et
+    simSerialCommand("band 0");
+    simRunMsec(100);
+    CHECK(!band.isSSBLoaded());
+    CHECK(si4735.simGetPatchBytes() == 0);
+    CHECK(band.currentMode == FM);
+}
+
+static void testBandSwitchWritesOnlyChangedProperties() {
+    // FM -> 49M (AM): a POWER_UP után a teljes AM profilt ki kell írni
+    simSerialCommand("band 11");
+    simRunMsec(100);
+    CHECK(band.currentMode == AM);
+    CHECK(band.getSwitchStats().lastPropertyWrites > 0);
+    CHECK(si4735.getProperty(SI473X_PROP_AM_SEEK_RSSI_THRESHOLD) == 50);
+    CHECK(si4735.getProperty(SI473X_PROP_AM_CHANNEL_FILTER) == config.data.bwIdxAM);
+
+    // 49M -> 31M (AM): nincs POWER_UP, csak a band határai (seek) változnak
+    simSerialCommand("band 14");
+    simRunMsec(100);
+    CHECK(band.getSwitchStats().lastPropertyWrites == 2);
+    CHECK(si4735.getProperty(SI473X_PROP_AM_SEEK_BAND_TOP) == band.getBandDesc(14).maximumFreq);
+    CHECK(band.getSwitchStats().lastPropertySkips > 0);
+
+    simSerialCommand("band 0");
+    simRunMsec(100);
+    CHECK(band.currentMode == FM);
+    CHECK(si4735.getProperty(SI473X_PROP_FM_RDS_CONFIG) == 0xAA01);
+}
+
+static void testBandIndexDirectTune() {
+    // Átfedő band-eknél a legszűkebb nyer
+    CHECK(band.findBandByKHz(93900) == 0);  // FM
+    CHECK(band.findBandByKHz(150) == 1);    // LW (az SW is lefedi)
+    CHECK(band.findBandByKHz(300) == 3);    // 800M (az LW-n belül)
+    CHECK(band.findBandByKHz(475) == 4);    // 630M
+    CHECK(band.findBandByKHz(1000) == 2);   // MW
+    CHECK(band.findBandByKHz(7300) == 12);  // 40M (a 41M-mel átfed)
+    CHECK(band.findBandByKHz(7600) == 13);  // 41M
+    CHECK(band.findBandByKHz(9000) == 14);  // 31M (a 41M felső határa)
+    CHECK(band.findBandByKHz(15500) == 19); // 19M (és nem a teljes SW)
+    CHECK(band.findBandByKHz(50) == -1);
+    CHECK(band.findBandByKHz(30001) == -1);
+    CHECK(band.findBandByKHz(50000) == -1);
+    CHECK(band.findBandByKHz(108001) == -1);
+
+    CHECK(parseFrequencyKHz("93.9") == 93900);
+    CHECK(parseFrequencyKHz("7074") == 7074);
+    CHECK(parseFrequencyKHz("9.65") == 9650);
+    CHECK(parseFrequencyKHz("") == 0);
+    CHECK(parseFrequencyKHz("1x") == 0);
+
+    // Közvetlen hangolás band váltással, majd a band-en belül
+    uint16_t fmFreq = band.getBandState(0).currentFreq;
+    simSerialCommand("tune 9650");
+    simRunMsec(100);
+    CHECK(config.data.bandIdx == 14);
+    CHECK(band.currentMode == AM);
+    CHECK(si4735.getCurrentFrequency() == 9650);
+
+    simSerialCommand("tune 9.7");
+    simRunMsec(100);
+    CHECK(config.data.bandIdx == 14);
+    CHECK(band.getBandState(14).currentFreq == 9700);
+
+    // Band-en kívüli frekvencia: nincs hangolás
+    simSerialCommand("tune 50000");
+    simRunMsec(100);
+    CHECK(band.getBandState(14).currentFreq == 9700);
+
+    simSerialCommand("tune 94.5");
+    simRunMsec(100);
+    CHECK(config.data.bandIdx == 0);
+    CHECK(band.currentMode == FM);
+    CHECK(si4735.getCurrentFrequency() == 9450);
+
+    band.getBandState(0).currentFreq = fmFreq;
+    simSerialCommand("band 0");
+    simRunMsec(100);
+}
+
+static void testPropertyShadowSkipsRedundantIo() {
+    PropertyShadow &shadow = band.getPropertyShadow();
+    shadow.resetStats();
+
+    // A hangerő és az AGC már be van állítva: nincs I2C forgalom
+    busStatsReset();
+    CHECK(!shadow.setVolume(config.data.currentVOL));
+    CHECK(!shadow.setAutomaticGainControl(0, 0));
+    CHECK(shadow.getProperty(SI473X_PROP_FM_RDS_CONFIG) == 0xAA01);
+    CHECK(busStats.i2cTransactions == 0);
+    CHECK(shadow.getStats().writeHits == 2);
+    CHECK(shadow.getStats().readHits == 1);
+    CHECK(shadow.getStats().savedBytes > 0);
+
+    // Változás: kiírjuk, az ismeretlen property-t a chipből olvassuk
+    CHECK(shadow.setVolume(config.data.currentVOL - 1));
+    CHECK(si4735.getProperty(SI473X_PROP_RX_VOLUME) == config.data.currentVOL - 1);
+    CHECK(shadow.setVolume(config.data.currentVOL));
+    uint32_t transactions = busStats.i2cTransactions;
+    shadow.getProperty(0x1302); // FM_SOFT_MUTE_MAX_ATTENUATION (nem írtuk)
+    CHECK(busStats.i2cTransactions > transactions);
+    CHECK(shadow.getStats().readMisses == 1);
+    CHECK(shadow.getStats().writeMisses == 2);
+}
+
+static void testI2cClockCalibration() {
+    // Az első induláskor kalibrált: a mock 500kHz-ig hibátlan, de 400kHz felett nem üzemeltetjük
+    CHECK(i2cClockStore.get() == 400000);
+    CHECK(si4735.simGetI2CClock() == 400000);
+    CHECK(radioService.getI2cClock() == 400000);
+
+    // A visszaolvasás csak 100kHz-en jó: a mintákat a mock elfogadta (tartományon belüliek), a patch próba elmarad,
+    // és a teszt property visszaállt
+    uint16_t seekTop = si4735.getProperty(I2C_CLOCK_SCRATCH_PROP_FM);
+    si4735.simSetMaxI2CClock(I2C_CLOCK_SAFE_HZ, I2C_CLOCK_SAFE_HZ);
+    CHECK(I2cClockTuner::calibrate(si4735, band, band.currentMode == FM) == I2C_CLOCK_SAFE_HZ);
+    CHECK(si4735.simGetI2CClock() == I2C_CLOCK_SAFE_HZ);
+    CHECK(si4735.getProperty(I2C_CLOCK_SCRATCH_PROP_FM) == seekTop);
+
+    // A visszaolvasás végig jó, de a patch csak 300kHz-ig: egy lépést visszalép
+    si4735.simSetMaxI2CClock(1000000, 300000);
+    CHECK(I2cClockTuner::calibrate(si4735, band, band.currentMode == FM) == 300000);
+    CHECK(si4735.simGetI2CClock() == 300000);
+    CHECK(band.isSSBLoaded());
+
+    // Visszaállás (a band váltás helyreállítja a chip állapotát)
+    si4735.simSetMaxI2CClock(SIM_I2C_MAX_STABLE_HZ, SIM_I2C_MAX_STABLE_HZ);
+    si4735.setI2CFastModeCustom(i2cClockStore.get());
+    simSerialCommand("band 0");
+    simRunMsec(200);
+    CHECK(band.currentMode == FM);
+}
+
+static void testI2cClockFallback() {
+    // A patch letöltés 400kHz-en romlik el: az első hiba még nem, a második már a biztonságos órajelre vált
+    si4735.simSetMaxI2CClock(SIM_I2C_MAX_STABLE_HZ, 200000);
+    uint32_t errors = band.getSwitchStats().patchStatusErrors;
+    uint32_t downloads = si4735.simGetPatchDownloads();
+    simSerialCommand("band 5");
+    simRunMsec(1000);
+    CHECK(band.getSwitchStats().patchStatusErrors == errors + 1);
+    CHECK(radioService.getI2cClock() == 400000);
+
+    simSerialCommand("band 0");
+    simRunMsec(200);
+    simSerialCommand("band 5");
+    simRunMsec(1000);
+    CHECK(band.getSwitchStats().patchStatusErrors == errors + 2);
+    CHECK(radioService.getI2cClock() == I2C_CLOCK_SAFE_HZ);
+    CHECK(si4735.simGetI2CClock() == I2C_CLOCK_SAFE_HZ);
+    CHECK(i2cClockStore.get() == I2C_CLOCK_UNCALIBRATED); // A következő induláskor újrakalibrál
+    CHECK(i2cClockStore.checkSave()); // Az EEPROM task (core0) menti
+    I2cClockStore stored;
+    stored.load();
+    CHECK(stored.get() == I2C_CLOCK_UNCALIBRATED);
+
+    // A patch újratöltődött a biztonságos órajelen, most már hibátlanul
+    CHECK(si4735.simGetPatchDownloads() == downloads + 3);
+    CHECK(band.getSwitchStats().patchStatusErrors == errors + 2);
+    CHECK(band.isSSBLoaded());
+    CHECK(band.currentMode == LSB);
+    CHECK(!radioService.isSSBLoading());
+
+    // Visszaállás
+    si4735.simSetMaxI2CClock(SIM_I2C_MAX_STABLE_HZ, SIM_I2C_MAX_STABLE_HZ);
+    radioService.setI2cClock(400000);
+    i2cClockStore.set(400000);
+    i2cClockStore.checkSave();
+    simSerialCommand("band 0");
+    simRunMsec(200);
+    CHECK(band.currentMode == FM);
+}
+
+static void testBandScopeSweep() {
+    const BandScope &scope = radioService.getBandScope();
+    uint16_t frequency = si4735.getCurrentFrequency();
+    si4735.simAddStation(9400, 50, 20);
+    si4735.simAddStation(10400, 35, 12);
+
+    simSerialCommand("scope start");
+    simRunMsec(100);
+    CHECK(scope.isRunning());
+    CHECK(si4735.getVolume() == 0); // Sweep közben néma
+    uint16_t points = scope.getPointCount();
+    CHECK(points > 1 and points <= BAND_SCOPE_MAX_POINTS);
+    CHECK(scope.getFrequency(0) == band.getBandDesc(config.data.bandIdx).minimumFreq);
+
+    // Az első sweep kirajzolása (oszloponként, ahogy a minták jönnek)
+    BandScopeView view(tft, scope, 0, FM_SCOPE_Y, tft.width(), FM_SCOPE_H, true);
+    simRunMsec(5000, [&](uint32_t) { view.update(); });
+    CHECK(scope.getStats().sweeps >= 1);
+    CHECK(scope.getStats().stcTimeouts == 0);
+
+    // Az STC figyelése gyorsabb a könyvtár fix várakozásánál
+    CHECK(scope.getPointsPerSec() > 1000 / SI4735_TUNE_DELAY_MSEC);
+    uint16_t idx = (9400 - scope.getFrequency(0)) / (scope.getFrequency(1) - scope.getFrequency(0));
+    CHECK(scope.getFrequency(idx) == 9400);
+    CHECK(scope.getRssi(idx) == 50 and scope.getSnr(idx) == 20);
+    CHECK(scope.getRssi(idx + 1) < 50);
+
+    // Változatlan spektrum: a következő sweep-ekben nincs újrarajzolt oszlop
+    uint32_t drawn = view.getColumnsDrawn();
+    uint32_t skipped = view.getColumnsSkipped();
+    CHECK(drawn > 0);
+    simRunMsec(5000, [&](uint32_t) { view.update(); });
+    CHECK(view.getColumnsDrawn() == drawn);
+    CHECK(view.getColumnsSkipped() >= skipped + points);
+
+    // Egy állomás eltűnik: csak az az oszlop rajzolódik újra
+    si4735.simClearStations();
+    si4735.simAddStation(9400, 50, 20);
+    simRunMsec(5000, [&](uint32_t) { view.update(); });
+    CHECK(view.getColumnsDrawn() == drawn + 1);
+
+    // Leállítás: vissza az eredeti frekvenciára és hangerőre
+    simSerialCommand("scope stop");
+    simRunMsec(100);
+    CHECK(!scope.isRunning());
+    CHECK(si4735.getCurrentFrequency() == frequency);
+    CHECK(si4735.getVolume() == config.data.currentVOL);
+    si4735.simClearStations();
+}
+
+static void testStationScanSortedBySignal() {
+    const StationScanner &scanner = radioService.getStationScanner();
+    uint16_t frequency = si4735.getCurrentFrequency();
+    CHECK(sizeof(StationEntry_t) == 14);
+
+    si4735.simAddStation(9000, 30, 8);
+    si4735.simAddStation(9400, 50, 20, 0x2001, "PETOFI");
+    si4735.simAddStation(10000, 40, 15, 0x2002, "KOSSUTH");
+    si4735.simAddStation(10500, 3, 1); // A seek küszöb alatt
+
+    // Megszakítás: vissza az eredeti frekvenciára
+    simSerialCommand("scan start");
+    simRunMsec(500);
+    CHECK(scanner.isRunning());
+    CHECK(si4735.getVolume() == 0);
+    simSerialCommand("scan stop");
+    simRunMsec(100);
+    CHECK(!scanner.isRunning());
+    CHECK(si4735.getCurrentFrequency() == frequency);
+    CHECK(si4735.getVolume() == config.data.currentVOL);
+
+    // Teljes keresés
+    simSerialCommand("scan start");
+    uint32_t elapsed = 0;
+    simRunMsec(100);
+    while (scanner.isRunning() and elapsed < 30000) {
+        simRunMsec(100);
+        elapsed += 100;
+    }
+    CHECK(!scanner.isRunning());
+    CHECK(scanner.getCount() == 3);
+    CHECK(scanner.getEntry(0).frequency == 9400 and scanner.getEntry(0).pi == 0x2001);
+    CHECK(memcmp(scanner.getEntry(0).ps, "PETOFI", 6) == 0);
+    CHECK(scanner.getEntry(1).frequency == 10000 and scanner.getEntry(1).pi == 0x2002);
+    CHECK(scanner.getEntry(2).frequency == 9000 and scanner.getEntry(2).pi == 0); // Gyenge: nem vártunk RDS-re
+    CHECK(scanner.find(10000) == 1 and scanner.find(10500) == -1);
+
+    // A végén a legerősebb állomáson állunk, a pillanatkép is ezt mutatja
+    RadioSnapshot_t snapshot;
+    radioService.getSnapshot(snapshot);
+    CHECK(si4735.getCurrentFrequency() == 9400 and snapshot.frequency == 9400);
+    CHECK(si4735.getVolume() == config.data.currentVOL);
+
+    si4735.simClearStations();
+    radioService.postCommand(RadioService::SET_FREQUENCY, frequency);
+    simRunMsec(100);
+}
+
+static void testStationScanAfterSsbBand() {
+    const StationScanner &scanner = radioService.getStationScanner();
+    uint32_t downloads = si4735.simGetPatchDownloads();
+
+    // SSB-ben nincs keresés: elutasítja, nem fut
+    simSerialCommand("band 12");
+    simRunMsec(1000);
+    CHECK(band.currentMode == LSB and band.isSSBLoaded());
+    simSerialCommand("scan start");
+    simRunMsec(100);
+    CHECK(!scanner.isRunning());
+    CHECK(scanner.isRefused());
+
+    // 41M (AM) a betöltött patch-csel: a keresés előtt sima AM-be indul újra a chip
+    si4735.simAddStation(7300, 60, 25); // Az AM seek küszöbök (RSSI 50, SNR 20) felett
+    si4735.simAddStation(7500, 55, 22);
+    simSerialCommand("band 13");
+    simRunMsec(100);
+    CHECK(band.currentMode == AM and band.isSSBLoaded());
+    simSerialCommand("scan start");
+    simRunMsec(100);
+    CHECK(!scanner.isRefused());
+    CHECK(!band.isSSBLoaded());
+    CHECK(si4735.simGetMode() == AM_CURRENT_MODE);
+    uint32_t elapsed = 0;
+    while (scanner.isRunning() and elapsed < 30000) {
+        simRunMsec(100);
+        elapsed += 100;
+    }
+    CHECK(!scanner.isRunning());
+    CHECK(scanner.getCount() == 2);
+    CHECK(scanner.getEntry(0).frequency == 7300 and scanner.getEntry(1).frequency == 7500);
+    CHECK(si4735.getCurrentFrequency() == 7300);
+    CHECK(si4735.getVolume() == config.data.currentVOL);
+
+    // Vissza SSB-be: a patch újra letöltődik
+    simSerialCommand("band 12");
+    simRunMsec(1000);
+    CHECK(band.isSSBLoaded());
+    CHECK(si4735.simGetPatchDownloads() == downloads + 2);
+
+    si4735.simClearStations();
+    simSerialCommand("band 0");
+    simRunMsec(200);
+    CHECK(band.currentMode == FM);
+}
+
+static void testBandStoreWritesOnlyChangedBands() {
+    bandStore.checkSave(); // Az eddigi változások (első mentés: minden band)
+    busStatsReset();
+
+    // Változatlan band-ekre nincs írás és commit
+    CHECK(bandStore.checkSave() == 0);
+    CHECK(busStats.eepromCommits == 0);
+
+    // Egy band változott: csak az ő rekordja íródik, a Config_t nem
+    band.getBandState(7).currentFreq += 5;
+    band.getBandState(7).lastBFO = -250;
+    CHECK(bandStore.checkSave() == 1);
+    CHECK(busStats.eepromCommits == 1);
+    CHECK(busStats.eepromWrittenBytes == sizeof(BandStoreRecord_t));
+
+    // "Újraindulás": egy új Band az alapértékekkel indul, a betöltés visszaállítja az állapotot
+    Band restarted(si4735, config);
+    BandStore restartedStore(restarted);
+    CHECK(restarted.getBandState(7).currentFreq != band.getBandState(7).currentFreq);
+    restartedStore.load();
+    CHECK(restarted.getBandState(7).currentFreq == band.getBandState(7).currentFreq);
+    CHECK(restarted.getBandState(7).lastBFO == -250);
+    CHECK(restarted.getBandState(12).currentFreq == band.getBandState(12).currentFreq);
+
+    // Sérült rekord: csak az a band indul az alapértékkel
+    EEPROM.getDataPtr()[BAND_STORE_EEPROM_ADDRESS + sizeof(BandStoreHeader_t) + 7 * sizeof(BandStoreRecord_t)] ^= 0x55;
+    Band corrupted(si4735, config);
+    BandStore corruptedStore(corrupted);
+    corruptedStore.load();
+    CHECK(corrupted.getBandState(7).currentFreq == corrupted.getBandDesc(7).defaultFreq);
+    CHECK(corrupted.getBandState(12).currentFreq == band.getBandState(12).currentFreq);
+
+    band.getBandState(7).currentFreq -= 5;
+    band.getBandState(7).lastBFO = 0;
+    bandStore.checkSave();
+}
+
+static MemoryChannel_t makeMemoryChannel(uint16_t channel, uint8_t bandIdx, uint16_t frequency) {
+    MemoryChannel_t record = {};
+    record.channel = channel;
+    record.bandIdx = bandIdx;
+    record.frequency = frequency;
+    record.mode = AM;
+    snprintf(record.name, MEMORY_NAME_LENGTH, "CH%u", channel);
+    return record;
+}
+
+static void testMemoryChannelsBatchedLog() {
+    // Kötegelt írás: 40 csatorna = két teljes flash lap azonnal, a maradék a késleltetés után egy írással
+    busStatsReset();
+    for (uint16_t ch = 0; ch < 40; ch++) {
+        CHECK(memoryStore.save(makeMemoryChannel(ch * 10, 11, 5900 + ch * 5)));
+    }
+    CHECK(busStats.fsWrites == 2);
+    CHECK(busStats.fsPages == 2);
+    CHECK(memoryStore.getCount() == 40);
+
+    // A még ki nem írt csatorna is visszahívható
+    MemoryChannel_t record;
+    CHECK(memoryStore.recall(390, record));
+    CHECK(record.frequency == 5900 + 39 * 5);
+    CHECK(strncmp(record.name, "CH390", MEMORY_NAME_LENGTH) == 0);
+    CHECK(!memoryStore.recall(391, record));
+    CHECK(!memoryStore.save(makeMemoryChannel(MEMORY_MAX_CHANNELS, 11, 6000)));
+
+    simRunMsec(MEMORY_FLUSH_DELAY_MSEC + 1100); // A memory task másodpercenként fut
+    CHECK(busStats.fsWrites == 3);
+
+    // Felülírás és törlés, majd "újraindulás": az index a naplóból épül fel
+    CHECK(memoryStore.save(makeMemoryChannel(50, 11, 6100)));
+    CHECK(memoryStore.erase(60));
+    CHECK(!memoryStore.erase(61));
+    memoryStore.flush();
+    MemoryStore restarted;
+    CHECK(restarted.begin());
+    CHECK(restarted.getCount() == 39);
+    CHECK(restarted.recall(50, record) and record.frequency == 6100);
+    CHECK(!restarted.isUsed(60));
+    CHECK(restarted.recall(0, record) and record.bandIdx == 11 and record.mode == AM);
+
+    // Tömörítés: a napló a csak az élő rekordokra zsugorodik
+    for (uint16_t i = 0; memoryStore.getLogRecords() > memoryStore.getCount() and i < MEMORY_LOG_MAX_RECORDS; i++) {
+        memoryStore.save(makeMemoryChannel(1, 11, 6000 + i % 100));
+    }
+    memoryStore.flush();
+    CHECK(memoryStore.getLogRecords() == memoryStore.getCount());
+    CHECK(memoryStore.recall(50, record) and record.frequency == 6100);
+    CHECK(restarted.begin());
+    CHECK(restarted.getLogRecords() == memoryStore.getCount());
+
+    // Tömörítés közbeni tápvesztés: a félkész másolatot induláskor töröljük, a napló érintetlen
+    File partial = LittleFS.open(MEMORY_TEMP_FILE_NAME, "w");
+    partial.write((const uint8_t *)&record, sizeof(record));
+    partial.close();
+    CHECK(restarted.begin());
+    CHECK(!LittleFS.exists(MEMORY_TEMP_FILE_NAME));
+    CHECK(restarted.getCount() == memoryStore.getCount());
+
+    // A régi (törlés + átnevezés) csere között megszakadt: a teljes másolatból lesz a napló
+    CHECK(LittleFS.rename(MEMORY_FILE_NAME, MEMORY_TEMP_FILE_NAME));
+    CHECK(restarted.begin());
+    CHECK(LittleFS.exists(MEMORY_FILE_NAME) and !LittleFS.exists(MEMORY_TEMP_FILE_NAME));
+    CHECK(restarted.getCount() == memoryStore.getCount());
+    CHECK(restarted.recall(50, record) and record.frequency == 6100);
+
+    // Visszahívás a soros paranccsal: band váltás és hangolás, a teljes rekorddal (moduláció, BFO, sávszélesség)
+    MemoryChannel_t ssbChannel = makeMemoryChannel(7, 14, 9650);
+    ssbChannel.mode = LSB;
+    ssbChannel.bfo = 120;
+    ssbChannel.bandwidth = 2;
+    memoryStore.save(ssbChannel);
+    uint16_t fmFreq = band.getBandState(0).currentFreq;
+    uint8_t bwIdxSSB = config.data.bwIdxSSB;
+    simSerialCommand("mem recall 7");
+    simRunMsec(1000); // SSB patch letöltés
+    CHECK(config.data.bandIdx == 14);
+    CHECK(si4735.getCurrentFrequency() == 9650);
+    CHECK(band.currentMode == LSB);
+    CHECK(config.data.currentBFO == 120 and config.data.bwIdxSSB == 2);
+    RadioSnapshot_t snapshot;
+    radioService.getSnapshot(snapshot);
+    CHECK(snapshot.mode == LSB and snapshot.bfo == 120 and snapshot.bandwidth == 2);
+
+    // Mentés a soros paranccsal: a rekord a core1 pillanatképéből készül
+    simSerialCommand("mem save 8 TEST");
+    simRunMsec(100);
+    CHECK(memoryStore.recall(8, record));
+    CHECK(record.bandIdx == 14 and record.frequency == 9650 and record.mode == band.currentMode);
+    CHECK(strncmp(record.name, "TEST", MEMORY_NAME_LENGTH) == 0);
+
+    band.getBandState(0).currentFreq = fmFreq;
+    config.data.bwIdxSSB = bwIdxSSB;
+    simSerialCommand("band 0");
+    simRunMsec(100);
+    band.getBandState(14).lastBFO = 0;
+    LittleFS.simFormat();
+    memoryStore.begin();
+}
+
+static void testMemoryChannelsWriteFailure() {
+    // Sikertelen kiírásnál a teli puffer megmarad, a további mentés hibát ad (nincs túlcsordulás)
+    LittleFS.simSetWriteFailure(true);
+    for (uint16_t ch = 0; ch < MEMORY_WRITE_BATCH; ch++) {
+        CHECK(memoryStore.save(makeMemoryChannel(ch, 11, 6000 + ch)));
+    }
+    CHECK(memoryStore.getLogRecords() == MEMORY_WRITE_BATCH);
+    CHECK(!memoryStore.save(makeMemoryChannel(100, 11, 7000)));
+    CHECK(!memoryStore.erase(0));
+    CHECK(memoryStore.getLogRecords() == MEMORY_WRITE_BATCH);
+    CHECK(!memoryStore.isUsed(100));
+
+    // A fájlrendszer helyreáll: a következő mentés kiírja a puffert
+    LittleFS.simSetWriteFailure(false);
+    CHECK(memoryStore.save(makeMemoryChannel(100, 11, 7000)));
+    CHECK(memoryStore.flush());
+    MemoryStore restarted;
+    CHECK(restarted.begin());
+    CHECK(restarted.getCount() == MEMORY_WRITE_BATCH + 1);
+
+    LittleFS.simFormat();
+    memoryStore.begin();
+}
+
+static void testConfigSaveOnlyOnChange() {
+    busStatsReset();
+    config.checkSave();
+    uint32_t commits = busStats.eepromCommits;
+
+    // Változatlan adatokra nincs újabb írás
+    config.checkSave();
+    CHECK(busStats.eepromCommits == commits);
+
+    config.data.currentVOL++;
+    config.checkSave();
+    CHECK(busStats.eepromCommits == commits + 1);
+}
+
+static void testWatchdogFedAndReportsOverrun() {
+    // A futó firmware eteti a watchdogot
+    uint32_t resets = rp2040.simWdtResets;
+    simRunMsec(100, 0);
+    CHECK(rp2040.simWdtTimeoutMsec == loopWatchdog.getBudgetMsec());
+    CHECK(rp2040.simWdtResets > resets);
+
+    // Túlfutás: a keretidő 3/4-énél rögzít, majd a "reset" után az új példány kiolvassa
+    LoopWatchdog watchdog;
+    watchdog.begin(1000);
+    watchdog.core1Alive();
+    watchdog.feed();
+    {
+        PROFILE_STAGE(STAGE_EEPROM);
+        delay(800);
+        watchdog.check();
+    }
+
+    simWatchdogRebooted = true;
+    LoopWatchdog rebooted;
+    rebooted.begin(1000);
+    simWatchdogRebooted = false;
+
+    const LoopWatchdog::Report_t &report = rebooted.getLastReport();
+    CHECK(report.reason == LoopWatchdog::REASON_LOOP_OVERRUN);
+    CHECK(report.stageCore0 == STAGE_EEPROM);
+    CHECK(report.loopMsec >= 750);
+
+    // Ha a loop időben visszatér, a bejegyzés törlődik
+    rebooted.feed();
+    delay(800);
+    rebooted.check();
+    rebooted.feed();
+    simWatchdogRebooted = true;
+    LoopWatchdog clean;
+    clean.begin(1000);
+    simWatchdogRebooted = false;
+    CHECK(clean.getLastReport().reason == LoopWatchdog::REASON_UNKNOWN);
+
+    // A core1 elakadását a core0 etetése nem törli, csak a core1 újabb életjele
+    clean.core1Alive();
+    for (uint8_t i = 0; i < 16; i++) {
+        delay(50);
+        clean.feed();
+    }
+    clean.check();
+    clean.feed();
+    simWatchdogRebooted = true;
+    LoopWatchdog stalled;
+    stalled.begin(1000);
+    simWatchdogRebooted = false;
+    CHECK(stalled.getLastReport().reason == LoopWatchdog::REASON_CORE1_STALL);
+
+    stalled.core1Alive();
+    for (uint8_t i = 0; i < 16; i++) {
+        delay(50);
+        stalled.feed();
+    }
+    stalled.check();
+    stalled.core1Alive();
+    stalled.feed();
+    simWatchdogRebooted = true;
+    LoopWatchdog recovered;
+    recovered.begin(1000);
+    simWatchdogRebooted = false;
+    CHECK(recovered.getLastReport().reason == LoopWatchdog::REASON_UNKNOWN);
+
+    // A firmware watchdogját visszaállítjuk
+    loopWatchdog.begin(loopWatchdog.getBudgetMsec());
+}
+
+int main() {
+    Serial.muted = true;
+
+    struct {
+        const char *name;
+        void (*fn)();
+    } tests[] = {
+        {"scheduler priority/deadline", testSchedulerPriorityAndDeadline},
+        {"scheduler postpone", testSchedulerPostpone},
+        {"spsc queue", testSpscQueue},
+        {"seqlock", testSeqLock},
+        {"boot", testBoot},
+        {"idle display", testIdleDisplayHasNoFullRedraw},
+        {"signal quality cache", testSignalQualityCache},
+        {"encoder tunes", testEncoderTunes},
+        {"encoder burst coalesced", testEncoderBurstCoalesced},
+        {"rds group decoder", testRdsGroupDecoder},
+        {"rds decoded", testRdsDecoded},
+        {"rds interrupt drains fifo", testRdsInterruptDrainsFifo},
+        {"rds block errors dropped", testRdsBlockErrorsDropped},
+        {"squelch mutes", testSquelchMutes},
+        {"serial commands", testSerialCommands},
+        {"ssb patch stays resident", testSsbPatchStaysResident},
+        {"band switch property diff", testBandSwitchWritesOnlyChangedProperties},
+        {"band index direct tune", testBandIndexDirectTune},
+        {"property shadow", testPropertyShadowSkipsRedundantIo},
+        {"i2c clock calibration", testI2cClockCalibration},
+        {"i2c clock fallback", testI2cClockFallback},
+        {"band scope sweep", testBandScopeSweep},
+        {"station scan sorted by signal", testStationScanSortedBySignal},
+        {"station scan after ssb band", testStationScanAfterSsbBand},
+        {"band store writes only changed bands", testBandStoreWritesOnlyChangedBands},
+        {"memory channels batched log", testMemoryChannelsBatchedLog},
+        {"memory channels write failure", testMemoryChannelsWriteFailure},
+        {"config save on change", testConfigSaveOnlyOnChange},
+        {"watchdog overrun report", testWatchdogFedAndReportsOverrun},
+    };
+
+    for (auto &test : tests) {
+        uint16_t before = failures;
+        test.fn();
+        fprintf(stderr, "%s %s\n", failures == before ? "[ OK ]" : "[FAIL]", test.name);
+    }
+
+    fprintf(stderr, "%u failure(s)\n", failures);
+    return failures ? 1 : 0;
+}
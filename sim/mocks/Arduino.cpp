@@ -0,0 +1,120 @@
+#include "Arduino.h"
+#include "EEPROM.h"
+#include "LittleFS.h"
+#include "TFT_eSPI.h"
+#include "Wire.h"
+#include "hardware/watchdog.h"
+
+//--- Globális példányok
+uint64_t simClockMicros = 0;
+uint8_t simPinLevels[SIM_PIN_COUNT] = {};
+BusStats_t busStats = {};
+BusTiming_t busTiming = {};
+SerialMock Serial;
+RP2040 rp2040;
+EEPROMClass EEPROM;
+LittleFSClass LittleFS;
+TwoWire Wire;
+const GFXfont FreeSansBold9pt7b = {nullptr, nullptr, 0x20, 0x7E, 22};
+extern "C" {
+char __flash_binary_end = 0; // A linker szimbólum helyett (PicoMemoryInfo)
+}
+
+// Watchdog scratch regiszterek
+static watchdog_hw_t simWatchdogHw = {};
+watchdog_hw_t *watchdog_hw = &simWatchdogHw;
+bool simWatchdogRebooted = false;
+
+/**
+ * Buszforgalom számlálók nullázása
+ */
+void busStatsReset() {
+    memset(&busStats, 0, sizeof(busStats));
+}
+
+//--- Megszakítások: a szimuláció a pin szint változtatása után hívja a simFireInterrupt()-ot
+static voidFuncPtr interruptHandlers[SIM_PIN_COUNT] = {};
+
+void attachInterrupt(uint8_t pin, voidFuncPtr callback, int /*mode*/) {
+    if (pin < SIM_PIN_COUNT) {
+        interruptHandlers[pin] = callback;
+    }
+}
+
+void detachInterrupt(uint8_t pin) {
+    if (pin < SIM_PIN_COUNT) {
+        interruptHandlers[pin] = nullptr;
+    }
+}
+
+void simFireInterrupt(uint8_t pin) {
+    if (pin < SIM_PIN_COUNT and interruptHandlers[pin]) {
+        interruptHandlers[pin]();
+    }
+}
+
+//--- Soros port
+void SerialMock::simInput(const char *str) {
+    while (*str) {
+        uint16_t next = (inputHead + 1) % sizeof(input);
+        if (next == inputTail) {
+            break;
+        }
+        input[inputHead] = *str++;
+        inputHead = next;
+    }
+}
+
+int SerialMock::available() {
+    return (inputHead - inputTail + sizeof(input)) % sizeof(input);
+}
+
+int SerialMock::read() {
+    if (inputHead == inputTail) {
+        return -1;
+    }
+    char c = input[inputTail];
+    inputTail = (inputTail + 1) % sizeof(input);
+    return c;
+}
+
+int SerialMock::printf(const char *fmt, ...) {
+    if (muted) {
+        return 0;
+    }
+    va_list args;
+    va_start(args, fmt);
+    int len = vprintf(fmt, args);
+    va_end(args);
+    return len;
+}
+
+int SerialMock::printf_P(const char *fmt, ...) {
+    if (muted) {
+        return 0;
+    }
+    va_list args;
+    va_start(args, fmt);
+    int len = vprintf(fmt, args);
+    va_end(args);
+    return len;
+}
+
+size_t SerialMock::print(const char *str) {
+    return muted ? 0 : fputs(str, stdout);
+}
+
+size_t SerialMock::print(int value, int base) {
+    if (muted) {
+        return 0;
+    }
+    return base == HEX ? printf("%x", value) : printf("%d", value);
+}
+
+size_t SerialMock::println(const char *str) {
+    return muted ? 0 : print(str) + print("\n");
+}
+
+size_t SerialMock::println(int value, int base) {
+    return muted ? 0 : print(value, base) + print("\n");
+}
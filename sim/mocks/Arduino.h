@@ -0,0 +1,169 @@
+#ifndef __ARDUINO_H
+#define __ARDUINO_H
+
+/**
+ * Az arduino-pico core minimális host (Linux) megvalósítása a szimulációs buildhez
+ * Az idő virtuális: csak a szimuláció (és a bus mock-ok) léptetik
+ */
+
+#include <algorithm>
+#include <functional>
+#include <math.h>
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "BusStats.h"
+#include "WString.h"
+
+typedef bool boolean;
+typedef uint8_t byte;
+
+#define HIGH 1
+#define LOW 0
+#define INPUT 0
+#define OUTPUT 1
+#define INPUT_PULLUP 2
+#define LED_BUILTIN 25
+
+#define CHANGE 1
+#define FALLING 2
+#define RISING 3
+
+#define HEX 16
+#define DEC 10
+
+#define F_CPU 133000000
+
+//--- PROGMEM (a host-on sima memória)
+#define PROGMEM
+#define PSTR(s) (s)
+#define F(s) (reinterpret_cast<const __FlashStringHelper *>(PSTR(s)))
+#define pgm_read_byte(addr) (*(const uint8_t *)(addr))
+#define pgm_read_word(addr) (*(const uint16_t *)(addr))
+#define pgm_read_dword(addr) (*(const uint32_t *)(addr))
+#define pgm_read_ptr(addr) (*(void *const *)(addr))
+
+//--- Megszakítások (a host-on nincs mit tiltani)
+inline void cli() {}
+inline void sei() {}
+inline void noInterrupts() {}
+inline void interrupts() {}
+
+//--- min/max (az arduino-pico API-hoz hasonlóan eltérő típusokkal is)
+template <class T, class L>
+auto min(const T &a, const L &b) -> decltype((b < a) ? b : a) {
+    return (b < a) ? b : a;
+}
+template <class T, class L>
+auto max(const T &a, const L &b) -> decltype((b < a) ? b : a) {
+    return (a < b) ? b : a;
+}
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+
+//--- Virtuális idő
+extern uint64_t simClockMicros;
+inline void simAdvanceMicros(uint64_t usec) { simClockMicros += usec; }
+inline unsigned long millis() { return (unsigned long)(simClockMicros / 1000); }
+inline unsigned long micros() { return (unsigned long)simClockMicros; }
+inline void delay(unsigned long msec) { simAdvanceMicros((uint64_t)msec * 1000); }
+inline void delayMicroseconds(unsigned int usec) { simAdvanceMicros(usec); }
+inline void yield() {}
+
+//--- GPIO (a szimuláció állíthatja a bemenetek szintjét)
+#define SIM_PIN_COUNT 32
+extern uint8_t simPinLevels[SIM_PIN_COUNT];
+inline void pinMode(uint8_t pin, uint8_t mode) {
+    if (pin < SIM_PIN_COUNT and mode == INPUT_PULLUP) {
+        simPinLevels[pin] = HIGH;
+    }
+}
+inline int digitalRead(uint8_t pin) { return pin < SIM_PIN_COUNT ? simPinLevels[pin] : LOW; }
+inline void digitalWrite(uint8_t pin, uint8_t val) {
+    if (pin < SIM_PIN_COUNT) {
+        simPinLevels[pin] = val;
+    }
+}
+inline void tone(uint8_t /*pin*/, unsigned int /*frequency*/, unsigned long /*duration*/ = 0) {}
+inline void noTone(uint8_t /*pin*/) {}
+
+typedef void (*voidFuncPtr)(void);
+inline int digitalPinToInterrupt(uint8_t pin) { return pin; }
+void attachInterrupt(uint8_t pin, voidFuncPtr callback, int mode);
+void detachInterrupt(uint8_t pin);
+void simFireInterrupt(uint8_t pin);
+
+//--- Soros port (stdout)
+class SerialMock {
+public:
+    bool muted = false; // A szimuláció elnémíthatja a DEBUG kimenetet
+
+    void begin(unsigned long /*baud*/) {}
+    operator bool() const { return true; }
+
+    // Bemenet: a szimuláció tölti fel
+    void simInput(const char *str);
+    int available();
+    int read();
+
+    int printf(const char *fmt, ...);
+    int printf_P(const char *fmt, ...);
+    size_t print(const char *str);
+    size_t print(const String &str) { return print(str.c_str()); }
+    size_t print(int value, int base = DEC);
+    size_t println(const char *str = "");
+    size_t println(const String &str) { return println(str.c_str()); }
+    size_t println(int value, int base = DEC);
+
+private:
+    char input[256];
+    uint16_t inputHead = 0;
+    uint16_t inputTail = 0;
+};
+extern SerialMock Serial;
+
+//--- RP2040 támogatás (ciklusszámláló a virtuális időből)
+class RP2040 {
+public:
+    uint32_t getCycleCount() { return (uint32_t)(simClockMicros * (F_CPU / 1000000)); }
+    uint64_t getCycleCount64() { return simClockMicros * (F_CPU / 1000000); }
+    int getTotalHeap() { return 256 * 1024; }
+    int getUsedHeap() { return 0; }
+    int getFreeHeap() { return 256 * 1024; }
+    void wdt_begin(uint32_t delayMsec) { simWdtTimeoutMsec = delayMsec; }
+    void wdt_reset() { simWdtResets++; }
+    uint32_t simWdtTimeoutMsec = 0; // 0: a watchdog nincs élesítve
+    uint32_t simWdtResets = 0;
+    void idleOtherCore() {}
+    void resumeOtherCore() {}
+};
+extern RP2040 rp2040;
+
+//--- pico-sdk mutex (egyszálú host-on nincs tényleges zárolás)
+typedef struct {
+    uint32_t owner;
+} mutex_t;
+inline void mutex_init(mutex_t *mtx) { mtx->owner = 0; }
+#define auto_init_mutex(name) static mutex_t name = {0}
+
+inline uint32_t get_core_num() { return 0; }
+
+//--- Alvás: a host-on nincs mire várni, a virtuális időt a szimuláció lépteti
+inline void __wfi() {}
+inline void __wfe() {}
+inline void __sev() {}
+
+//--- pico-sdk idő és alarm
+typedef uint64_t absolute_time_t;
+typedef int32_t alarm_id_t;
+typedef int64_t (*alarm_callback_t)(alarm_id_t id, void *userData);
+inline uint64_t time_us_64() { return simClockMicros; }
+inline absolute_time_t from_us_since_boot(uint64_t usec) { return usec; }
+inline absolute_time_t make_timeout_time_ms(uint32_t msec) { return simClockMicros + (uint64_t)msec * 1000; }
+inline alarm_id_t add_alarm_at(absolute_time_t /*time*/, alarm_callback_t /*callback*/, void * /*userData*/, bool /*fireIfPast*/) { return 1; }
+inline bool cancel_alarm(alarm_id_t /*alarm*/) { return true; }
+inline bool best_effort_wfe_or_timeout(absolute_time_t timeout) { return simClockMicros >= timeout; }
+
+#endif // __ARDUINO_H
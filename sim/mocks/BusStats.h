@@ -0,0 +1,91 @@
+#ifndef __BUSSTATS_H
+#define __BUSSTATS_H
+
+#include <stdint.h>
+
+/**
+ * Szimulált buszforgalom számlálók (host build)
+ * A mock-ok (SI4735, Wire, TFT_eSPI, EEPROM) minden tranzakciót és bájtot itt könyvelnek
+ */
+struct BusStats_t {
+    // I2C (Si4735)
+    uint32_t i2cTransactions;
+    uint32_t i2cBytes;
+
+    // SPI (ILI9488 + XPT2046 touch)
+    uint32_t spiTransactions;
+    uint32_t spiBytes;
+
+    // EEPROM emuláció (flash)
+    uint32_t eepromCommits;
+    uint32_t eepromBytes;
+    uint32_t eepromWrittenBytes; // A put()/write() által módosított bájtok (a commit() mindig a teljes területet írja)
+
+    // LittleFS (flash)
+    uint32_t fsWrites; // File::write() hívások
+    uint32_t fsPages;  // Az írások által érintett flash lapok
+};
+
+extern BusStats_t busStats;
+
+#define SIM_I2C_DEFAULT_HZ 100000 // Normál módú I2C órajel
+#define SIM_SPI_HZ 40000000       // Az ILI9488 SPI órajele (TFT_eSPI SPI_FREQUENCY)
+
+/**
+ * Időhű busz modell (a benchmark kapcsolja be)
+ * Bekapcsolva a buszforgalom és a chip várakozásai a virtuális órát is léptetik, és fázisonként összesítjük őket.
+ * Kikapcsolva (alapértelmezés) a buszművelet nem tart ideig, a tesztek időzítése így független a forgalomtól.
+ */
+struct BusTiming_t {
+    bool enabled;
+    uint64_t i2cMicros;    // I2C buszidő
+    uint64_t spiMicros;    // SPI buszidő
+    uint64_t settleMicros; // A chip várakozásai (POWER_UP, hangolás)
+};
+
+extern BusTiming_t busTiming;
+extern uint64_t simClockMicros;
+
+/**
+ * Buszidő/várakozás könyvelése és a virtuális óra léptetése (csak bekapcsolt időmodell mellett)
+ */
+inline void busTimingAdvance(uint64_t &counter, uint64_t usec) {
+    if (busTiming.enabled) {
+        counter += usec;
+        simClockMicros += usec;
+    }
+}
+
+/**
+ * Számlálók nullázása
+ */
+void busStatsReset();
+
+/**
+ * I2C forgalom könyvelése
+ */
+inline void busStatsI2C(uint32_t bytes, uint32_t clockHz = SIM_I2C_DEFAULT_HZ) {
+    busStats.i2cTransactions++;
+    busStats.i2cBytes += bytes + 1; // + a cím bájt
+
+    // Bájtonként 9 bit (8 adat + ACK), plusz START/STOP
+    busTimingAdvance(busTiming.i2cMicros, ((bytes + 1) * 9 + 2) * 1000000ULL / clockHz);
+}
+
+/**
+ * SPI forgalom könyvelése
+ */
+inline void busStatsSPI(uint32_t bytes) {
+    busStats.spiTransactions++;
+    busStats.spiBytes += bytes;
+    busTimingAdvance(busTiming.spiMicros, bytes * 8ULL * 1000000ULL / SIM_SPI_HZ);
+}
+
+/**
+ * A chip várakozásának (settle) könyvelése
+ */
+inline void busTimingSettle(uint32_t usec) {
+    busTimingAdvance(busTiming.settleMicros, usec);
+}
+
+#endif // __BUSSTATS_H
@@ -0,0 +1,20 @@
+#ifndef __CRC_H
+#define __CRC_H
+
+#include <stdint.h>
+
+/**
+ * A Rob Tillaart CRC könyvtár calcCRC16() függvényének host megvalósítása (CRC-16, 0x8001 polinom)
+ */
+inline uint16_t calcCRC16(const uint8_t *array, uint16_t length, uint16_t polynome = 0x8001, uint16_t startmask = 0x0000, uint16_t endmask = 0x0000) {
+    uint16_t crc = startmask;
+    while (length--) {
+        crc ^= ((uint16_t)*array++) << 8;
+        for (uint8_t i = 0; i < 8; i++) {
+            crc = (crc & 0x8000) ? (crc << 1) ^ polynome : crc << 1;
+        }
+    }
+    return crc ^ endmask;
+}
+
+#endif // __CRC_H
@@ -0,0 +1,27 @@
+#ifndef __COREMUTEX_H
+#define __COREMUTEX_H
+
+#include "Arduino.h"
+#include <cstdio>
+#include <cstdlib>
+
+/**
+ * arduino-pico CoreMutex host megvalósítása (egyszálú szimuláció, nincs tényleges zárolás)
+ * A pico-sdk mutex nem rekurzív: ha ugyanaz a kód kétszer veszi fel, az a valós hardveren holtpont, itt azonnal leállunk
+ */
+class CoreMutex {
+private:
+    mutex_t *mutex;
+
+public:
+    CoreMutex(mutex_t *mutex, uint8_t /*option*/ = 0) : mutex(mutex) {
+        if (mutex->owner != 0) {
+            fprintf(stderr, "CoreMutex: a zár már foglalt (holtpont a valós hardveren)\n");
+            abort();
+        }
+        mutex->owner = 1;
+    }
+    ~CoreMutex() { mutex->owner = 0; }
+};
+
+#endif // __COREMUTEX_H
@@ -0,0 +1,59 @@
+#ifndef __EEPROM_H
+#define __EEPROM_H
+
+#include "Arduino.h"
+
+#define SIM_EEPROM_MAX_SIZE 4096
+
+/**
+ * arduino-pico EEPROM (flash emuláció) host megvalósítása
+ * A commit() a teljes emulált területet írja, ezt könyveljük a BusStats-ba
+ */
+class EEPROMClass {
+public:
+    EEPROMClass() { memset(data, 0xFF, sizeof(data)); } // Törölt flash
+
+    void begin(size_t size) { this->size = size < SIM_EEPROM_MAX_SIZE ? size : SIM_EEPROM_MAX_SIZE; }
+    size_t length() const { return size; }
+
+    uint8_t read(int address) const { return data[address]; }
+    void write(int address, uint8_t value) {
+        data[address] = value;
+        busStats.eepromWrittenBytes++;
+        dirty = true;
+    }
+
+    template <typename T>
+    T &get(int address, T &t) {
+        memcpy((void *)&t, &data[address], sizeof(T));
+        return t;
+    }
+
+    template <typename T>
+    const T &put(int address, const T &t) {
+        memcpy(&data[address], (const void *)&t, sizeof(T));
+        busStats.eepromWrittenBytes += sizeof(T);
+        dirty = true;
+        return t;
+    }
+
+    bool commit() {
+        if (dirty) {
+            busStats.eepromCommits++;
+            busStats.eepromBytes += size;
+            dirty = false;
+        }
+        return true;
+    }
+
+    uint8_t *getDataPtr() { return data; }
+
+private:
+    uint8_t data[SIM_EEPROM_MAX_SIZE];
+    size_t size = 0;
+    bool dirty = false;
+};
+
+extern EEPROMClass EEPROM;
+
+#endif // __EEPROM_H
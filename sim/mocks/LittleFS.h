@@ -0,0 +1,136 @@
+#ifndef __LITTLEFS_H
+#define __LITTLEFS_H
+
+#include "Arduino.h"
+#include <map>
+#include <string>
+#include <vector>
+
+#define SIM_FS_PAGE_SIZE 256 // A flash programozási egysége (FLASH_PAGE_SIZE)
+
+enum SeekMode {
+    SeekSet = 0,
+    SeekCur = 1,
+    SeekEnd = 2
+};
+
+/**
+ * arduino-pico FS File host megvalósítása (memóriában tárolt fájl)
+ * Minden write() egy flash írásként könyvelődik, a kiírt lapok számával együtt
+ */
+class File {
+public:
+    File() {}
+    File(std::vector<uint8_t> *data, size_t pos, bool writable) : data(data), pos(pos), writable(writable) {}
+
+    operator bool() const { return data != nullptr; }
+    size_t size() const { return data ? data->size() : 0; }
+    size_t position() const { return pos; }
+
+    bool seek(uint32_t offset, SeekMode mode = SeekSet) {
+        if (!data) {
+            return false;
+        }
+        size_t target = mode == SeekSet ? offset : mode == SeekCur ? pos + offset : data->size() + offset;
+        if (target > data->size()) {
+            return false;
+        }
+        pos = target;
+        return true;
+    }
+
+    size_t read(uint8_t *buf, size_t size) {
+        if (!data) {
+            return 0;
+        }
+        size_t n = std::min(size, data->size() - pos);
+        memcpy(buf, data->data() + pos, n);
+        pos += n;
+        return n;
+    }
+
+    size_t write(const uint8_t *buf, size_t size) {
+        if (!data or !writable) {
+            return 0;
+        }
+        if (pos + size > data->size()) {
+            data->resize(pos + size);
+        }
+        memcpy(data->data() + pos, buf, size);
+        busStats.fsWrites++;
+        busStats.fsPages += (pos + size + SIM_FS_PAGE_SIZE - 1) / SIM_FS_PAGE_SIZE - pos / SIM_FS_PAGE_SIZE;
+        pos += size;
+        return size;
+    }
+
+    void flush() {}
+    void close() { data = nullptr; }
+
+private:
+    std::vector<uint8_t> *data = nullptr;
+    size_t pos = 0;
+    bool writable = false;
+};
+
+/**
+ * arduino-pico LittleFS host megvalósítása
+ */
+class LittleFSClass {
+public:
+    bool begin() { return mounted = true; }
+    void end() { mounted = false; }
+
+    bool exists(const char *path) const { return files.count(path) > 0; }
+
+    bool remove(const char *path) { return files.erase(path) > 0; }
+
+    bool rename(const char *from, const char *to) {
+        auto it = files.find(from);
+        if (it == files.end()) {
+            return false;
+        }
+        files[to] = std::move(it->second);
+        files.erase(from);
+        return true;
+    }
+
+    /**
+     * Fájl megnyitása: "r", "r+", "w", "w+", "a", "a+"
+     */
+    File open(const char *path, const char *mode) {
+        if (!mounted or (simFailWrites and mode[0] != 'r')) {
+            return File();
+        }
+        bool create = mode[0] == 'w' or mode[0] == 'a';
+        auto it = files.find(path);
+        if (it == files.end()) {
+            if (!create) {
+                return File();
+            }
+            it = files.emplace(path, std::vector<uint8_t>()).first;
+        }
+        if (mode[0] == 'w') {
+            it->second.clear();
+        }
+        return File(&it->second, mode[0] == 'a' ? it->second.size() : 0, mode[0] != 'r' or mode[1] == '+');
+    }
+
+    /**
+     * A fájlrendszer törlése (formázás)
+     */
+    void simFormat() { files.clear(); }
+
+    /**
+     * Írási hiba szimulálása: az írásra megnyitás sikertelen (pl.: betelt a fájlrendszer)
+     */
+    void simSetWriteFailure(bool fail) { simFailWrites = fail; }
+
+private:
+    std::map<std::string, std::vector<uint8_t>> files;
+    bool mounted = false;
+    bool simFailWrites = false;
+};
+
+extern LittleFSClass LittleFS;
+
+#endif // __LITTLEFS_H
@@ -0,0 +1,7 @@
+#ifndef __RP2040SUPPORT_H
+#define __RP2040SUPPORT_H
+
+// Az RP2040 osztály a host buildben az Arduino.h-ban van
+#include "Arduino.h"
+
+#endif // __RP2040SUPPORT_H
@@ -0,0 +1,546 @@
+#include "SI4735.h"
+#include <string.h>
+
+/**
+ * Egy chip parancs I2C forgalmának könyvelése: CTS várakozás (1 bájt olvasás) + parancs írás + válasz olvasás
+ */
+void SI4735::sendCommand(uint8_t cmdBytes, uint8_t responseBytes) {
+    waitToSend();
+    busStatsI2C(cmdBytes, i2cClock);
+    if (responseBytes) {
+        busStatsI2C(responseBytes, i2cClock);
+    }
+}
+
+/**
+ * CTS lekérdezése (1 bájt státusz)
+ */
+void SI4735::waitToSend() {
+    busStatsI2C(1, i2cClock);
+}
+
+int16_t SI4735::getDeviceI2CAddress(uint8_t /*resetPin*/) {
+    busStatsI2C(0);
+    return 0x11;
+}
+
+void SI4735::setup(uint8_t resetPin, uint8_t defaultFunction) {
+    setup(resetPin, 0, defaultFunction);
+}
+
+void SI4735::setup(uint8_t /*resetPin*/, uint8_t /*ctsIntEnable*/, uint8_t defaultFunction, uint8_t /*audioMode*/, uint8_t /*clockType*/, uint8_t gpo2Enable) {
+    reset();
+    gpo2Enabled = gpo2Enable;
+    currentMode = defaultFunction == 0 ? FM_CURRENT_MODE : AM_CURRENT_MODE;
+    sendCommand(3, 0); // POWER_UP
+    busTimingSettle(SIM_POWERUP_SETTLE_USEC);
+}
+
+void SI4735::reset() {
+    propertyCount = 0;
+    patchBytes = 0;
+    rdsReceived = rdsSync = false;
+    rdsRecvLatch = rdsSyncFoundLatch = false;
+    rdsFifoUsed = 0;
+    intStatus = 0;
+    updateIntPin();
+}
+
+void SI4735::queryLibraryId() {
+    sendCommand(3, 8); // POWER_UP + válasz
+}
+
+void SI4735::patchPowerUp() {
+    sendCommand(3, 0);
+    busTimingSettle(SIM_POWERUP_SETTLE_USEC);
+
+    // Új letöltés kezdődik (a downloadPatch() darabokban is hívható)
+    patchBytes = 0;
+    patchChecksum = SIM_FNV_OFFSET;
+    patchDownloads++;
+}
+
+bool SI4735::downloadPatch(const uint8_t *ssb_patch_content, const uint16_t ssb_patch_content_size) {
+    for (uint16_t offset = 0; offset < ssb_patch_content_size; offset += 8) {
+        sendCommand(8, 0);
+    }
+    patchChecksum = simFnv1a(patchChecksum, ssb_patch_content, ssb_patch_content_size);
+    patchBytes += ssb_patch_content_size;
+
+    // A stabil órajel felett a chip hibát jelez (ERR a státuszban)
+    return i2cClock <= simMaxPatchI2CClock;
+}
+
+void SI4735::setFM() {
+    // POWER_DOWN + POWER_UP FM módban: a patch elveszik
+    currentMode = FM_CURRENT_MODE;
+    propertyCount = 0;
+    patchBytes = 0;
+    sendCommand(3, 0);
+    busTimingSettle(SIM_POWERUP_SETTLE_USEC);
+}
+
+void SI4735::setFM(uint16_t fromFreq, uint16_t toFreq, uint16_t initialFreq, uint16_t step) {
+    currentMinimumFrequency = fromFreq;
+    currentMaximumFrequency = toFreq;
+    currentStep = step;
+    setFM();
+    setFrequency(initialFreq);
+}
+
+void SI4735::setAM() {
+    // A könyvtár nem ad ki újabb POWER_UP-ot, ha már AM módban vagyunk (FM és SSB módból igen, a patch elveszik)
+    if (currentMode != AM_CURRENT_MODE) {
+        propertyCount = 0;
+        patchBytes = 0;
+        sendCommand(3, 0);
+        busTimingSettle(SIM_POWERUP_SETTLE_USEC);
+    }
+    currentMode = AM_CURRENT_MODE;
+}
+
+void SI4735::setAM(uint16_t fromFreq, uint16_t toFreq, uint16_t initialFreq, uint16_t step) {
+    currentMinimumFrequency = fromFreq;
+    currentMaximumFrequency = toFreq;
+    currentStep = step;
+    setAM();
+    setFrequency(initialFreq);
+}
+
+void SI4735::setSSB(uint16_t fromFreq, uint16_t toFreq, uint16_t initialFreq, uint16_t step, uint8_t /*usblsb*/) {
+    currentMinimumFrequency = fromFreq;
+    currentMaximumFrequency = toFreq;
+    currentStep = step;
+    currentMode = SSB_CURRENT_MODE;
+    sendCommand(3, 0);
+    busTimingSettle(SIM_POWERUP_SETTLE_USEC);
+    setFrequency(initialFreq);
+}
+
+void SI4735::setSSBBfo(int offset) {
+    setProperty(0x0100, (uint16_t)offset);
+}
+
+void SI4735::setSSBConfig(uint8_t AUDIOBW, uint8_t SBCUTFLT, uint8_t AVC_DIVIDER, uint8_t AVCEN, uint8_t SMUTESEL, uint8_t DSP_AFCDIS) {
+    setProperty(0x0101, AUDIOBW | (SBCUTFLT << 4) | (AVC_DIVIDER << 8) | (AVCEN << 12) | (SMUTESEL << 13) | (DSP_AFCDIS << 15));
+}
+
+void SI4735::setFrequency(uint16_t freq) {
+    sendCommand(currentMode == FM_CURRENT_MODE ? 5 : 6, 0); // FM_TUNE_FREQ / AM_TUNE_FREQ
+    busTimingSettle(maxDelaySetFrequency * 1000);
+    currentFrequency = freq;
+    tunes++;
+
+    // Az STC a valós hangolási idő után áll be (a könyvtár fix várakozása után már biztosan)
+    intStatus &= ~0x01;
+    tuneCompleteMicros = micros() + (maxDelaySetFrequency ? 0 : SIM_TUNE_STC_USEC);
+
+    // Új frekvencián újra kell szinkronizálni az RDS-t, a jelminőség a szimulált értékre áll
+    rdsReceived = rdsSync = false;
+    rdsRecvLatch = rdsSyncFoundLatch = false;
+    rdsBuffer0A[0] = rdsBuffer2A[0] = '\0';
+    rdsFifoUsed = 0;
+}
+
+void SI4735::frequencyUp() { 
+    uint16_t freq = currentFrequency + currentStep;
+    setFrequency(freq > currentMaximumFrequency ? currentMinimumFrequency : freq);
+}
+
+void SI4735::frequencyDown() { 
+    uint16_t freq = currentFrequency - currentStep;
+    setFrequency((freq < currentMinimumFrequency or currentFrequency < currentStep) ? currentMaximumFrequency : freq);
+}
+
+void SI4735::getStatus(uint8_t INTACK, uint8_t /*CANCEL*/) {
+    sendCommand(2, 8); // FM/AM_TUNE_STATUS
+
+    const SimStation_t *station = findStation(currentFrequency);
+    statusRssi = station ? station->rssi : simRssi;
+    statusSnr = station ? station->snr : simSnr;
+    if (INTACK) {
+        intStatus &= ~0x01;
+        tuneCompleteMicros = UINT64_MAX; // Nyugtázva: a következő hangolásig nem áll be újra
+    }
+}
+
+/**
+ * Seek: a következő állomásig, amely a seek küszöbök felett van (wrap nélkül a band határán megáll)
+ */
+void SI4735::seekStation(uint8_t SEEKUP, uint8_t /*WRAP*/) {
+    sendCommand(currentMode == FM_CURRENT_MODE ? 2 : 6, 0); // FM_SEEK_START / AM_SEEK_START
+
+    // SSB patch-csel a chip nem tud keresni: nincs STC (a hívónak kell elkerülnie)
+    if (currentMode == SSB_CURRENT_MODE) {
+        statusValid = statusBandLimit = false;
+        intStatus &= ~0x01;
+        tuneCompleteMicros = UINT64_MAX;
+        return;
+    }
+
+    bool fm = currentMode == FM_CURRENT_MODE;
+    uint16_t spacing = findProperty(fm ? 0x1402 : 0x3402, currentStep);
+    uint8_t snrThreshold = findProperty(fm ? 0x1403 : 0x3403, fm ? 3 : 5);
+    uint8_t rssiThreshold = findProperty(fm ? 0x1404 : 0x3404, fm ? 20 : 25);
+
+    uint32_t channels = 0;
+    uint16_t freq = currentFrequency;
+    statusValid = statusBandLimit = false;
+    while (true) {
+        if (SEEKUP ? freq + spacing > currentMaximumFrequency : freq < currentMinimumFrequency + spacing) {
+            statusBandLimit = true;
+            break;
+        }
+        freq = SEEKUP ? freq + spacing : freq - spacing;
+        channels++;
+        const SimStation_t *station = findStation(freq);
+        if (station and station->rssi >= rssiThreshold and station->snr >= snrThreshold) {
+            statusValid = true;
+            break;
+        }
+    }
+    currentFrequency = freq;
+    tunes++;
+    rdsReceived = rdsSync = false;
+    rdsRecvLatch = rdsSyncFoundLatch = false;
+    rdsFifoUsed = 0;
+
+    intStatus &= ~0x01;
+    tuneCompleteMicros = micros() + channels * SIM_SEEK_CHANNEL_USEC;
+}
+
+uint16_t SI4735::getFrequency() {
+    sendCommand(2, 8); // FM/AM_TUNE_STATUS
+    return currentFrequency;
+}
+
+void SI4735::setProperty(uint16_t propertyNumber, uint16_t param) {
+    sendCommand(6, 0);
+
+    // A chip a tartományon kívüli értéket elutasítja (a seek határokra ellenőrizzük, ide ír az I2C kalibrálás)
+    if ((propertyNumber == 0x1401 and (param < 6400 or param > 10800)) or (propertyNumber == 0x3401 and (param < 149 or param > 23000))) {
+        return;
+    }
+
+    uint8_t i = 0;
+    while (i < propertyCount and propertyIds[i] != propertyNumber) {
+        i++;
+    }
+    if (i == propertyCount) {
+        if (propertyCount == SIM_MAX_PROPERTIES) {
+            return;
+        }
+        propertyIds[propertyCount++] = propertyNumber;
+    }
+    propertyValues[i] = param;
+
+    // A megszakítás engedélyezés és az RSQ küszöbök azonnal hatnak
+    if (propertyNumber == 0x0001 or (propertyNumber & 0xFFF8) == 0x1200 or (propertyNumber & 0xFFF8) == 0x3200) {
+        checkRsqThresholds();
+        updateIntPin();
+    }
+}
+
+int32_t SI4735::getProperty(uint16_t propertyNumber) {
+    sendCommand(4, 4);
+
+    // A stabil órajel felett bithibás a válasz
+    uint16_t value = findProperty(propertyNumber, 0);
+    return i2cClock <= simMaxI2CClock ? value : value ^ 0x0100;
+}
+
+void SI4735::setVolume(uint8_t volume) {
+    this->volume = volume;
+    setProperty(0x4000, volume);
+}
+
+void SI4735::setAudioMute(bool off) {
+    muted = off;
+    muteWrites++;
+    if (audioMuteMcuPin >= 0) {
+        digitalWrite(audioMuteMcuPin, off ? HIGH : LOW);
+    }
+    setProperty(0x4001, off ? 3 : 0);
+}
+
+void SI4735::getAutomaticGainControl() {
+    sendCommand(1, 3); // FM/AM_AGC_STATUS
+}
+
+void SI4735::setAutomaticGainControl(uint8_t AGCDIS, uint8_t AGCIDX) {
+    agcEnabled = AGCDIS == 0;
+    agcIndex = AGCIDX;
+    sendCommand(3, 0); // FM/AM_AGC_OVERRIDE
+}
+
+void SI4735::getCurrentReceivedSignalQuality(uint8_t INTACK) {
+    sendCommand(2, currentMode == FM_CURRENT_MODE ? 8 : 6); // FM/AM_RSQ_STATUS
+    if (INTACK) {
+        intStatus &= ~0x08;
+        checkRsqThresholds(); // Ha a feltétel továbbra is fennáll, újra jelez
+        updateIntPin();
+    }
+    rsqRssi = simRssi;
+    rsqSnr = simSnr;
+    rsqPilot = currentMode == FM_CURRENT_MODE and simPilot;
+    rsqMultipath = simMultipath;
+    rsqFreqOffset = simFreqOffset;
+}
+
+void SI4735::RdsInit() {
+    rdsReceived = rdsSync = false;
+    rdsRecvLatch = rdsSyncFoundLatch = false;
+    rdsFifoUsed = 0;
+}
+
+void SI4735::setRdsConfig(uint8_t RDSEN, uint8_t BLETHA, uint8_t BLETHB, uint8_t BLETHC, uint8_t BLETHD) {
+    setProperty(0x1502, RDSEN | (BLETHD << 8) | (BLETHC << 10) | (BLETHB << 12) | (BLETHA << 14));
+}
+
+void SI4735::getRdsStatus(uint8_t INTACK, uint8_t /*MTFIFO*/, uint8_t /*STATUSONLY*/) {
+    sendCommand(2, 13); // FM_RDS_STATUS
+
+    // Egy csoport kivétele a FIFO-ból (a szövegeket egyszerűsítve egyben adjuk vissza)
+    rdsReceived = rdsFifoUsed > 0;
+    if (rdsFifoUsed > 0) {
+        rdsFifoUsed--;
+        const SimStation_t *station = findStation(currentFrequency);
+        memcpy(rdsBuffer0A, station ? station->ps : simStationName, sizeof(rdsBuffer0A));
+        memcpy(rdsBuffer2A, simMessage, sizeof(rdsBuffer2A));
+        simNextRdsGroup(station);
+    }
+    currentRdsStatus.resp.RDSRECV = rdsRecvLatch;
+    currentRdsStatus.resp.RDSSYNC = rdsSync;
+    currentRdsStatus.resp.RDSSYNCFOUND = rdsSyncFoundLatch;
+    currentRdsStatus.resp.RDSFIFOUSED = rdsFifoUsed;
+
+    // A kiürült FIFO után a következő olvasás már nem jelez új csoportot
+    if (rdsFifoUsed == 0) {
+        rdsRecvLatch = false;
+    }
+
+    // Az INTACK a latch-elt állapotbiteket is törli, a szinkron (RDSSYNC) marad
+    if (INTACK) {
+        rdsRecvLatch = rdsSyncFoundLatch = false;
+        intStatus &= ~0x04;
+        updateIntPin();
+    }
+}
+
+/**
+ * A következő nyers RDS csoport a FIFO-ból: 8 csoportos ciklusban 4 x 0A (a PS 4 szegmense), 1 x 4A (ha van idő) és 2A (RT)
+ */
+void SI4735::simNextRdsGroup(const SimStation_t *station) {
+
+    const char *ps = station ? station->ps : simStationName;
+    uint16_t blocks[4] = {station ? station->pi : (uint16_t)SIM_RDS_DEFAULT_PI, (uint16_t)((simPty & 0x1F) << 5), 0, 0};
+    uint8_t slot = rdsGroupSeq % 8;
+
+    if (slot % 2 == 0) {
+        uint8_t segment = slot / 2;
+        blocks[1] |= segment;
+        blocks[2] = 0xE0CD; // Nincs AF
+        blocks[3] = ((uint8_t)ps[segment * 2] << 8) | (uint8_t)ps[segment * 2 + 1];
+    } else if (slot == 3 and simHour <= 23) {
+        blocks[1] |= (4 << 12) | ((SIM_RDS_MJD >> 15) & 0x03);
+        blocks[2] = ((SIM_RDS_MJD & 0x7FFF) << 1) | (simHour >> 4);
+        blocks[3] = ((simHour & 0x0F) << 12) | (simMinute << 6);
+    } else {
+        // A szöveg a 0x0D végjellel, 4 karakteres szegmensekben
+        uint8_t length = strlen(simMessage);
+        uint8_t segments = length < sizeof(simMessage) - 1 ? length / 4 + 1 : 16;
+        uint8_t segment = rdsTextSeq++ % segments;
+        char text[4];
+        for (uint8_t i = 0; i < 4; i++) {
+            uint8_t pos = segment * 4 + i;
+            text[i] = pos < length ? simMessage[pos] : (pos == length ? '\r' : ' ');
+        }
+        blocks[1] |= (2 << 12) | (simRdsAb << 4) | segment;
+        blocks[2] = ((uint8_t)text[0] << 8) | (uint8_t)text[1];
+        blocks[3] = ((uint8_t)text[2] << 8) | (uint8_t)text[3];
+    }
+    rdsGroupSeq++;
+
+    currentRdsStatus.resp.BLOCKAH = blocks[0] >> 8;
+    currentRdsStatus.resp.BLOCKAL = blocks[0] & 0xFF;
+    currentRdsStatus.resp.BLOCKBH = blocks[1] >> 8;
+    currentRdsStatus.resp.BLOCKBL = blocks[1] & 0xFF;
+    currentRdsStatus.resp.BLOCKCH = blocks[2] >> 8;
+    currentRdsStatus.resp.BLOCKCL = blocks[2] & 0xFF;
+    currentRdsStatus.resp.BLOCKDH = blocks[3] >> 8;
+    currentRdsStatus.resp.BLOCKDL = blocks[3] & 0xFF;
+    currentRdsStatus.resp.BLEA = currentRdsStatus.resp.BLEC = currentRdsStatus.resp.BLED = 0;
+    currentRdsStatus.resp.BLEB = simRdsErrorEvery and rdsGroupSeq % simRdsErrorEvery == 0 ? 3 : 0;
+}
+
+si473x_status SI4735::getInterruptStatus() {
+    sendCommand(1, 1); // GET_INT_STATUS
+    if (micros() >= tuneCompleteMicros) {
+        intStatus |= 0x01; // STCINT
+    }
+    si473x_status status;
+    status.raw = intStatus | 0x80;
+    return status;
+}
+
+/**
+ * RDS csoportok érkezése: csak FM-ben, beállított RDS adatokkal és elég erős jel mellett
+ */
+void SI4735::simTick() {
+
+    const SimStation_t *station = findStation(currentFrequency);
+    bool available = currentMode == FM_CURRENT_MODE and (station ? station->ps[0] != '\0' and station->snr >= 10 : simStationName[0] != '\0' and simSnr >= 10);
+    if (!available) {
+        rdsSync = false;
+        rdsNextGroupMicros = simClockMicros + SIM_RDS_GROUP_USEC;
+        return;
+    }
+
+    if (!rdsSync) {
+        rdsSync = rdsSyncFoundLatch = true;
+    }
+
+    while (simClockMicros >= rdsNextGroupMicros) {
+        rdsNextGroupMicros += SIM_RDS_GROUP_USEC;
+        if (rdsFifoUsed < SIM_RDS_FIFO_SIZE) {
+            rdsFifoUsed++;
+            rdsRecvLatch = true;
+        } else {
+            rdsGroupsLost++;
+        }
+
+        // FM_RDS_INT_SOURCE (RDSRECV) + FM_RDS_INT_FIFO_COUNT
+        if ((findProperty(0x1500, 0) & 0x01) and rdsFifoUsed >= findProperty(0x1501, 0)) {
+            raiseInterrupt(0x04);
+        }
+    }
+}
+
+/**
+ * Property értéke (ha nincs beállítva, akkor az alapérték)
+ */
+uint16_t SI4735::findProperty(uint16_t propertyNumber, uint16_t defaultValue) {
+    for (uint8_t i = 0; i < propertyCount; i++) {
+        if (propertyIds[i] == propertyNumber) {
+            return propertyValues[i];
+        }
+    }
+    return defaultValue;
+}
+
+/**
+ * RSQ küszöbök ellenőrzése (FM_RSQ_*: 0x1200.., AM_RSQ_*: 0x3200..)
+ */
+void SI4735::checkRsqThresholds() {
+    uint16_t base = currentMode == FM_CURRENT_MODE ? 0x1200 : 0x3200;
+    uint16_t source = findProperty(base, 0);
+
+    bool hit = ((source & 0x01) and simRssi < findProperty(base + 4, 0))       // RSSI alsó
+               or ((source & 0x02) and simRssi > findProperty(base + 3, 127)) // RSSI felső
+               or ((source & 0x04) and simSnr < findProperty(base + 2, 0))    // SNR alsó
+               or ((source & 0x08) and simSnr > findProperty(base + 1, 127)); // SNR felső
+    if (hit) {
+        raiseInterrupt(0x08);
+    }
+}
+
+/**
+ * Megszakítás kérése: csak az engedélyezett (GPO_IEN) források jeleznek
+ */
+void SI4735::raiseInterrupt(uint8_t bits) {
+    intStatus |= bits;
+    updateIntPin();
+}
+
+/**
+ * A GPO2/INT kimenet aktív LOW, amíg van nyugtázatlan engedélyezett megszakítás
+ */
+void SI4735::updateIntPin() {
+    if (!gpo2Enabled or simIntPin < 0) {
+        return;
+    }
+
+    bool active = intStatus & findProperty(0x0001, 0) & 0x0F;
+    uint8_t prev = simPinLevels[simIntPin];
+    simPinLevels[simIntPin] = active ? LOW : HIGH;
+    if (active and prev == HIGH) {
+        simFireInterrupt(simIntPin);
+    }
+}
+
+uint16_t SI4735::getRdsPI() {
+    const SimStation_t *station = findStation(currentFrequency);
+    return rdsReceived and station ? station->pi : 0;
+}
+
+char *SI4735::getRdsText0A() {
+    return rdsReceived ? rdsBuffer0A : nullptr;
+}
+
+char *SI4735::getRdsText2A() {
+    return rdsReceived ? rdsBuffer2A : nullptr;
+}
+
+bool SI4735::getRdsDateTime(uint16_t *year, uint16_t *month, uint16_t *day, uint16_t *hour, uint16_t *minute) {
+    if (!rdsReceived or simHour > 23) {
+        return false;
+    }
+    *year = 2024;
+    *month = 1;
+    *day = 1;
+    *hour = simHour;
+    *minute = simMinute;
+    return true;
+}
+
+/**
+ * Szimulált jelminőség beállítása (a következő RSQ lekérdezéstől érvényes)
+ */
+void SI4735::simSetSignal(uint8_t rssi, uint8_t snr, bool pilot, uint8_t multipath, int8_t freqOffset) {
+    simRssi = rssi;
+    simSnr = snr;
+    simPilot = pilot;
+    simMultipath = multipath;
+    simFreqOffset = freqOffset;
+    checkRsqThresholds();
+}
+
+/**
+ * Szimulált állomás felvétele
+ */
+void SI4735::simAddStation(uint16_t freq, uint8_t rssi, uint8_t snr, uint16_t pi, const char *ps) {
+    if (stationCount < SIM_MAX_STATIONS) {
+        SimStation_t &station = stations[stationCount++];
+        station = {freq, rssi, snr, pi, {}};
+        if (ps) {
+            strncpy(station.ps, ps, sizeof(station.ps) - 1);
+        }
+    }
+}
+
+/**
+ * Állomás az adott frekvencián
+ */
+const SI4735::SimStation_t *SI4735::findStation(uint16_t freq) const {
+    for (uint8_t i = 0; i < stationCount; i++) {
+        if (stations[i].freq == freq) {
+            return &stations[i];
+        }
+    }
+    return nullptr;
+}
+
+/**
+ * Szimulált RDS adatok beállítása (a következő RDS lekérdezéstől érvényes)
+ */
+void SI4735::simSetRds(const char *stationName, const char *message, uint8_t pty, uint8_t hour, uint8_t minute) {
+    if (strncmp(simMessage, message, sizeof(simMessage) - 1) != 0) {
+        simRdsAb = !simRdsAb;
+        rdsTextSeq = 0;
+    }
+    strncpy(simStationName, stationName, sizeof(simStationName) - 1);
+    strncpy(simMessage, message, sizeof(simMessage) - 1);
+    simPty = pty;
+    simHour = hour;
+    simMinute = minute;
+}
@@ -0,0 +1,322 @@
+#ifndef __SI4735_H
+#define __SI4735_H
+
+#include "Arduino.h"
+#include "Wire.h"
+
+/**
+ * A PU2CLR SI4735 könyvtár host megvalósítása (mock)
+ *
+ * Az állapotot (frekvencia, mód, property-k) egyszerűen modellezi, a jelminőséget és az RDS-t a szimuláció állítja be.
+ * Minden chip parancs I2C forgalmát az AN332 szerinti parancs/válasz hosszakkal könyveli a BusStats-ba.
+ */
+
+#define SI473X_ANALOG_AUDIO 0b00000101
+#define XOSCEN_CRYSTAL 1
+
+/**
+ * A GET_INT_STATUS/parancs státusz bájt (a PU2CLR könyvtár szerinti bitkiosztással)
+ */
+typedef union {
+    struct {
+        uint8_t STCINT : 1;
+        uint8_t DUMMY1 : 1;
+        uint8_t RDSINT : 1;
+        uint8_t RSQINT : 1;
+        uint8_t DUMMY2 : 2;
+        uint8_t ERR : 1;
+        uint8_t CTS : 1;
+    } resp;
+    uint8_t raw;
+} si473x_status;
+
+/**
+ * Az FM_RDS_STATUS válasza (a PU2CLR könyvtár szerinti bitkiosztással): státusz, FIFO, az A-D blokkok és a blokk hibák
+ */
+typedef union {
+    struct {
+        uint8_t STCINT : 1;
+        uint8_t DUMMY1 : 1;
+        uint8_t RDSINT : 1;
+        uint8_t RSQINT : 1;
+        uint8_t DUMMY2 : 2;
+        uint8_t ERR : 1;
+        uint8_t CTS : 1;
+        uint8_t RDSRECV : 1;
+        uint8_t RDSSYNCLOST : 1;
+        uint8_t RDSSYNCFOUND : 1;
+        uint8_t DUMMY3 : 1;
+        uint8_t RDSNEWBLOCKA : 1;
+        uint8_t RDSNEWBLOCKB : 1;
+        uint8_t DUMMY4 : 2;
+        uint8_t RDSSYNC : 1;
+        uint8_t DUMMY5 : 1;
+        uint8_t GRPLOST : 1;
+        uint8_t DUMMY6 : 5;
+        uint8_t RDSFIFOUSED;
+        uint8_t BLOCKAH;
+        uint8_t BLOCKAL;
+        uint8_t BLOCKBH;
+        uint8_t BLOCKBL;
+        uint8_t BLOCKCH;
+        uint8_t BLOCKCL;
+        uint8_t BLOCKDH;
+        uint8_t BLOCKDL;
+        uint8_t BLED : 2;
+        uint8_t BLEC : 2;
+        uint8_t BLEB : 2;
+        uint8_t BLEA : 2;
+    } resp;
+    uint8_t raw[13];
+} si47x_rds_status;
+
+#define SIM_RDS_FIFO_SIZE 25      // A chip RDS FIFO mérete (csoport)
+#define SIM_RDS_DEFAULT_PI 0x2001 // A háttér RDS PI-je (ha a frekvencián nincs szimulált állomás)
+#define SIM_RDS_MJD 60310         // A 4A csoport dátuma (2024-01-01)
+#define SIM_RDS_GROUP_USEC 87600 // Egy RDS csoport ideje (104 bit / 1187.5 bps)
+#define SIM_POWERUP_SETTLE_USEC 10000 // Várakozás a POWER_UP után (a PU2CLR könyvtár MAX_DELAY_AFTER_POWERUP értéke)
+#define SIM_TUNE_SETTLE_USEC 30000    // Várakozás a hangolás után (a PU2CLR könyvtár MAX_DELAY_AFTER_SET_FREQUENCY értéke)
+#define SIM_I2C_MAX_STABLE_HZ 500000  // A szimulált példány ezen az I2C órajelen még hibátlan
+#define SIM_TUNE_STC_USEC 8000        // A hangolás valós ideje (az STC bit ennyi idő után áll be)
+#define SIM_MAX_STATIONS 16           // Szimulált állomások max. száma (band scope, keresés)
+#define SIM_SEEK_CHANNEL_USEC 8000    // A seek ideje csatornánként (minden csatornán egy hangolás)
+
+// FNV-1a ellenőrzőösszeg a letöltött patch tartalmára (a tesztek a nyers patch-csel hasonlítják össze)
+#define SIM_FNV_OFFSET 2166136261u
+inline uint32_t simFnv1a(uint32_t hash, const uint8_t *data, uint32_t size) {
+    for (uint32_t i = 0; i < size; i++) {
+        hash = (hash ^ data[i]) * 16777619u;
+    }
+    return hash;
+}
+
+#define FM_CURRENT_MODE 0
+#define AM_CURRENT_MODE 1
+#define SSB_CURRENT_MODE 2
+
+class SI4735 {
+
+public:
+    //--- Inicializálás
+    int16_t getDeviceI2CAddress(uint8_t resetPin);
+    void setDeviceI2CAddress(uint8_t /*senIO*/) {}
+    void setup(uint8_t resetPin, uint8_t defaultFunction);
+    void setup(uint8_t resetPin, uint8_t ctsIntEnable, uint8_t defaultFunction, uint8_t audioMode = SI473X_ANALOG_AUDIO, uint8_t clockType = XOSCEN_CRYSTAL, uint8_t gpo2Enable = 0);
+    void reset();
+    void queryLibraryId();
+    void patchPowerUp();
+    bool downloadPatch(const uint8_t *ssb_patch_content, const uint16_t ssb_patch_content_size);
+    void setI2CStandardMode() { i2cClock = 100000; }
+    void setI2CFastMode() { i2cClock = 400000; }
+    void setI2CFastModeCustom(long value) { i2cClock = value; }
+    void waitToSend();
+    si473x_status getInterruptStatus();
+
+    //--- Mód és hangolás
+    void setFM();
+    void setFM(uint16_t fromFreq, uint16_t toFreq, uint16_t initialFreq, uint16_t step);
+    void setAM();
+    void setAM(uint16_t fromFreq, uint16_t toFreq, uint16_t initialFreq, uint16_t step);
+    void setSSB(uint16_t fromFreq, uint16_t toFreq, uint16_t initialFreq, uint16_t step, uint8_t usblsb);
+    void setSSBBfo(int offset);
+    void setSSBConfig(uint8_t AUDIOBW, uint8_t SBCUTFLT, uint8_t AVC_DIVIDER, uint8_t AVCEN, uint8_t SMUTESEL, uint8_t DSP_AFCDIS);
+    void setSSBAudioBandwidth(uint8_t AUDIOBW) { setProperty(0x0101, AUDIOBW); }
+    void setSSBSidebandCutoffFilter(uint8_t SBCUTFLT) { setProperty(0x0101, SBCUTFLT << 4); }
+    void setFrequencyStep(uint16_t step) { currentStep = step; }
+    void setTuneFrequencyAntennaCapacitor(uint16_t capacitor) { antennaCapacitor = capacitor; }
+    void setFrequency(uint16_t freq);
+    void setMaxDelaySetFrequency(uint16_t value) { maxDelaySetFrequency = value; }
+    void frequencyUp();
+    void frequencyDown();
+    uint16_t getFrequency();
+    uint16_t getCurrentFrequency() { return currentFrequency; }
+    void getStatus(uint8_t INTACK, uint8_t CANCEL);
+    uint8_t getReceivedSignalStrengthIndicator() { return statusRssi; }
+    uint8_t getStatusSNR() { return statusSnr; }
+    bool getBandLimit() { return statusBandLimit; }
+    bool getStatusValid() { return statusValid; }
+    void seekStation(uint8_t SEEKUP, uint8_t WRAP);
+
+    //--- Property-k
+    void setProperty(uint16_t propertyNumber, uint16_t param);
+    int32_t getProperty(uint16_t propertyNumber);
+    void setFMDeEmphasis(uint8_t parameter) { setProperty(0x1100, parameter); }
+    void setSeekFmSpacing(uint16_t spacing) { setProperty(0x1402, spacing); }
+    void setSeekFmLimits(uint16_t bottom, uint16_t top) {
+        setProperty(0x1400, bottom);
+        setProperty(0x1401, top);
+    }
+    void setSeekAmLimits(uint16_t bottom, uint16_t top) {
+        setProperty(0x3400, bottom);
+        setProperty(0x3401, top);
+    }
+    void setSeekAmRssiThreshold(uint16_t value) { setProperty(0x3404, value); }
+    void setSeekAmSrnThreshold(uint16_t value) { setProperty(0x3403, value); }
+    void setSeekFmRssiThreshold(uint16_t value) { setProperty(0x1404, value); }
+    void setSeekFmSrnThreshold(uint16_t value) { setProperty(0x1403, value); }
+    void setBandwidth(uint8_t AMCHFLT, uint8_t AMPLFLT) { setProperty(0x3102, AMCHFLT | (AMPLFLT << 8)); }
+    void setFmBandwidth(uint8_t filter_value) { setProperty(0x1102, filter_value); }
+    void setVolume(uint8_t volume);
+    uint8_t getVolume() { return volume; }
+    void setAudioMuteMcuPin(int8_t pin) { audioMuteMcuPin = pin; }
+    void setAudioMute(bool off);
+
+    //--- AGC
+    void getAutomaticGainControl();
+    bool isAgcEnabled() { return agcEnabled; }
+    uint8_t getAgcGainIndex() { return agcIndex; }
+    void setAutomaticGainControl(uint8_t AGCDIS, uint8_t AGCIDX);
+
+    //--- Jelminőség
+    void getCurrentReceivedSignalQuality(uint8_t INTACK = 0);
+    uint8_t getCurrentRSSI() { return rsqRssi; }
+    uint8_t getCurrentSNR() { return rsqSnr; }
+    bool getCurrentPilot() { return rsqPilot; }
+    uint8_t getCurrentMultipath() { return rsqMultipath; }
+    int8_t getCurrentSignedFrequencyOffset() { return rsqFreqOffset; }
+
+    //--- RDS
+    void RdsInit();
+    void setRdsConfig(uint8_t RDSEN, uint8_t BLETHA, uint8_t BLETHB, uint8_t BLETHC, uint8_t BLETHD);
+    void getRdsStatus(uint8_t INTACK = 0, uint8_t MTFIFO = 0, uint8_t STATUSONLY = 0);
+    uint8_t getNumRdsFifoUsed() { return rdsFifoUsed; }
+    bool getRdsReceived() { return currentRdsStatus.resp.RDSRECV; }
+    bool getRdsSync() { return currentRdsStatus.resp.RDSSYNC; }
+    bool getRdsSyncFound() { return currentRdsStatus.resp.RDSSYNCFOUND; }
+    char *getRdsText0A();
+    char *getRdsText2A();
+    bool getRdsDateTime(uint16_t *year, uint16_t *month, uint16_t *day, uint16_t *hour, uint16_t *minute);
+    uint8_t getRdsProgramType() { return rdsReceived ? simPty : 0; }
+    uint16_t getRdsPI();
+
+    //--- Szimuláció vezérlése
+    void simSetSignal(uint8_t rssi, uint8_t snr, bool pilot = false, uint8_t multipath = 0, int8_t freqOffset = 0);
+    void simSetRds(const char *stationName, const char *message, uint8_t pty, uint8_t hour, uint8_t minute);
+
+    /**
+     * Minden n. RDS csoport B blokkja javíthatatlan (BLEB = 3), 0: nincs hiba
+     */
+    void simSetRdsErrorEvery(uint8_t n) { simRdsErrorEvery = n; }
+
+    /**
+     * Szimulált állomás: ezen a frekvencián a TUNE_STATUS RSSI/SNR-je és az RDS az állomásé (máshol a simSetSignal()/simSetRds() szerinti háttér)
+     * A seek a seek küszöbök felett megáll rajta
+     */
+    void simAddStation(uint16_t freq, uint8_t rssi, uint8_t snr, uint16_t pi = 0, const char *ps = nullptr);
+    void simClearStations() { stationCount = 0; }
+    uint32_t simGetTunes() const { return tunes; }
+    uint8_t simGetMode() const { return currentMode; }
+    bool simIsMuted() const { return muted; }
+    uint32_t simGetMuteWrites() const { return muteWrites; }
+    uint32_t simGetPatchBytes() const { return patchBytes; }
+    uint32_t simGetPatchDownloads() const { return patchDownloads; }
+    uint32_t simGetPatchChecksum() const { return patchChecksum; }
+    uint32_t simGetI2CClock() const { return i2cClock; }
+
+    /**
+     * A legnagyobb hibamentes I2C órajel: felette az olvasások bithibásak, illetve a patch letöltés hibát jelez
+     */
+    void simSetMaxI2CClock(uint32_t readHz, uint32_t patchHz) {
+        simMaxI2CClock = readHz;
+        simMaxPatchI2CClock = patchHz;
+    }
+    bool simIsGpo2Enabled() const { return gpo2Enabled; }
+    uint8_t simGetRdsFifoUsed() const { return rdsFifoUsed; }
+    uint32_t simGetRdsGroupsLost() const { return rdsGroupsLost; }
+
+    /**
+     * A GPO2/INT kimenet bekötése (a szimuláció hívja, a pin a megszakítás kérésekor LOW szintre megy)
+     */
+    void simSetInterruptPin(int8_t pin) { simIntPin = pin; }
+
+    /**
+     * 1 msec-enként hívja a szimuláció: RDS csoportok érkezése a FIFO-ba
+     */
+    void simTick();
+
+protected:
+    /**
+     * Egy chip parancs I2C forgalmának könyvelése: parancs írás + CTS/válasz olvasás
+     */
+    void sendCommand(uint8_t cmdBytes, uint8_t responseBytes);
+
+    uint8_t currentMode = FM_CURRENT_MODE;
+    uint16_t currentMinimumFrequency = 6400;
+    uint16_t currentMaximumFrequency = 10800;
+    uint16_t currentFrequency = 10390;
+    uint16_t currentStep = 10;
+    uint16_t antennaCapacitor = 0;
+    uint16_t maxDelaySetFrequency = SIM_TUNE_SETTLE_USEC / 1000;
+    uint64_t tuneCompleteMicros = 0; // Ekkortól áll be az STC bit
+    uint32_t tunes = 0;
+    uint8_t volume = 30;
+    int8_t audioMuteMcuPin = -1;
+    bool muted = false;
+    uint32_t muteWrites = 0;
+    bool agcEnabled = true;
+    uint8_t agcIndex = 0;
+    uint32_t i2cClock = 100000;
+    uint32_t simMaxI2CClock = SIM_I2C_MAX_STABLE_HZ;
+    uint32_t simMaxPatchI2CClock = SIM_I2C_MAX_STABLE_HZ;
+    uint32_t patchBytes = 0;
+    uint32_t patchDownloads = 0;
+    uint32_t patchChecksum = 0;
+
+    // Megszakítás (GPO2/INT)
+    bool gpo2Enabled = false;
+    int8_t simIntPin = -1;
+    uint8_t intStatus = 0; // STCINT/RDSINT/RSQINT bitek
+    void raiseInterrupt(uint8_t bits);
+    void updateIntPin();
+    uint16_t findProperty(uint16_t propertyNumber, uint16_t defaultValue);
+    void checkRsqThresholds();
+
+    // Property tábla (csak a szimulációhoz)
+    static constexpr uint8_t SIM_MAX_PROPERTIES = 48;
+    uint16_t propertyIds[SIM_MAX_PROPERTIES];
+    uint16_t propertyValues[SIM_MAX_PROPERTIES];
+    uint8_t propertyCount = 0;
+
+    // Állomások
+    struct SimStation_t {
+        uint16_t freq;
+        uint8_t rssi, snr;
+        uint16_t pi;
+        char ps[9];
+    };
+    SimStation_t stations[SIM_MAX_STATIONS];
+    uint8_t stationCount = 0;
+    uint8_t statusRssi = 0, statusSnr = 0;
+    bool statusBandLimit = false, statusValid = false;
+    const SimStation_t *findStation(uint16_t freq) const;
+
+    // Jelminőség
+    uint8_t rsqRssi = 0, rsqSnr = 0, rsqMultipath = 0;
+    bool rsqPilot = false;
+    int8_t rsqFreqOffset = 0;
+    uint8_t simRssi = 0, simSnr = 0, simMultipath = 0;
+    bool simPilot = false;
+    int8_t simFreqOffset = 0;
+
+    // RDS
+    bool rdsReceived = false, rdsSync = false;
+    bool rdsRecvLatch = false, rdsSyncFoundLatch = false; // Az INTACK-ig megmaradó RDSRECV/RDSSYNCFOUND
+    uint8_t rdsFifoUsed = 0;
+    uint32_t rdsGroupsLost = 0;
+    uint64_t rdsNextGroupMicros = 0;
+    char rdsBuffer0A[9] = {};
+    char rdsBuffer2A[65] = {};
+    char simStationName[9] = {};
+    char simMessage[65] = {};
+    uint8_t simPty = 0, simHour = 0, simMinute = 0;
+
+    // Nyers RDS csoportok: 0A (PS), 2A (RT), 4A (CT) váltakozva
+    si47x_rds_status currentRdsStatus = {};
+    uint32_t rdsGroupSeq = 0;
+    uint8_t rdsTextSeq = 0;
+    bool simRdsAb = false; // Az RT A/B jelzője, új szövegnél vált
+    uint8_t simRdsErrorEvery = 0;
+    void simNextRdsGroup(const SimStation_t *station);
+};
+
+#endif // __SI4735_H
@@ -0,0 +1,220 @@
+#ifndef __TFT_ESPI_H
+#define __TFT_ESPI_H
+
+#include "Arduino.h"
+
+/**
+ * TFT_eSPI (ILI9488 + XPT2046 touch) host megvalósítása
+ *
+ * Nem rajzol semmit, csak az SPI forgalmat modellezi és könyveli:
+ * az ILI9488 SPI módban pixelenként 3 bájtot kap, minden rajzolási művelet előtt ablakot kell állítani (CASET/PASET/RAMWR).
+ * A sprite-ba rajzolás RAM művelet, csak a pushSprite() generál buszforgalmat.
+ */
+
+#define TFT_WIDTH 320
+#define TFT_HEIGHT 480
+
+#define SIM_TFT_BYTES_PER_PIXEL 3 // ILI9488 SPI: 18 bites szín
+#define SIM_TFT_WINDOW_BYTES 11   // CASET (1+4) + PASET (1+4) + RAMWR (1)
+
+// Színek (RGB565)
+#define TFT_BLACK 0x0000
+#define TFT_NAVY 0x000F
+#define TFT_DARKGREEN 0x03E0
+#define TFT_DARKGREY 0x7BEF
+#define TFT_BLUE 0x001F
+#define TFT_GREEN 0x07E0
+#define TFT_CYAN 0x07FF
+#define TFT_RED 0xF800
+#define TFT_YELLOW 0xFFE0
+#define TFT_WHITE 0xFFFF
+#define TFT_ORANGE 0xFDA0
+#define TFT_GOLD 0xFEA0
+#define TFT_BROWN 0x9A60
+
+// Szöveg igazítás
+#define TL_DATUM 0
+#define TC_DATUM 1
+#define TR_DATUM 2
+#define ML_DATUM 3
+#define MC_DATUM 4
+#define MR_DATUM 5
+#define BL_DATUM 6
+#define BC_DATUM 7
+#define BR_DATUM 8
+
+// Adafruit GFX font struktúrák
+typedef struct {
+    uint16_t bitmapOffset;
+    uint8_t width;
+    uint8_t height;
+    uint8_t xAdvance;
+    int8_t xOffset;
+    int8_t yOffset;
+} GFXglyph;
+
+typedef struct {
+    uint8_t *bitmap;
+    GFXglyph *glyph;
+    uint16_t first;
+    uint16_t last;
+    uint8_t yAdvance;
+} GFXfont;
+
+extern const GFXfont FreeSansBold9pt7b;
+
+class TFT_eSPI {
+public:
+    TFT_eSPI(int16_t w = TFT_WIDTH, int16_t h = TFT_HEIGHT) : _width(w), _height(h) {}
+    virtual ~TFT_eSPI() {}
+
+    void init() {}
+    void setRotation(uint8_t r) {
+        rotation = r;
+        if ((r & 1) and _width < _height) {
+            std::swap(_width, _height);
+        }
+    }
+    int16_t width() const { return _width; }
+    int16_t height() const { return _height; }
+
+    //--- Rajzolás
+    void fillScreen(uint32_t color) { fillRect(0, 0, _width, _height, color); }
+    void fillRect(int32_t /*x*/, int32_t /*y*/, int32_t w, int32_t h, uint32_t /*color*/) { pushPixels(w, h); }
+    void drawRect(int32_t /*x*/, int32_t /*y*/, int32_t w, int32_t h, uint32_t /*color*/) {
+        pushPixels(w, 1);
+        pushPixels(w, 1);
+        pushPixels(1, h);
+        pushPixels(1, h);
+    }
+    void drawFastHLine(int32_t /*x*/, int32_t /*y*/, int32_t w, uint32_t /*color*/) { pushPixels(w, 1); }
+    void drawFastVLine(int32_t /*x*/, int32_t /*y*/, int32_t h, uint32_t /*color*/) { pushPixels(1, h); }
+    void drawLine(int32_t x0, int32_t y0, int32_t x1, int32_t y1, uint32_t /*color*/) { pushPixels(1, std::max(abs(x1 - x0), abs(y1 - y0)) + 1); }
+    void drawPixel(int32_t /*x*/, int32_t /*y*/, uint32_t /*color*/) { pushPixels(1, 1); }
+    void fillRoundRect(int32_t x, int32_t y, int32_t w, int32_t h, int32_t /*r*/, uint32_t color) { fillRect(x, y, w, h, color); }
+    void drawRoundRect(int32_t x, int32_t y, int32_t w, int32_t h, int32_t /*r*/, uint32_t color) { drawRect(x, y, w, h, color); }
+
+    //--- Szöveg
+    void setTextColor(uint16_t /*fg*/) { textBgFill = false; }
+    void setTextColor(uint16_t /*fg*/, uint16_t /*bg*/, bool /*bgfill*/ = false) { textBgFill = true; }
+    void setTextDatum(uint8_t datum) { textDatum = datum; }
+    void setTextPadding(uint16_t padding) { textPadding = padding; }
+    void setTextSize(uint8_t size) { textSize = size ? size : 1; }
+    void setTextFont(uint8_t font) {
+        textFont = font;
+        freeFont = nullptr;
+    }
+    void setFreeFont(const GFXfont *font = nullptr) { freeFont = font; }
+    void setCursor(int16_t x, int16_t y) {
+        cursorX = x;
+        cursorY = y;
+    }
+
+    int16_t textWidth(const char *str) { return strlen(str) * charWidth(); }
+    int16_t textWidth(const String &str) { return textWidth(str.c_str()); }
+    int16_t textWidth(const __FlashStringHelper *str) { return textWidth(reinterpret_cast<const char *>(str)); }
+    int16_t fontHeight() { return freeFont ? freeFont->yAdvance * textSize : (textFont == 2 ? 16 : 8) * textSize; }
+
+    int16_t drawString(const char *str, int32_t /*x*/, int32_t /*y*/) {
+        drawText(str);
+        return textWidth(str);
+    }
+    int16_t drawString(const String &str, int32_t x, int32_t y) { return drawString(str.c_str(), x, y); }
+
+    size_t print(const char *str) {
+        drawText(str);
+        return strlen(str);
+    }
+    size_t print(const String &str) { return print(str.c_str()); }
+    size_t print(const __FlashStringHelper *str) { return print(reinterpret_cast<const char *>(str)); }
+    size_t print(int value, int base = DEC) { return print(String(value, (unsigned char)base)); }
+    size_t println(const char *str = "") { return print(str); }
+    size_t println(const __FlashStringHelper *str) { return print(str); }
+    size_t println(int value, int base = DEC) { return print(value, base); }
+
+    //--- Touch (a szimuláció állítja be)
+    bool getTouch(uint16_t *x, uint16_t *y, uint16_t /*threshold*/ = 600) {
+        // XPT2046: Z1, Z2, X, Y mintavételek, mindegyik 3 bájtos SPI tranzakció
+        for (uint8_t i = 0; i < 4; i++) {
+            busStatsSPI(3);
+        }
+        if (!simTouched) {
+            return false;
+        }
+        *x = simTouchX;
+        *y = simTouchY;
+        return true;
+    }
+    void setTouch(uint16_t * /*data*/) {}
+    void calibrateTouch(uint16_t * /*data*/, uint32_t /*colorFG*/, uint32_t /*colorBG*/, uint8_t /*size*/) {}
+
+    void simSetTouch(bool touched, uint16_t x = 0, uint16_t y = 0) {
+        simTouched = touched;
+        simTouchX = x;
+        simTouchY = y;
+    }
+
+protected:
+    int16_t _width, _height;
+    uint8_t rotation = 0;
+    bool isSprite = false;
+
+    bool textBgFill = false;
+    uint8_t textDatum = TL_DATUM;
+    uint16_t textPadding = 0;
+    uint8_t textSize = 1;
+    uint8_t textFont = 1;
+    const GFXfont *freeFont = nullptr;
+    int16_t cursorX = 0, cursorY = 0;
+
+    bool simTouched = false;
+    uint16_t simTouchX = 0, simTouchY = 0;
+
+    int16_t charWidth() const { return freeFont ? 26 * textSize : (textFont == 2 ? 8 : 6) * textSize; }
+
+    /**
+     * Szöveg kirajzolása: háttérszínnel egy tömör téglalap, anélkül csak a betűk pixelei (kb. harmada)
+     */
+    void drawText(const char *str) {
+        int32_t w = strlen(str) * charWidth();
+        int32_t h = fontHeight();
+        if (textBgFill) {
+            pushPixels(w, h);
+        } else {
+            pushPixels(w, h / 3);
+        }
+    }
+
+    /**
+     * Egy ablaknyi pixel kiküldésének könyvelése
+     */
+    void pushPixels(int32_t w, int32_t h) {
+        if (isSprite or w <= 0 or h <= 0) {
+            return;
+        }
+        busStatsSPI(SIM_TFT_WINDOW_BYTES + (uint32_t)w * h * SIM_TFT_BYTES_PER_PIXEL);
+    }
+};
+
+/**
+ * Sprite: RAM puffer, csak a pushSprite() megy ki a buszra
+ */
+class TFT_eSprite : public TFT_eSPI {
+public:
+    TFT_eSprite(TFT_eSPI *tft) : TFT_eSPI(0, 0), parent(tft) { isSprite = true; }
+
+    void *createSprite(int16_t w, int16_t h, uint8_t /*frames*/ = 1) {
+        _width = w;
+        _height = h;
+        return this;
+    }
+    void deleteSprite() { _width = _height = 0; }
+    void pushSprite(int32_t /*x*/, int32_t /*y*/) {
+        busStatsSPI(SIM_TFT_WINDOW_BYTES + (uint32_t)_width * _height * SIM_TFT_BYTES_PER_PIXEL);
+    }
+
+private:
+    TFT_eSPI *parent;
+};
+
+#endif // __TFT_ESPI_H
@@ -0,0 +1,35 @@
+#ifndef __TICKER_H
+#define __TICKER_H
+
+#include "Arduino.h"
+
+/**
+ * Ticker host megvalósítása: a callback-et a szimuláció a simTick()-kel futtathatja
+ */
+class Ticker {
+public:
+    typedef std::function<void(void)> callback_function_t;
+
+    void attach(float seconds, callback_function_t callback) { attach_ms((uint32_t)(seconds * 1000), callback); }
+    void attach_ms(uint32_t msec, callback_function_t callback) {
+        periodMsec = msec;
+        cb = callback;
+    }
+    void detach() { cb = nullptr; }
+    bool active() const { return (bool)cb; }
+
+    /**
+     * A szimuláció hívja: lefuttatja a callback-et, ha van
+     */
+    void simTick() {
+        if (cb) {
+            cb();
+        }
+    }
+
+private:
+    uint32_t periodMsec = 0;
+    callback_function_t cb;
+};
+
+#endif // __TICKER_H
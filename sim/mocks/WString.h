@@ -0,0 +1,81 @@
+#ifndef __WSTRING_H
+#define __WSTRING_H
+
+#include <stdio.h>
+#include <string>
+
+class __FlashStringHelper;
+
+/**
+ * Az Arduino String osztály minimális host megvalósítása
+ */
+class String {
+
+private:
+    std::string s;
+
+public:
+    String() {}
+    String(const char *cstr) : s(cstr ? cstr : "") {}
+    String(const __FlashStringHelper *str) : s(reinterpret_cast<const char *>(str)) {}
+    String(const std::string &str) : s(str) {}
+    String(char c) : s(1, c) {}
+    String(int value, unsigned char base = 10) { s = base == 16 ? format("%x", value) : std::to_string(value); }
+    String(unsigned int value, unsigned char base = 10) { s = base == 16 ? format("%x", value) : std::to_string(value); }
+    String(long value, unsigned char /*base*/ = 10) { s = std::to_string(value); }
+    String(unsigned long value, unsigned char /*base*/ = 10) { s = std::to_string(value); }
+    String(float value, unsigned char decimalPlaces = 2) { s = formatFloat(value, decimalPlaces); }
+    String(double value, unsigned char decimalPlaces = 2) { s = formatFloat(value, decimalPlaces); }
+
+    unsigned int length() const { return s.length(); }
+    const char *c_str() const { return s.c_str(); }
+    char charAt(unsigned int index) const { return index < s.length() ? s[index] : 0; }
+    char operator[](unsigned int index) const { return charAt(index); }
+
+    void remove(unsigned int index) {
+        if (index < s.length()) {
+            s.erase(index);
+        }
+    }
+    void remove(unsigned int index, unsigned int count) {
+        if (index < s.length()) {
+            s.erase(index, count);
+        }
+    }
+
+    String &operator+=(const String &rhs) {
+        s += rhs.s;
+        return *this;
+    }
+    String &operator+=(const char *rhs) {
+        s += rhs;
+        return *this;
+    }
+    String &operator+=(char c) {
+        s += c;
+        return *this;
+    }
+
+    bool operator==(const String &rhs) const { return s == rhs.s; }
+    bool operator==(const char *rhs) const { return s == rhs; }
+    bool operator!=(const String &rhs) const { return s != rhs.s; }
+
+    friend String operator+(const String &lhs, const String &rhs) { return String(lhs.s + rhs.s); }
+    friend String operator+(const String &lhs, const char *rhs) { return String(lhs.s + rhs); }
+    friend String operator+(const char *lhs, const String &rhs) { return String(std::string(lhs) + rhs.s); }
+
+private:
+    static std::string format(const char *fmt, int value) {
+        char buf[16];
+        snprintf(buf, sizeof(buf), fmt, value);
+        return buf;
+    }
+
+    static std::string formatFloat(double value, unsigned char decimalPlaces) {
+        char buf[32];
+        snprintf(buf, sizeof(buf), "%.*f", decimalPlaces, value);
+        return buf;
+    }
+};
+
+#endif // __WSTRING_H
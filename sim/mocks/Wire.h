@@ -0,0 +1,52 @@
+#ifndef __WIRE_H
+#define __WIRE_H
+
+#include "Arduino.h"
+
+/**
+ * TwoWire host megvalósítása: csak a forgalmat könyveli, a válasz mindig 0x80 (CTS)
+ */
+class TwoWire {
+public:
+    void setSDA(uint8_t /*pin*/) {}
+    void setSCL(uint8_t /*pin*/) {}
+    void begin() {}
+    void setClock(uint32_t freq) { clock = freq; }
+    uint32_t getClock() const { return clock; }
+
+    void beginTransmission(uint8_t /*address*/) { txBytes = 0; }
+    size_t write(uint8_t /*data*/) {
+        txBytes++;
+        return 1;
+    }
+    size_t write(const uint8_t * /*data*/, size_t quantity) {
+        txBytes += quantity;
+        return quantity;
+    }
+    uint8_t endTransmission(bool /*sendStop*/ = true) {
+        busStatsI2C(txBytes);
+        return 0;
+    }
+    uint8_t requestFrom(uint8_t /*address*/, size_t quantity, bool /*sendStop*/ = true) {
+        busStatsI2C(quantity);
+        rxAvailable = quantity;
+        return quantity;
+    }
+    int available() { return rxAvailable; }
+    int read() {
+        if (rxAvailable == 0) {
+            return -1;
+        }
+        rxAvailable--;
+        return 0x80;
+    }
+
+private:
+    uint32_t clock = 100000;
+    size_t txBytes = 0;
+    size_t rxAvailable = 0;
+};
+
+extern TwoWire Wire;
+
+#endif // __WIRE_H
@@ -0,0 +1,19 @@
+#ifndef __SIM_HARDWARE_WATCHDOG_H
+#define __SIM_HARDWARE_WATCHDOG_H
+
+#include <stdint.h>
+
+// A pico-sdk watchdog regiszterei közül csak a scratch tömb kell (a reset a szimulációban nem törli)
+typedef struct {
+    uint32_t scratch[8];
+} watchdog_hw_t;
+
+extern watchdog_hw_t *watchdog_hw;
+
+// A szimulált "újraindulás" watchdog miatt történt? (a tesztek állítják)
+extern bool simWatchdogRebooted;
+
+inline bool watchdog_caused_reboot() { return simWatchdogRebooted; }
+inline bool watchdog_enable_caused_reboot() { return simWatchdogRebooted; }
+
+#endif // __SIM_HARDWARE_WATCHDOG_H
@@ -0,0 +1,26 @@
+#ifndef __PATCH_FULL_H
+#define __PATCH_FULL_H
+
+#include <stdint.h>
+
+/**
+ * SSB patch helyettesítő a host buildhez
+ * A valódi patch a PU2CLR könyvtárban van (~16 KB), itt csak egy 8 bájtos sorokból álló, determinisztikus tartalom van.
+ * A méret közel azonos a valódival, így a letöltés forgalma és ideje reális.
+ */
+#define SIM_SSB_PATCH_LINES 1980
+
+struct SimPatchContent {
+    uint8_t bytes[SIM_SSB_PATCH_LINES * 8];
+    constexpr SimPatchContent() : bytes() {
+        for (uint32_t i = 0; i < SIM_SSB_PATCH_LINES * 8; i++) {
+            // Az első bájt minden sorban a patch parancs (0x15 vagy 0x16), a többi ismétlődő minta
+            bytes[i] = (i % 8 == 0) ? (i < 8 ? 0x15 : 0x16) : (uint8_t)((i * 7 + (i / 64)) & 0x3F);
+        }
+    }
+};
+
+static constexpr SimPatchContent SIM_PATCH_CONTENT{};
+#define ssb_patch_content SIM_PATCH_CONTENT.bytes
+
+#endif // __PATCH_FULL_H
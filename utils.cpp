@@ -59,3 +59,32 @@ void tftTouchCalibrate(TFT_eSPI *pTft, uint16_t (&calData)[5]) {
     DEBUG(" };\n");
     DEBUG("  pTft->setTouch(calData);\n");
 }
+
+/**
+ * Beírt frekvencia átváltása kHz-re
+ */
+uint32_t parseFrequencyKHz(const char *text) {
+
+    uint32_t kHz = 0;
+    int8_t decimals = -1; // A tizedespont utáni jegyek (-1: nincs tizedespont)
+    for (const char *p = text; *p; p++) {
+        if (*p == '.' and decimals < 0) {
+            decimals = 0;
+        } else if (*p >= '0' and *p <= '9' and kHz < 1000000 and decimals < 3) {
+            kHz = kHz * 10 + (*p - '0');
+            if (decimals >= 0) {
+                decimals++;
+            }
+        } else {
+            return 0;
+        }
+    }
+
+    // MHz: a hiányzó tizedes jegyekkel kHz-re egészítjük ki
+    if (decimals >= 0) {
+        for (; decimals < 3; decimals++) {
+            kHz *= 10;
+        }
+    }
+    return kHz;
+}
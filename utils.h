@@ -10,7 +10,7 @@
 //--- TFT colors ---
 
 #define TFT_COLOR(r, g, b) (((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3))
-// #define COMPLEMENT_COLOR(color) \
+// #define COMPLEMENT_COLOR(color)
 //     (TFT_COLOR((255 - ((color >> 16) & 0xFF)), (255 - ((color >> 8) & 0xFF)), (255 - (color & 0xFF))))
 // #define PUSHED_COLOR(color) ((((color & 0xF800) >> 1) & 0xF800) | (((color & 0x07E0) >> 1) & 0x07E0) | (((color & 0x001F) >> 1) & 0x001F))
 
@@ -58,6 +58,13 @@ bool isZeroArray(T (&arr)[N]) {
     return true; // Ha minden elem nulla, akkor true-t adunk vissza
 }
 
+/**
+ * Beírt frekvencia átváltása kHz-re
+ * @param text kHz egész számként (pl.: "7074"), vagy MHz tizedesponttal (pl.: "93.9")
+ * @return a frekvencia kHz-ben, 0, ha hibás
+ */
+uint32_t parseFrequencyKHz(const char *text);
+
 //--- TFT ---
 void tftTouchCalibrate(TFT_eSPI *pTft, uint16_t (&calData)[5]);
 